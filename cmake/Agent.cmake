@@ -137,6 +137,7 @@ add_library(core
   fboss/agent/ResolvedNexthopMonitor.cpp
   fboss/agent/ResolvedNexthopProbe.cpp
   fboss/agent/ResolvedNexthopProbeScheduler.cpp
+  fboss/agent/ResourceAccountant.cpp
   fboss/agent/RestartTimeTracker.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
@@ -249,6 +250,15 @@ target_link_libraries(platform_base
   platform_mapping
 )
 
+add_executable(agent_config_converter
+  fboss/util/agent_config_converter.cpp
+)
+
+target_link_libraries(agent_config_converter
+  platform_base
+  Folly::folly
+)
+
 add_library(hw_switch
   fboss/agent/HwSwitch.cpp
 )
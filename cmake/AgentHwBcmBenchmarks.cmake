@@ -218,6 +218,15 @@ target_link_libraries(bcm_stats_collection_speed
   -Wl,--no-whole-archive
 )
 
+add_executable(bcm_apply_prod_config_speed /dev/null)
+
+target_link_libraries(bcm_apply_prod_config_speed
+  -Wl,--whole-archive
+  bcm_switch_ensemble
+  hw_apply_prod_config_speed
+  -Wl,--no-whole-archive
+)
+
 add_executable(bcm_tx_slow_path_rate /dev/null)
 
 target_link_libraries(bcm_tx_slow_path_rate
@@ -338,6 +347,35 @@ target_link_libraries(bcm_rib_sync_fib_speed
   Folly::follybenchmark
 )
 
+add_executable(bcm_warm_boot_cache_populate_speed
+  fboss/agent/hw/bcm/tests/BcmWarmBootCachePopulateBenchmark.cpp
+)
+
+target_link_libraries(bcm_warm_boot_cache_populate_speed
+  bcm
+  ${OPENNSA}
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(bcm_warm_boot_cache_hw_populate_speed
+  fboss/agent/hw/bcm/tests/BcmWarmBootCacheHwPopulateBenchmark.cpp
+)
+
+target_link_libraries(bcm_warm_boot_cache_hw_populate_speed
+  -Wl,--whole-archive
+  bcm
+  config
+  bcm_switch_ensemble
+  config_factory
+  route_scale_gen
+  -Wl,--no-whole-archive
+  hw_benchmark_main
+  Folly::folly
+  ${OPENNSA}
+  Folly::follybenchmark
+)
+
 if (BENCHMARK_INSTALL)
   install(TARGETS bcm_ecmp_shrink_speed)
   install(TARGETS bcm_ecmp_shrink_with_competing_route_updates_speed)
@@ -360,4 +398,6 @@ if (BENCHMARK_INSTALL)
   install(TARGETS bcm_init_and_exit_100Gx100G)
   install(TARGETS bcm_rib_resolution_speed)
   install(TARGETS bcm_rib_sync_fib_speed)
+  install(TARGETS bcm_warm_boot_cache_populate_speed)
+  install(TARGETS bcm_warm_boot_cache_hw_populate_speed)
 endif()
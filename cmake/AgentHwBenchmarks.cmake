@@ -152,6 +152,16 @@ target_link_libraries(hw_rib_resolution_speed
   Folly::folly
 )
 
+add_library(hw_apply_prod_config_speed
+  fboss/agent/hw/benchmarks/HwApplyProdConfigBenchmark.cpp
+)
+
+target_link_libraries(hw_apply_prod_config_speed
+  prod_config_factory
+  hw_benchmark_main
+  Folly::folly
+)
+
 add_library(hw_rib_sync_fib_speed
   fboss/agent/hw/benchmarks/HwRibSyncFibBenchmark.cpp
 )
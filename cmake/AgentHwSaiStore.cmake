@@ -13,6 +13,7 @@ target_link_libraries(sai_store
   sai_api
   ref_map
   tuple_utils
+  Folly::folly
 )
 
 set_target_properties(sai_store PROPERTIES COMPILE_FLAGS
@@ -19,6 +19,7 @@ add_executable(switch_test
     fboss/agent/hw/sai/switch/tests/QosMapManagerTest.cpp
     fboss/agent/hw/sai/switch/tests/RouteManagerTest.cpp
     fboss/agent/hw/sai/switch/tests/RouterInterfaceManagerTest.cpp
+    fboss/agent/hw/sai/switch/tests/RxBufferPoolTest.cpp
     fboss/agent/hw/sai/switch/tests/SamplePacketManagerTest.cpp
     fboss/agent/hw/sai/switch/tests/SchedulerManagerTest.cpp
     fboss/agent/hw/sai/switch/tests/SwitchManagerTest.cpp
@@ -65,3 +66,24 @@ set_target_properties(switch_test PROPERTIES COMPILE_FLAGS
 )
 
 gtest_discover_tests(switch_test)
+
+add_executable(sai_ecmp_shrink_speed
+    fboss/agent/hw/sai/switch/tests/SaiEcmpShrinkSpeedBenchmark.cpp
+)
+
+target_link_libraries(sai_ecmp_shrink_speed
+    sai_store
+    sai_switch
+    fake_sai
+    manager_test_base
+    function_call_time_reporter
+    Folly::folly
+    Folly::follybenchmark
+    ${GTEST}
+)
+
+set_target_properties(sai_ecmp_shrink_speed PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
@@ -33,3 +33,17 @@ add_library(phy_utils
 target_link_libraries(phy_utils
   phy_cpp2
 )
+
+add_executable(phy_manager_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/lib/phy/tests/PhyManagerTest.cpp
+)
+
+target_link_libraries(phy_manager_test
+  phy_management_base
+  fake_test_platform_mapping
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(phy_manager_test)
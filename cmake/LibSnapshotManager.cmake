@@ -5,6 +5,7 @@
 
 add_library(snapshot_manager
   fboss/lib/link_snapshots/SnapshotManager.cpp
+  fboss/lib/link_snapshots/SnapshotRecorder.cpp
 )
 
 target_link_libraries(snapshot_manager
@@ -12,4 +13,29 @@ target_link_libraries(snapshot_manager
   fboss_cpp2
   phy_cpp2
   alert_logger
+  error
+  Folly::folly
 )
+
+add_executable(link_snapshot_recorder_dump
+  fboss/lib/link_snapshots/SnapshotRecorderDump.cpp
+)
+
+target_link_libraries(link_snapshot_recorder_dump
+  snapshot_manager
+  Folly::folly
+)
+
+add_executable(snapshot_recorder_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/lib/link_snapshots/tests/SnapshotRecorderTest.cpp
+)
+
+target_link_libraries(snapshot_recorder_test
+  snapshot_manager
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(snapshot_recorder_test)
@@ -13,6 +13,7 @@ add_library(rackmon_lib
   fboss/platform/rackmon/Modbus.cpp
   fboss/platform/rackmon/ModbusCmds.cpp
   fboss/platform/rackmon/ModbusDevice.cpp
+  fboss/platform/rackmon/Crc16.cpp
   fboss/platform/rackmon/Msg.cpp
   fboss/platform/rackmon/Rackmon.cpp
   fboss/platform/rackmon/Register.cpp
@@ -69,3 +70,17 @@ target_include_directories(rackmon_test PRIVATE
 )
 
 target_compile_definitions(rackmon_test PRIVATE __TEST__=1)
+
+add_executable(rackmon_crc16_benchmark
+  fboss/platform/rackmon/tests/Crc16Benchmark.cpp
+)
+
+target_link_libraries(rackmon_crc16_benchmark
+  rackmon_lib
+  Folly::folly
+  Folly::follybenchmark
+)
+
+target_include_directories(rackmon_crc16_benchmark PRIVATE
+  fboss/platform/rackmon
+)
@@ -7,6 +7,7 @@ add_library(sensor_service_lib
   fboss/platform/sensor_service/GetSensorConfig.cpp
   fboss/platform/sensor_service/MockSensorConfig.cpp
   fboss/platform/sensor_service/SensorServiceImpl.cpp
+  fboss/platform/sensor_service/SysfsSensorSampler.cpp
   fboss/platform/sensor_service/DarwinSensorConfig.cpp
   fboss/platform/sensor_service/SensorServiceThriftHandler.cpp
   fboss/platform/sensor_service/SetupThrift.cpp
@@ -32,3 +33,16 @@ target_link_libraries(sensor_service
   sensor_service_lib
   fb303::fb303
 )
+
+add_executable(sensor_service_test
+  fboss/platform/sensor_service/tests/SysfsSensorSamplerTest.cpp
+)
+
+target_link_libraries(sensor_service_test
+  sensor_service_lib
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(sensor_service_test)
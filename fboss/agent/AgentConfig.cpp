@@ -12,21 +12,58 @@
 #include "fboss/agent/FbossError.h"
 
 #include <folly/FileUtil.h>
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/system/MemoryMapping.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
+#include <sys/stat.h>
 #include <iostream>
+#include <optional>
+#include <tuple>
 
 DEFINE_string(
     config,
     "/etc/coop/agent.conf",
     "The path to the local JSON configuration file");
+DEFINE_bool(
+    prefer_binary_config,
+    false,
+    "Load <config>.bin, the binary form of --config written by "
+    "agent_config_converter, instead of --config when it is not older");
 
 // NOTE: we use std::cerr because logging libs are likely not
 // initialized yet...
 
 namespace facebook::fboss {
 
+namespace {
+// Prefix of binary configs, followed by the compact serialized AgentConfig
+constexpr folly::StringPiece kBinaryConfigMagic{"FBOSSAGENTCFG\x01\n"};
+
+std::optional<struct timespec> modifiedTime(const std::string& path) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return std::nullopt;
+  }
+  return st.st_mtim;
+}
+} // namespace
+
 std::unique_ptr<AgentConfig> AgentConfig::fromDefaultFile() {
+  if (FLAGS_prefer_binary_config) {
+    auto binaryPath = FLAGS_config + ".bin";
+    auto binaryTime = modifiedTime(binaryPath);
+    auto jsonTime = modifiedTime(FLAGS_config);
+    // A binary config older than the JSON one is stale
+    if (binaryTime &&
+        (!jsonTime ||
+         std::tie(binaryTime->tv_sec, binaryTime->tv_nsec) >=
+             std::tie(jsonTime->tv_sec, jsonTime->tv_nsec))) {
+      return fromBinaryFile(binaryPath);
+    }
+    std::cerr << "No up to date binary config " << binaryPath
+              << ", loading " << FLAGS_config << std::endl;
+  }
   return fromFile(FLAGS_config);
 }
 
@@ -35,6 +72,9 @@ std::unique_ptr<AgentConfig> AgentConfig::fromFile(folly::StringPiece path) {
   if (!folly::readFile(path.data(), configStr)) {
     throw FbossError("unable to read ", path);
   }
+  if (isBinaryConfig(folly::StringPiece(configStr))) {
+    return fromBinaryConfig(folly::StringPiece(configStr));
+  }
   return fromRawConfig(std::move(configStr));
 }
 
@@ -61,6 +101,36 @@ std::unique_ptr<AgentConfig> AgentConfig::fromRawConfig(
   return std::make_unique<AgentConfig>(std::move(agentConfig), configStr);
 }
 
+std::unique_ptr<AgentConfig> AgentConfig::fromBinaryFile(
+    folly::StringPiece path) {
+  std::unique_ptr<folly::MemoryMapping> mapping;
+  try {
+    mapping = std::make_unique<folly::MemoryMapping>(path.str().c_str());
+  } catch (const std::exception& ex) {
+    throw FbossError("unable to map ", path, ": ", ex.what());
+  }
+  return fromBinaryConfig(mapping->range());
+}
+
+std::unique_ptr<AgentConfig> AgentConfig::fromBinaryConfig(
+    folly::ByteRange contents) {
+  if (!isBinaryConfig(contents)) {
+    throw FbossError("not a binary agent config");
+  }
+  contents.advance(kBinaryConfigMagic.size());
+  cfg::AgentConfig agentConfig;
+  try {
+    apache::thrift::CompactSerializer::deserialize(contents, agentConfig);
+  } catch (const std::exception& ex) {
+    throw FbossError("unable to deserialize binary agent config: ", ex.what());
+  }
+  return std::make_unique<AgentConfig>(std::move(agentConfig), "");
+}
+
+bool AgentConfig::isBinaryConfig(folly::ByteRange contents) {
+  return contents.startsWith(folly::ByteRange(kBinaryConfigMagic));
+}
+
 std::string AgentConfig::swConfigRaw() const {
   return apache::thrift::SimpleJSONSerializer::serialize<std::string>(
       *thrift.sw());
@@ -70,8 +140,13 @@ std::string AgentConfig::agentConfigRaw() const {
   return apache::thrift::SimpleJSONSerializer::serialize<std::string>(thrift);
 }
 
+std::string AgentConfig::binaryConfigRaw() const {
+  return kBinaryConfigMagic.str() +
+      apache::thrift::CompactSerializer::serialize<std::string>(thrift);
+}
+
 void AgentConfig::dumpConfig(folly::StringPiece path) const {
-  folly::writeFile(raw, path.data());
+  folly::writeFile(raw.empty() ? agentConfigRaw() : raw, path.data());
 }
 
 std::unique_ptr<facebook::fboss::AgentConfig> createEmptyAgentConfig() {
@@ -80,4 +155,22 @@ std::unique_ptr<facebook::fboss::AgentConfig> createEmptyAgentConfig() {
       agentCfg,
       apache::thrift::SimpleJSONSerializer::serialize<std::string>(agentCfg));
 }
+
+namespace {
+template <typename ConfigT>
+uint64_t configHash(const ConfigT& config) {
+  auto serialized =
+      apache::thrift::CompactSerializer::serialize<std::string>(config);
+  return folly::hash::SpookyHashV2::Hash64(
+      serialized.data(), serialized.size(), 0);
+}
+} // namespace
+
+uint64_t switchConfigHash(const cfg::SwitchConfig& config) {
+  return configHash(config);
+}
+
+uint64_t agentConfigHash(const cfg::AgentConfig& config) {
+  return configHash(config);
+}
 } // namespace facebook::fboss
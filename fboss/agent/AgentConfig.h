@@ -12,6 +12,8 @@
 #include "fboss/agent/gen-cpp2/agent_config_types.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 
+#include <folly/Range.h>
+
 #include <memory>
 
 namespace facebook::fboss {
@@ -25,18 +27,32 @@ struct AgentConfig {
   static std::unique_ptr<AgentConfig> fromFile(folly::StringPiece path);
   static std::unique_ptr<AgentConfig> fromRawConfig(
       const std::string& contents);
+  // Load a compact serialized config, as written by binaryConfigRaw(). The
+  // file is mmap'd and deserialized in place, skipping JSON parsing.
+  static std::unique_ptr<AgentConfig> fromBinaryFile(folly::StringPiece path);
+  static std::unique_ptr<AgentConfig> fromBinaryConfig(
+      folly::ByteRange contents);
+  static bool isBinaryConfig(folly::ByteRange contents);
 
   // serialize just the sw component
   std::string swConfigRaw() const;
   // serialize entire agent config
   std::string agentConfigRaw() const;
+  // serialize entire agent config in the binary format
+  std::string binaryConfigRaw() const;
 
   void dumpConfig(folly::StringPiece path) const;
 
   const cfg::AgentConfig thrift;
+  // JSON the config was loaded from, empty for binary configs
   const std::string raw;
 };
 
 std::unique_ptr<facebook::fboss::AgentConfig> createEmptyAgentConfig();
 
+// Hash of the content of a switch config, used to detect config changes
+// without comparing serialized configs.
+uint64_t switchConfigHash(const cfg::SwitchConfig& config);
+uint64_t agentConfigHash(const cfg::AgentConfig& config);
+
 } // namespace facebook::fboss
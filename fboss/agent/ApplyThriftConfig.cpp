@@ -10,8 +10,10 @@
 #include "fboss/agent/ApplyThriftConfig.h"
 
 #include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/gen/Base.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
@@ -127,15 +129,22 @@ class ThriftConfigApplier {
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RoutingInformationBase* rib)
-      : orig_(orig), cfg_(config), platform_(platform), rib_(rib) {}
+      RoutingInformationBase* rib,
+      const cfg::SwitchConfig* prevConfig)
+      : orig_(orig),
+        cfg_(config),
+        prevCfg_(prevConfig),
+        platform_(platform),
+        rib_(rib) {}
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RouteUpdateWrapper* routeUpdater)
+      RouteUpdateWrapper* routeUpdater,
+      const cfg::SwitchConfig* prevConfig)
       : orig_(orig),
         cfg_(config),
+        prevCfg_(prevConfig),
         platform_(platform),
         routeUpdater_(routeUpdater) {}
 
@@ -356,9 +365,47 @@ class ThriftConfigApplier {
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCPU);
 
+  /*
+   * Sections of the config are applied one at a time, with the time each
+   * takes logged once the whole config is applied.
+   *
+   * Sections whose state is only ever built from the config can be skipped
+   * altogether if their config did not change since prevCfg_, the config
+   * orig_ was built from.
+   */
+  template <typename UpdateFn>
+  void updateSection(const char* section, UpdateFn&& update) {
+    auto begin = std::chrono::steady_clock::now();
+    update();
+    sectionTimes_.push_back(folly::to<std::string>(
+        section,
+        "=",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin)
+            .count(),
+        "ms"));
+  }
+  template <typename UpdateFn>
+  void updateSectionIfChanged(
+      const char* section,
+      bool configChanged,
+      UpdateFn&& update) {
+    if (configChanged) {
+      updateSection(section, std::forward<UpdateFn>(update));
+    } else {
+      sectionTimes_.push_back(folly::to<std::string>(section, "=skipped"));
+    }
+  }
+  bool aclConfigChanged() const;
+  bool qosPolicyConfigChanged() const;
+  bool bufferPoolConfigChanged() const;
+  bool sflowCollectorConfigChanged() const;
+  bool loadBalancerConfigChanged() const;
+
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
+  const cfg::SwitchConfig* prevCfg_{nullptr};
   const Platform* platform_{nullptr};
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
@@ -380,75 +427,110 @@ class ThriftConfigApplier {
   flat_map<PortID, Port::VlanMembership> portVlans_;
   flat_map<VlanID, Vlan::MemberPorts> vlanPorts_;
   flat_map<VlanID, VlanInterfaceInfo> vlanInterfaces_;
+  std::vector<std::string> sectionTimes_;
 };
 
+bool ThriftConfigApplier::aclConfigChanged() const {
+  // ACL actions refer to traffic counters and mirrors
+  return !prevCfg_ || *prevCfg_->acls() != *cfg_->acls() ||
+      prevCfg_->aclTableGroup().to_optional() !=
+      cfg_->aclTableGroup().to_optional() ||
+      prevCfg_->cpuTrafficPolicy().to_optional() !=
+      cfg_->cpuTrafficPolicy().to_optional() ||
+      prevCfg_->dataPlaneTrafficPolicy().to_optional() !=
+      cfg_->dataPlaneTrafficPolicy().to_optional() ||
+      *prevCfg_->trafficCounters() != *cfg_->trafficCounters() ||
+      *prevCfg_->mirrors() != *cfg_->mirrors();
+}
+
+bool ThriftConfigApplier::qosPolicyConfigChanged() const {
+  // The data plane traffic policy names the default qos policy
+  return !prevCfg_ || *prevCfg_->qosPolicies() != *cfg_->qosPolicies() ||
+      prevCfg_->dataPlaneTrafficPolicy().to_optional() !=
+      cfg_->dataPlaneTrafficPolicy().to_optional();
+}
+
+bool ThriftConfigApplier::bufferPoolConfigChanged() const {
+  return !prevCfg_ ||
+      prevCfg_->bufferPoolConfigs().to_optional() !=
+      cfg_->bufferPoolConfigs().to_optional();
+}
+
+bool ThriftConfigApplier::sflowCollectorConfigChanged() const {
+  return !prevCfg_ || *prevCfg_->sFlowCollectors() != *cfg_->sFlowCollectors();
+}
+
+bool ThriftConfigApplier::loadBalancerConfigChanged() const {
+  return !prevCfg_ || *prevCfg_->loadBalancers() != *cfg_->loadBalancers();
+}
+
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
 
-  {
+  updateSection("switchSettings", [&]() {
     auto newSwitchSettings = updateSwitchSettings();
     if (newSwitchSettings) {
       new_->resetSwitchSettings(std::move(newSwitchSettings));
       changed = true;
     }
-  }
+  });
 
-  {
+  updateSection("qcm", [&]() {
     bool qcmChanged = false;
     auto newQcmConfig = updateQcmCfg(&qcmChanged);
     if (qcmChanged) {
       new_->resetQcmCfg(newQcmConfig);
       changed = true;
     }
-  }
+  });
 
-  {
+  updateSection("controlPlane", [&]() {
     auto newControlPlane = updateControlPlane();
     if (newControlPlane) {
       new_->resetControlPlane(std::move(newControlPlane));
       changed = true;
     }
-  }
+  });
 
-  processVlanPorts();
+  updateSection("vlanPorts", [&]() { processVlanPorts(); });
 
-  {
+  updateSectionIfChanged("bufferPools", bufferPoolConfigChanged(), [&]() {
     bool bufferPoolConfigChanged = false;
     auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
     if (bufferPoolConfigChanged) {
       new_->resetBufferPoolCfgs(newBufferPoolCfg);
       changed = true;
     }
-  }
+  });
 
-  {
+  updateSection("ports", [&]() {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(std::move(newPorts));
       changed = true;
     }
-  }
+  });
 
-  {
+  updateSection("aggregatePorts", [&]() {
     auto newAggPorts = updateAggregatePorts();
     if (newAggPorts) {
       new_->resetAggregatePorts(std::move(newAggPorts));
       changed = true;
     }
-  }
+  });
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
+  updateSection("mirrors", [&]() {
     auto newMirrors = updateMirrors();
     if (newMirrors) {
       new_->resetMirrors(std::move(newMirrors));
       changed = true;
     }
-  }
+  });
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  updateSectionIfChanged("acls", aclConfigChanged(), [&]() {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
@@ -462,15 +544,15 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
         changed = true;
       }
     }
-  }
+  });
 
-  {
+  updateSectionIfChanged("qosPolicies", qosPolicyConfigChanged(), [&]() {
     auto newQosPolicies = updateQosPolicies();
     if (newQosPolicies) {
       new_->resetQosPolicies(std::move(newQosPolicies));
       changed = true;
     }
-  }
+  });
 
   // reset the default qos policy
   {
@@ -481,68 +563,72 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  updateSection("interfaces", [&]() {
     auto newIntfs = updateInterfaces();
     if (newIntfs) {
       new_->resetIntfs(std::move(newIntfs));
       changed = true;
     }
-  }
+  });
 
   // Note: updateInterfaces() must be called before updateVlans(),
   // as updateInterfaces() populates the vlanInterfaces_ data structure.
-  {
+  updateSection("vlans", [&]() {
     auto newVlans = updateVlans();
     if (newVlans) {
       new_->resetVlans(std::move(newVlans));
       changed = true;
     }
-  }
+  });
+
+  updateSection("routes", [&]() {
+    if (routeUpdater_) {
+      routeUpdater_->setRoutesToConfig(
+          intfRouteTables_,
+          *cfg_->staticRoutesWithNhops(),
+          *cfg_->staticRoutesToNull(),
+          *cfg_->staticRoutesToCPU(),
+          *cfg_->staticIp2MplsRoutes(),
+          *cfg_->staticMplsRoutesWithNhops(),
+          *cfg_->staticMplsRoutesToNull(),
+          *cfg_->staticMplsRoutesToCPU());
+    } else if (rib_) {
+      auto newFibs = updateForwardingInformationBaseContainers();
+      if (newFibs) {
+        new_->resetForwardingInformationBases(newFibs);
+        changed = true;
+      }
 
-  if (routeUpdater_) {
-    routeUpdater_->setRoutesToConfig(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops(),
-        *cfg_->staticRoutesToNull(),
-        *cfg_->staticRoutesToCPU(),
-        *cfg_->staticIp2MplsRoutes(),
-        *cfg_->staticMplsRoutesWithNhops(),
-        *cfg_->staticMplsRoutesToNull(),
-        *cfg_->staticMplsRoutesToCPU());
-  } else if (rib_) {
-    auto newFibs = updateForwardingInformationBaseContainers();
-    if (newFibs) {
-      new_->resetForwardingInformationBases(newFibs);
-      changed = true;
+      rib_->reconfigure(
+          intfRouteTables_,
+          *cfg_->staticRoutesWithNhops(),
+          *cfg_->staticRoutesToNull(),
+          *cfg_->staticRoutesToCPU(),
+          *cfg_->staticIp2MplsRoutes(),
+          *cfg_->staticMplsRoutesWithNhops(),
+          *cfg_->staticMplsRoutesToNull(),
+          *cfg_->staticMplsRoutesToCPU(),
+          &updateFibFromConfig,
+          static_cast<void*>(&new_));
+    } else {
+      // switch state UTs don't necessary care about RIB updates
+      XLOG(WARNING)
+          << " Ignoring config updates to rib, should never happen outside of tests";
     }
-
-    rib_->reconfigure(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops(),
-        *cfg_->staticRoutesToNull(),
-        *cfg_->staticRoutesToCPU(),
-        *cfg_->staticIp2MplsRoutes(),
-        *cfg_->staticMplsRoutesWithNhops(),
-        *cfg_->staticMplsRoutesToNull(),
-        *cfg_->staticMplsRoutesToCPU(),
-        &updateFibFromConfig,
-        static_cast<void*>(&new_));
-  } else {
-    // switch state UTs don't necessary care about RIB updates
-    XLOG(WARNING)
-        << " Ignoring config updates to rib, should never happen outside of tests";
-  }
+  });
 
   // resolving mpls next hops may need interfaces to be setup
   // process static mpls routes after processing interfaces
-  auto labelFib = updateStaticMplsRoutes(
-      *cfg_->staticMplsRoutesWithNhops(),
-      *cfg_->staticMplsRoutesToNull(),
-      *cfg_->staticMplsRoutesToNull());
-  if (labelFib) {
-    new_->resetLabelForwardingInformationBase(labelFib);
-    changed = true;
-  }
+  updateSection("mplsRoutes", [&]() {
+    auto labelFib = updateStaticMplsRoutes(
+        *cfg_->staticMplsRoutesWithNhops(),
+        *cfg_->staticMplsRoutesToNull(),
+        *cfg_->staticMplsRoutesToNull());
+    if (labelFib) {
+      new_->resetLabelForwardingInformationBase(labelFib);
+      changed = true;
+    }
+  });
 
   auto newVlans = new_->getVlans();
   VlanID dfltVlan(*cfg_->defaultVlan());
@@ -652,15 +738,16 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
-    auto newCollectors = updateSflowCollectors();
-    if (newCollectors) {
-      new_->resetSflowCollectors(std::move(newCollectors));
-      changed = true;
-    }
-  }
+  updateSectionIfChanged(
+      "sflowCollectors", sflowCollectorConfigChanged(), [&]() {
+        auto newCollectors = updateSflowCollectors();
+        if (newCollectors) {
+          new_->resetSflowCollectors(std::move(newCollectors));
+          changed = true;
+        }
+      });
 
-  {
+  updateSectionIfChanged("loadBalancers", loadBalancerConfigChanged(), [&]() {
     LoadBalancerConfigApplier loadBalancerConfigApplier(
         orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
     auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
@@ -668,7 +755,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
       new_->resetLoadBalancers(std::move(newLoadBalancers));
       changed = true;
     }
-  }
+  });
 
   // normalizer to refresh counter tags
   if (auto normalizer = Normalizer::getInstance()) {
@@ -678,6 +765,8 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
         << "Normalizer failed to initialize, skipping loading counter tags";
   }
 
+  XLOG(DBG2) << "Applied config sections: " << folly::join(", ", sectionTimes_);
+
   if (!changed) {
     return nullptr;
   }
@@ -3443,17 +3532,20 @@ shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib).run();
+  return ThriftConfigApplier(state, config, platform, rib, prevConfig).run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater) {
+    RouteUpdateWrapper* routeUpdater,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, routeUpdater).run();
+  return ThriftConfigApplier(state, config, platform, routeUpdater, prevConfig)
+      .run();
 }
 
 } // namespace facebook::fboss
@@ -29,16 +29,21 @@ class RouteUpdateWrapper;
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * prevConfig, if given, must be the config the state was built from. Config
+ * sections that did not change since then are not re-applied.
  */
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater);
+    RouteUpdateWrapper* routeUpdater,
+    const cfg::SwitchConfig* prevConfig = nullptr);
 } // namespace facebook::fboss
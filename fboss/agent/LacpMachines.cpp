@@ -144,7 +144,7 @@ ReceiveMachine::ReceiveMachine(
     folly::EventBase* evb,
     LacpServicerIf* servicer,
     uint16_t holdTimerMultiplier)
-    : folly::AsyncTimeout(evb),
+    : LacpTimer(evb),
       controller_(controller),
       servicer_(servicer),
       slowEpochSeconds_(std::chrono::seconds(30 * holdTimerMultiplier)),
@@ -409,7 +409,7 @@ const std::chrono::seconds PeriodicTransmissionMachine::LONG_PERIOD(30);
 PeriodicTransmissionMachine::PeriodicTransmissionMachine(
     LacpController& controller,
     folly::EventBase* evb)
-    : folly::AsyncTimeout(evb), controller_(controller) {}
+    : LacpTimer(evb), controller_(controller) {}
 
 PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {}
 
@@ -500,7 +500,7 @@ TransmitMachine::TransmitMachine(
     LacpController& controller,
     folly::EventBase* evb,
     LacpServicerIf* servicer)
-    : folly::AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : LacpTimer(evb), controller_(controller), servicer_(servicer) {}
 
 TransmitMachine::~TransmitMachine() {}
 
@@ -550,7 +550,7 @@ MuxMachine::MuxMachine(
     LacpController& controller,
     folly::EventBase* evb,
     LacpServicerIf* servicer)
-    : AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : LacpTimer(evb), controller_(controller), servicer_(servicer) {}
 
 MuxMachine::~MuxMachine() {}
 
@@ -897,8 +897,14 @@ bool Selector::isAvailable(AggregatePortID aggPortID) const {
   return true;
 }
 
+/*
+ * Selection state is kept per LACP thread. LinkAggregationManager places all
+ * members of an aggregate port on the same LACP EventBase, and a port can only
+ * select a LAG whose actor key is its own aggregate port, so every Selector
+ * consulting the same LAG runs on the same thread.
+ */
 Selector::PortIDToSelection& Selector::portToSelection() {
-  static Selector::PortIDToSelection portToSelection_;
+  static thread_local Selector::PortIDToSelection portToSelection_;
   return portToSelection_;
 }
 
@@ -9,7 +9,9 @@
  */
 #pragma once
 
-#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <chrono>
 #include <optional>
 
 #include <boost/container/flat_map.hpp>
@@ -26,11 +28,31 @@ class AggregatePort;
 class LacpController;
 class LacpServicerIf;
 
+/*
+ * LACP machines time out off the HHWheelTimer of the EventBase they run on,
+ * rather than each arming an AsyncTimeout of its own. All the machines of all
+ * the controllers on a LACP EventBase thus share a single timer wheel.
+ */
+class LacpTimer : public folly::HHWheelTimer::Callback {
+ public:
+  explicit LacpTimer(folly::EventBase* evb) : evb_(evb) {}
+
+  void scheduleTimeout(std::chrono::milliseconds timeout) {
+    evb_->timer().scheduleTimeout(this, timeout);
+  }
+
+  // Timer wheel going away (EventBase destruction) is not a timeout
+  void callbackCanceled() noexcept override {}
+
+ private:
+  folly::EventBase* evb_{nullptr};
+};
+
 /*
  * See IEEE 802.3AD-2000 43.4.3 for an overview of each state machine
  */
 
-class ReceiveMachine : private folly::AsyncTimeout {
+class ReceiveMachine : private LacpTimer {
  public:
   explicit ReceiveMachine(
       LacpController& controller,
@@ -98,7 +120,7 @@ class ReceiveMachine : private folly::AsyncTimeout {
 void toAppend(ReceiveMachine::ReceiveState state, std::string* result);
 std::ostream& operator<<(std::ostream& out, ReceiveMachine::ReceiveState s);
 
-class PeriodicTransmissionMachine : private folly::AsyncTimeout {
+class PeriodicTransmissionMachine : private LacpTimer {
  public:
   explicit PeriodicTransmissionMachine(
       LacpController& controller,
@@ -132,7 +154,7 @@ void toAppend(
     PeriodicTransmissionMachine::PeriodicState state,
     std::string* result);
 
-class TransmitMachine : private folly::AsyncTimeout {
+class TransmitMachine : private LacpTimer {
  public:
   TransmitMachine(
       LacpController& controller,
@@ -159,7 +181,7 @@ class TransmitMachine : private folly::AsyncTimeout {
   LacpServicerIf* servicer_{nullptr};
 };
 
-class MuxMachine : private folly::AsyncTimeout {
+class MuxMachine : private LacpTimer {
  public:
   MuxMachine(
       LacpController& controller,
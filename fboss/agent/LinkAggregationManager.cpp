@@ -30,6 +30,7 @@
 #include <iterator>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -93,6 +94,70 @@ std::shared_ptr<SwitchState> ProgramForwardingAndPartnerState::operator()(
   return nextState;
 }
 
+/*
+ * LACPDUs transmitted while processing one loop of a LACP EventBase (e.g. the
+ * periodic transmission timers of many members firing on the same timer wheel
+ * tick) are deferred to the end of that loop. They are then framed against a
+ * single SwitchState snapshot, but still sent one at a time, as HwSwitch has
+ * no API to send several packets in one call.
+ */
+class LacpDeferredTx : private folly::EventBase::LoopCallback {
+ public:
+  LacpDeferredTx(SwSwitch* sw, folly::EventBase* evb) : sw_(sw), evb_(evb) {}
+
+  void enqueue(std::unique_ptr<TxPacket> pkt, LACPDU lacpdu, PortID portID) {
+    CHECK(evb_->inRunningEventBaseThread());
+    if (pending_.empty()) {
+      evb_->runInLoop(this);
+    }
+    pending_.push_back({std::move(pkt), std::move(lacpdu), portID});
+  }
+
+ private:
+  struct PendingLacpdu {
+    std::unique_ptr<TxPacket> pkt;
+    LACPDU lacpdu;
+    PortID portID;
+  };
+
+  void runLoopCallback() noexcept override {
+    std::vector<PendingLacpdu> pending;
+    pending.swap(pending_);
+
+    folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
+    auto state = sw_->getState();
+    for (auto& tx : pending) {
+      auto port = state->getPorts()->getPortIf(tx.portID);
+      if (!port) {
+        XLOG(ERR) << "Dropping LACPDU to removed port " << tx.portID;
+        continue;
+      }
+
+      folly::io::RWPrivateCursor writer(tx.pkt->buf());
+      TxPacket::writeEthHeader(
+          &writer,
+          LACPDU::kSlowProtocolsDstMac(),
+          cpuMac,
+          port->getIngressVlan(),
+          LACPDU::EtherType::SLOW_PROTOCOLS);
+
+      writer.writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
+
+      tx.lacpdu.to(&writer);
+
+      // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
+      // OutOfPacket will actually send the packet to unicast queue.
+      sw_->sendNetworkControlPacketAsync(
+          std::move(tx.pkt), PortDescriptor(tx.portID));
+    }
+    XLOG(DBG4) << "Transmitted " << pending.size() << " deferred LACPDUs";
+  }
+
+  SwSwitch* sw_{nullptr};
+  folly::EventBase* evb_{nullptr};
+  std::vector<PendingLacpdu> pending_;
+};
+
 // Needed for CHECK_* macros to work with PortIDToController::iterator
 std::ostream& operator<<(
     std::ostream& out,
@@ -102,9 +167,25 @@ std::ostream& operator<<(
 
 LinkAggregationManager::LinkAggregationManager(SwSwitch* sw)
     : portToController_(), sw_(sw) {
+  for (auto* evb : sw_->getLacpEvbs()) {
+    lacpDeferredTxs_.emplace(evb, std::make_unique<LacpDeferredTx>(sw_, evb));
+  }
   sw_->registerStateObserver(this, "LinkAggregationManager");
 }
 
+LacpDeferredTx* LinkAggregationManager::lacpDeferredTxForThisThread() const {
+  for (const auto& [evb, deferredTx] : lacpDeferredTxs_) {
+    if (evb->inRunningEventBaseThread()) {
+      return deferredTx.get();
+    }
+  }
+  return nullptr;
+}
+
+bool LinkAggregationManager::inLacpEvbThread() const {
+  return lacpDeferredTxForThisThread() != nullptr;
+}
+
 void LinkAggregationManager::handlePacket(
     std::unique_ptr<RxPacket> pkt,
     folly::io::Cursor c) {
@@ -156,7 +237,7 @@ void LinkAggregationManager::aggregatePortAdded(
         subport.portID,
         std::make_shared<LacpController>(
             subport.portID,
-            sw_->getLacpEvb(),
+            sw_->getLacpEvb(aggPort->getID()),
             subport.priority,
             subport.rate,
             subport.activity,
@@ -319,7 +400,8 @@ void LinkAggregationManager::populatePartnerPairs(
 }
 
 bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
-  CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
+  auto* deferredTx = lacpDeferredTxForThisThread();
+  CHECK(deferredTx);
 
   auto pkt = sw_->allocatePacket(LACPDU::LENGTH);
   if (!pkt) {
@@ -327,27 +409,7 @@ bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
     return false;
   }
 
-  folly::io::RWPrivateCursor writer(pkt->buf());
-
-  folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
-
-  auto port = sw_->getState()->getPorts()->getPortIf(portID);
-  CHECK(port);
-
-  TxPacket::writeEthHeader(
-      &writer,
-      LACPDU::kSlowProtocolsDstMac(),
-      cpuMac,
-      port->getIngressVlan(),
-      LACPDU::EtherType::SLOW_PROTOCOLS);
-
-  writer.writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
-
-  lacpdu.to(&writer);
-
-  // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
-  // OutOfPacket will actually send the packet to unicast queue.
-  sw_->sendNetworkControlPacketAsync(std::move(pkt), PortDescriptor(portID));
+  deferredTx->enqueue(std::move(pkt), std::move(lacpdu), portID);
 
   return true;
 }
@@ -356,7 +418,7 @@ void LinkAggregationManager::enableForwardingAndSetPartnerState(
     PortID portID,
     AggregatePortID aggPortID,
     const AggregatePort::PartnerState& partnerState) {
-  CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
+  CHECK(inLacpEvbThread());
 
   auto enableFwdStateFn = ProgramForwardingAndPartnerState(
       portID, aggPortID, AggregatePort::Forwarding::ENABLED, partnerState);
@@ -369,7 +431,7 @@ void LinkAggregationManager::disableForwardingAndSetPartnerState(
     PortID portID,
     AggregatePortID aggPortID,
     const ParticipantInfo& partnerState) {
-  CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
+  CHECK(inLacpEvbThread());
 
   auto disableFwdStateFn = ProgramForwardingAndPartnerState(
       portID, aggPortID, AggregatePort::Forwarding::DISABLED, partnerState);
@@ -390,8 +452,8 @@ std::vector<std::shared_ptr<LacpController>>
 LinkAggregationManager::getControllersFor(
     folly::Range<std::vector<PortID>::const_iterator> ports) {
   // Although this method is thread-safe, it is only invoked from a Selector
-  // object, which should always be executing over the LACP EVB
-  CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
+  // object, which should always be executing over a LACP EVB
+  CHECK(inLacpEvbThread());
 
   std::vector<std::shared_ptr<LacpController>> controllers(
       std::distance(ports.begin(), ports.end()));
@@ -415,6 +477,11 @@ LinkAggregationManager::~LinkAggregationManager() {
     controller.second->stopMachines();
   }
   sw_->unregisterStateObserver(this);
+  // Loop callbacks must be torn down from their own EventBase
+  for (auto& [evb, deferredTx] : lacpDeferredTxs_) {
+    evb->runInEventBaseThreadAndWait(
+        [&deferredTx = deferredTx]() { deferredTx.reset(); });
+  }
 }
 
 } // namespace facebook::fboss
@@ -18,6 +18,7 @@
 
 #include <folly/SharedMutex.h>
 #include <folly/io/Cursor.h>
+#include <folly/io/async/EventBase.h>
 
 #include <memory>
 #include <vector>
@@ -26,6 +27,7 @@ namespace facebook::fboss {
 
 class LacpController;
 class LacpPartnerPair;
+class LacpDeferredTx;
 class RxPacket;
 class StateDelta;
 class SwSwitch;
@@ -115,6 +117,11 @@ class LinkAggregationManager : public StateObserver, public LacpServicerIf {
       const std::shared_ptr<AggregatePort>& oldAggPort,
       const std::shared_ptr<AggregatePort>& newAggPort);
 
+  // Returns the deferred LACPDU tx of the LACP EventBase this is running on,
+  // if any
+  LacpDeferredTx* lacpDeferredTxForThisThread() const;
+  bool inLacpEvbThread() const;
+
   // Forbidden copy constructor and assignment operator
   LinkAggregationManager(LinkAggregationManager const&) = delete;
   LinkAggregationManager& operator=(LinkAggregationManager const&) = delete;
@@ -128,6 +135,11 @@ class LinkAggregationManager : public StateObserver, public LacpServicerIf {
   PortIDToController portToController_;
   mutable folly::SharedMutexWritePriority controllersLock_;
   SwSwitch* sw_{nullptr};
+  // One per LACP EventBase, populated at construction and never modified
+  // after, hence safe to read from all the LACP threads without locking
+  boost::container::
+      flat_map<folly::EventBase*, std::unique_ptr<LacpDeferredTx>>
+          lacpDeferredTxs_;
 };
 
 } // namespace facebook::fboss
@@ -12,23 +12,82 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <folly/logging/xlog.h>
+
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw),
+      pendingL2Updates_(
+          std::make_shared<folly::Synchronized<PendingL2Updates>>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
+  if (l2EntryUpdateType == L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD) {
+    sw_->stats()->macLearnUpdate();
+  } else {
+    sw_->stats()->macAgeUpdate();
+  }
+
+  bool scheduleUpdate{false};
+  {
+    auto pending = pendingL2Updates_->wlock();
+    // A non empty pending set implies a state update which will drain it is
+    // already queued up.
+    scheduleUpdate = pending->empty();
+    L2UpdateKey key{l2Entry.getVlanID(), l2Entry.getMac()};
+    auto& keyUpdates = (*pending)[key];
+    if (!keyUpdates.empty() && keyUpdates.back().second == l2EntryUpdateType &&
+        isSameL2Entry(keyUpdates.back().first, l2Entry)) {
+      // Repeating the last queued update for the (VLAN, MAC) is a no-op
+      sw_->stats()->macUpdateCoalesced();
+    } else {
+      keyUpdates.emplace_back(l2Entry, l2EntryUpdateType);
+    }
+  }
+  if (!scheduleUpdate) {
+    return;
+  }
+
   auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
+      [pendingL2Updates = pendingL2Updates_](
+          const std::shared_ptr<SwitchState>& state) {
+        PendingL2Updates updates;
+        pendingL2Updates->wlock()->swap(updates);
+        return applyPendingL2Updates(state, std::move(updates));
       };
 
   sw_->updateState(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+      "Programming MAC table updates", std::move(updateMacTableFn));
+}
+
+std::shared_ptr<SwitchState> MacTableManager::applyPendingL2Updates(
+    const std::shared_ptr<SwitchState>& state,
+    PendingL2Updates updates) {
+  std::shared_ptr<SwitchState> newState{state};
+  size_t numUpdates{0};
+  for (const auto& [key, keyUpdates] : updates) {
+    // MacTableUtils only clones nodes that are published, so once a VLAN's
+    // MacTable is modified for the first entry, the remaining entries of the
+    // batch are applied in place.
+    for (const auto& [l2Entry, l2EntryUpdateType] : keyUpdates) {
+      newState =
+          MacTableUtils::updateMacTable(newState, l2Entry, l2EntryUpdateType);
+    }
+    numUpdates += keyUpdates.size();
+  }
+  XLOG(DBG2) << "Applied " << numUpdates << " MAC table updates for "
+             << updates.size() << " MACs";
+  return newState;
+}
+
+bool MacTableManager::isSameL2Entry(const L2Entry& lhs, const L2Entry& rhs) {
+  return lhs.getPort() == rhs.getPort() && lhs.getType() == rhs.getType() &&
+      lhs.getClassID() == rhs.getClassID();
 }
 
 } // namespace facebook::fboss
@@ -11,14 +11,31 @@
 
 #include "fboss/agent/L2Entry.h"
 
+#include <folly/Synchronized.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace facebook::fboss {
 
 class SwSwitch;
+class SwitchState;
 
 class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
 
+  /*
+   * L2 learn/age callbacks are not turned into a state update each. Instead
+   * they are queued up per (VLAN, MAC) and applied in a single state update
+   * that drains everything which accumulated until the update thread got to
+   * it. The updates of a (VLAN, MAC) are replayed in the order received, so
+   * that e.g. an age followed by a relearn on another port or with another
+   * class still drops the old entry. Only repeats of the last queued update
+   * are coalesced.
+   */
   void handleL2LearningUpdate(
       L2Entry l2Entry,
       L2EntryUpdateType l2EntryUpdateType);
@@ -28,7 +45,26 @@ class MacTableManager {
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
+  using L2UpdateKey = std::pair<VlanID, folly::MacAddress>;
+  /*
+   * Ordered by VLAN first, so that all the MACs of a VLAN are applied back
+   * to back and the VLAN's MacTable is only cloned once per batch.
+   */
+  using PendingL2Updates = std::map<
+      L2UpdateKey,
+      std::vector<std::pair<L2Entry, L2EntryUpdateType>>>;
+
+  static std::shared_ptr<SwitchState> applyPendingL2Updates(
+      const std::shared_ptr<SwitchState>& state,
+      PendingL2Updates updates);
+  static bool isSameL2Entry(const L2Entry& lhs, const L2Entry& rhs);
+
   SwSwitch* sw_{nullptr};
+  /*
+   * Shared with the scheduled state update, which may run after this
+   * object is gone during SwSwitch teardown.
+   */
+  std::shared_ptr<folly::Synchronized<PendingL2Updates>> pendingL2Updates_;
 };
 
 } // namespace facebook::fboss
@@ -209,7 +209,13 @@ std::unique_ptr<AgentConfig> parseConfig(int argc, char** argv) {
   // one pass over flags, but don't clear argc/argv. We only do this
   // to extract the 'config' arg.
   gflags::ParseCommandLineFlags(&argc, &argv, false);
-  return AgentConfig::fromDefaultFile();
+  auto begin = std::chrono::steady_clock::now();
+  auto config = AgentConfig::fromDefaultFile();
+  restart_time::recordDuration(
+      "config_load",
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - begin));
+  return config;
 }
 
 void initFlagDefaults(const std::map<std::string, std::string>& defaults) {
@@ -0,0 +1,214 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/ResourceAccountant.h"
+
+#include "fboss/agent/hw/switch_asics/HwAsic.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/NdpTable.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    hw_resource_percentage,
+    100,
+    "Percentage of each hardware table that updates are allowed to use, "
+    "updates going beyond are rejected before being programmed");
+
+namespace {
+constexpr int64_t kV4RouteEntries = 1;
+constexpr int64_t kV6RouteEntries = 2;
+constexpr int64_t kV6LongPrefixRouteEntries = 4;
+constexpr int64_t kArpHostEntries = 1;
+constexpr int64_t kNdpHostEntries = 2;
+constexpr uint8_t kV6LongPrefixMinLength = 65;
+
+template <typename MapT>
+int64_t mapSize(const std::shared_ptr<MapT>& map) {
+  return map ? map->size() : 0;
+}
+
+bool checkResource(
+    const char* name,
+    int64_t used,
+    int64_t projected,
+    std::optional<uint32_t> capacity) {
+  if (!capacity || projected <= used) {
+    // Updates that don't grow the usage are let through, so that a state
+    // over the limit, e.g. after a change of limit, can still shrink
+    return true;
+  }
+  auto allowed = int64_t(*capacity) * FLAGS_hw_resource_percentage / 100;
+  if (projected > allowed) {
+    XLOG(WARNING) << "Update needs " << projected << " " << name << ", "
+                  << allowed << " allowed out of " << *capacity;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+namespace facebook::fboss {
+
+ResourceAccountant::ResourceAccountant(const HwAsic* asic) : asic_(asic) {}
+
+bool ResourceAccountant::isValidUpdate(const StateDelta& delta) const {
+  EcmpGroupRefDelta groupRefDelta;
+  return checkUsage(projectUsage(delta, &groupRefDelta));
+}
+
+void ResourceAccountant::stateChanged(const StateDelta& delta) {
+  EcmpGroupRefDelta groupRefDelta;
+  usage_ = projectUsage(delta, &groupRefDelta);
+  for (auto& [nhops, refDelta] : groupRefDelta) {
+    auto& refCount = ecmpGroupRefCounts_[nhops];
+    refCount += refDelta;
+    if (refCount == 0) {
+      ecmpGroupRefCounts_.erase(nhops);
+    }
+  }
+}
+
+ResourceAccountant::Usage ResourceAccountant::projectUsage(
+    const StateDelta& delta,
+    EcmpGroupRefDelta* groupRefDelta) const {
+  auto usage = usage_;
+
+  auto processFibDelta = [&](const auto& fibDelta) {
+    forEachChanged(
+        fibDelta,
+        [&](const auto& oldRoute, const auto& newRoute) {
+          accountRoute(*oldRoute, -1, &usage, groupRefDelta);
+          accountRoute(*newRoute, 1, &usage, groupRefDelta);
+        },
+        [&](const auto& addedRoute) {
+          accountRoute(*addedRoute, 1, &usage, groupRefDelta);
+        },
+        [&](const auto& removedRoute) {
+          accountRoute(*removedRoute, -1, &usage, groupRefDelta);
+        });
+  };
+  for (const auto& fibContainerDelta : delta.getFibsDelta()) {
+    processFibDelta(fibContainerDelta.getFibDelta<folly::IPAddressV4>());
+    processFibDelta(fibContainerDelta.getFibDelta<folly::IPAddressV6>());
+  }
+
+  // Groups that routes start or stop using altogether
+  for (const auto& [nhops, refDelta] : *groupRefDelta) {
+    auto iter = ecmpGroupRefCounts_.find(nhops);
+    auto refCount = iter == ecmpGroupRefCounts_.end() ? 0 : iter->second;
+    if (refCount == 0 && refDelta > 0) {
+      usage.ecmpGroups++;
+      usage.ecmpMembers += getEcmpMemberCount(nhops);
+    } else if (refCount > 0 && refCount + refDelta == 0) {
+      usage.ecmpGroups--;
+      usage.ecmpMembers -= getEcmpMemberCount(nhops);
+    }
+  }
+
+  for (const auto& vlanDelta : delta.getVlansDelta()) {
+    const auto& oldVlan = vlanDelta.getOld();
+    const auto& newVlan = vlanDelta.getNew();
+    usage.hostEntries += kArpHostEntries *
+        (mapSize(newVlan ? newVlan->getArpTable() : nullptr) -
+         mapSize(oldVlan ? oldVlan->getArpTable() : nullptr));
+    usage.hostEntries += kNdpHostEntries *
+        (mapSize(newVlan ? newVlan->getNdpTable() : nullptr) -
+         mapSize(oldVlan ? oldVlan->getNdpTable() : nullptr));
+  }
+
+  const auto& oldAcls = delta.oldState()->getAcls();
+  const auto& newAcls = delta.newState()->getAcls();
+  if (oldAcls != newAcls) {
+    usage.aclEntries += mapSize(newAcls) - mapSize(oldAcls);
+  }
+  return usage;
+}
+
+template <typename AddrT>
+void ResourceAccountant::accountRoute(
+    const Route<AddrT>& route,
+    int64_t sign,
+    Usage* usage,
+    EcmpGroupRefDelta* groupRefDelta) const {
+  int64_t entries = kV4RouteEntries;
+  if constexpr (std::is_same_v<AddrT, folly::IPAddressV6>) {
+    entries = route.prefix().mask >= kV6LongPrefixMinLength
+        ? kV6LongPrefixRouteEntries
+        : kV6RouteEntries;
+  }
+  if (route.isHostRoute() &&
+      asic_->isSupported(HwAsic::Feature::HOSTTABLE_FOR_HOSTROUTES)) {
+    // Host table entries are as wide as those of the neighbors
+    usage->hostEntries += sign *
+        (std::is_same_v<AddrT, folly::IPAddressV6> ? kNdpHostEntries
+                                                    : kArpHostEntries);
+  } else {
+    usage->routeEntries += sign * entries;
+  }
+
+  const auto& fwd = route.getForwardInfo();
+  if (!route.isResolved() ||
+      fwd.getAction() != RouteForwardAction::NEXTHOPS ||
+      fwd.getNextHopSet().size() <= 1) {
+    return;
+  }
+  (*groupRefDelta)[fwd.normalizedNextHops()] += sign;
+}
+
+int64_t ResourceAccountant::getEcmpMemberCount(
+    const RouteNextHopSet& nhops) const {
+  if (asic_->isSupported(HwAsic::Feature::SAI_WEIGHTED_NEXTHOPGROUP_MEMBER)) {
+    return nhops.size();
+  }
+  // Weights are implemented by repeating the next hop in the group
+  int64_t members = 0;
+  for (const auto& nhop : nhops) {
+    members += std::max(nhop.weight(), NextHopWeight(1));
+  }
+  return members;
+}
+
+bool ResourceAccountant::checkUsage(const Usage& projected) const {
+  // Evaluate every check so that each overflowing table gets logged
+  auto valid = checkResource(
+      "ECMP groups",
+      usage_.ecmpGroups,
+      projected.ecmpGroups,
+      asic_->getMaxEcmpGroups());
+  valid &= checkResource(
+      "ECMP members",
+      usage_.ecmpMembers,
+      projected.ecmpMembers,
+      asic_->getMaxEcmpMembers());
+  valid &= checkResource(
+      "route table entries",
+      usage_.routeEntries,
+      projected.routeEntries,
+      asic_->getMaxRouteTableSize());
+  valid &= checkResource(
+      "host table entries",
+      usage_.hostEntries,
+      projected.hostEntries,
+      asic_->getMaxHostTableSize());
+  valid &= checkResource(
+      "ACL entries",
+      usage_.aclEntries,
+      projected.aclEntries,
+      asic_->getMaxAclEntries());
+  return valid;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/agent/state/StateDelta.h"
+
+#include <map>
+
+namespace facebook::fboss {
+
+class HwAsic;
+
+/*
+ * Tracks how much of the ECMP, route, host and ACL tables of the ASIC the
+ * applied switch state uses, so that an update that would not fit can be
+ * rejected before it is programmed. Finding out from the SDK instead means
+ * failing part way through the update and rolling the hardware back.
+ *
+ * Usage is projected from the StateDelta of each update, only the routes
+ * that changed and the sizes of the changed tables are looked at. It is an
+ * estimate of what the hardware uses, not a readback of it:
+ *  - routes sharing their normalized next hops share an ECMP group. With
+ *    UCMP, a next hop takes as many members as its weight unless the ASIC
+ *    supports weighted members.
+ *  - IPv6 routes take two route table entries, four for prefixes longer
+ *    than /64. Host routes go to the host table if the ASIC puts them there.
+ *  - NDP entries take two host table entries, ARP entries one.
+ *  - only the ACL entries of the default table are counted.
+ *
+ * Not thread safe, it is updated along with the applied state.
+ */
+class ResourceAccountant {
+ public:
+  struct Usage {
+    int64_t ecmpGroups{0};
+    int64_t ecmpMembers{0};
+    int64_t routeEntries{0};
+    int64_t hostEntries{0};
+    int64_t aclEntries{0};
+  };
+
+  explicit ResourceAccountant(const HwAsic* asic);
+
+  /*
+   * Whether the hardware can hold the state delta leads to, given the usage
+   * accounted so far. Only tables the update grows are checked. Does not
+   * change the accounted usage.
+   */
+  bool isValidUpdate(const StateDelta& delta) const;
+
+  /*
+   * Accounts for delta having been applied to the hardware.
+   */
+  void stateChanged(const StateDelta& delta);
+
+  const Usage& getUsage() const {
+    return usage_;
+  }
+
+ private:
+  // Change in the number of routes using each ECMP group
+  using EcmpGroupRefDelta = std::map<RouteNextHopSet, int64_t>;
+
+  Usage projectUsage(const StateDelta& delta, EcmpGroupRefDelta* groupRefDelta)
+      const;
+  template <typename AddrT>
+  void accountRoute(
+      const Route<AddrT>& route,
+      int64_t sign,
+      Usage* usage,
+      EcmpGroupRefDelta* groupRefDelta) const;
+  int64_t getEcmpMemberCount(const RouteNextHopSet& nhops) const;
+  bool checkUsage(const Usage& projected) const;
+
+  const HwAsic* asic_;
+  Usage usage_;
+  // Number of routes using each ECMP group programmed
+  std::map<RouteNextHopSet, int64_t> ecmpGroupRefCounts_;
+};
+
+} // namespace facebook::fboss
@@ -22,6 +22,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -33,6 +35,7 @@ constexpr auto kWarmBootPrefix = "warm_boot.";
 constexpr auto kColdBootPrefix = "cold_boot.";
 constexpr auto kStageCounterSuffix = "stage_duration_ms";
 constexpr auto kTotalCounterSuffix = "total_duration_ms";
+constexpr auto kDurationCounterSuffix = "duration_ms";
 constexpr auto kMaxWarmBootTime = minutes(5);
 
 // The output of /proc/<pid>/stat outputs a bunch of ints separated by
@@ -159,6 +162,17 @@ class RestartTimeTracker {
     return tp;
   }
 
+  void newDuration(const std::string& name, milliseconds duration) {
+    // Only track the restart, not work done once configured
+    if (completed_) {
+      return;
+    }
+    auto counterName =
+        folly::to<std::string>(prefix_, name, ".", kDurationCounterSuffix);
+    fb303::fbData->setCounter(counterName, duration.count());
+    XLOG(DBG2) << counterName << " -> " << duration.count() << "ms";
+  }
+
  private:
   std::string savePath(RestartEvent type) {
     return folly::to<std::string>(warmBootDir_, "/", to_string(type));
@@ -208,6 +222,9 @@ class RestartTimeTracker {
 namespace restart_time {
 
 folly::Synchronized<std::unique_ptr<RestartTimeTracker>, std::mutex> impl_;
+// Durations recorded before init
+folly::Synchronized<std::vector<std::pair<std::string, milliseconds>>>
+    pendingDurations_;
 
 void init(const std::string& warmBootDir, bool warmBoot) {
   auto tracker = impl_.lock();
@@ -215,6 +232,11 @@ void init(const std::string& warmBootDir, bool warmBoot) {
     throw std::runtime_error("Called restart_time::init twice...");
   }
   *tracker = std::make_unique<RestartTimeTracker>(warmBootDir, warmBoot);
+  auto pending = pendingDurations_.wlock();
+  for (const auto& [name, duration] : *pending) {
+    (*tracker)->newDuration(name, duration);
+  }
+  pending->clear();
 }
 
 void mark(RestartEvent event) {
@@ -226,6 +248,15 @@ void mark(RestartEvent event) {
   }
 }
 
+void recordDuration(const std::string& name, milliseconds duration) {
+  auto tracker = impl_.lock();
+  if (*tracker) {
+    (*tracker)->newDuration(name, duration);
+  } else {
+    pendingDurations_.wlock()->emplace_back(name, duration);
+  }
+}
+
 void stop() {
   auto tracker = impl_.lock();
   (*tracker).reset();
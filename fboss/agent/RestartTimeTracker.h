@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
@@ -26,6 +27,10 @@
  * monotonicity. An implementation that uses process_time as epoch is
  * also possible, which would break the duration calculation in this
  * module.
+ *
+ * Work done within a stage can be broken out with recordDuration(),
+ * e.g. how long loading the config took. Durations recorded before
+ * init() are exported once the boot type is known.
  */
 
 namespace facebook::fboss {
@@ -44,6 +49,9 @@ enum class RestartEvent : uint16_t {
 namespace restart_time {
 void init(const std::string& warmBootDir, bool warmBoot);
 void mark(RestartEvent event);
+void recordDuration(
+    const std::string& name,
+    std::chrono::milliseconds duration);
 void stop();
 }; // namespace restart_time
 
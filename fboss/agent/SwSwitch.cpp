@@ -44,6 +44,7 @@
 #include "fboss/agent/PortUpdateHandler.h"
 #include "fboss/agent/ResolvedNexthopMonitor.h"
 #include "fboss/agent/ResolvedNexthopProbeScheduler.h"
+#include "fboss/agent/ResourceAccountant.h"
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
@@ -131,6 +132,12 @@ DEFINE_int32(
     64,
     "Expected minimum ethernet packet length");
 
+DEFINE_int32(
+    lacp_event_base_shards,
+    1,
+    "Number of threads LACP state machines are sharded across, by aggregate "
+    "port");
+
 DEFINE_int32(
     fsdbStatsStreamIntervalSeconds,
     5,
@@ -178,6 +185,7 @@ facebook::fboss::PortStatus fillInPortStatus(
 }
 
 auto constexpr kHwUpdateFailures = "hw_update_failures";
+auto constexpr kHwResourceRejects = "hw_resource_rejected_updates";
 
 } // anonymous namespace
 
@@ -277,6 +285,7 @@ void SwSwitch::stop(bool revertToMinAlpmState) {
   updThreadHeartbeat_.reset();
   packetTxThreadHeartbeat_.reset();
   lacpThreadHeartbeat_.reset();
+  lacpShardThreadHeartbeats_.clear();
   neighborCacheThreadHeartbeat_.reset();
   if (rib_) {
     rib_->stop();
@@ -527,6 +536,7 @@ void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   bootType_ = hwInitRet.bootType;
   rib_ = std::move(hwInitRet.rib);
   fb303::fbData->setCounter(kHwUpdateFailures, 0);
+  fb303::fbData->setCounter(kHwResourceRejects, 0);
 
   XLOG(DBG0) << "hardware initialized in " << hwInitRet.bootTime
              << " seconds; applying initial config";
@@ -537,10 +547,21 @@ void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   // Store the initial state
   initialState->publish();
   setStateInternal(initialState);
+  resourceAccountant_ =
+      std::make_unique<ResourceAccountant>(platform_->getAsic());
+  resourceAccountant_->stateChanged(
+      StateDelta(std::make_shared<SwitchState>(), initialState));
 
   // start LACP thread
   lacpThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossLacpThread", &lacpEventBase_); }));
+  for (auto shard = 1; shard < FLAGS_lacp_event_base_shards; ++shard) {
+    auto* evb =
+        lacpShardEventBases_.emplace_back(std::make_unique<EventBase>()).get();
+    lacpShardThreads_.emplace_back(new std::thread([=] {
+      this->threadLoop(folly::to<std::string>("fbossLacpThread", shard), evb);
+    }));
+  }
 
   // start lagMananger
   if (flags & SwitchFlags::ENABLE_LACP) {
@@ -631,6 +652,14 @@ void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
         stats()->neighborCacheEventBacklog(backlog);
       });
 
+  for (size_t shard = 0; shard < lacpShardThreads_.size(); ++shard) {
+    lacpShardThreadHeartbeats_.push_back(std::make_shared<ThreadHeartbeat>(
+        lacpShardEventBases_[shard].get(),
+        *folly::getThreadName(lacpShardThreads_[shard]->get_id()),
+        FLAGS_thread_heartbeat_ms,
+        updateLacpThreadHeartbeatStats));
+  }
+
   heartbeatWatchdog_ = std::make_unique<ThreadHeartbeatWatchdog>(
       std::chrono::milliseconds(FLAGS_thread_heartbeat_ms * 10),
       [this]() { stats()->ThreadHeartbeatMissCount(); });
@@ -638,6 +667,9 @@ void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   heartbeatWatchdog_->startMonitoringHeartbeat(packetTxThreadHeartbeat_);
   heartbeatWatchdog_->startMonitoringHeartbeat(updThreadHeartbeat_);
   heartbeatWatchdog_->startMonitoringHeartbeat(lacpThreadHeartbeat_);
+  for (const auto& heartbeat : lacpShardThreadHeartbeats_) {
+    heartbeatWatchdog_->startMonitoringHeartbeat(heartbeat);
+  }
   heartbeatWatchdog_->startMonitoringHeartbeat(neighborCacheThreadHeartbeat_);
   heartbeatWatchdog_->start();
 
@@ -917,11 +949,23 @@ void SwSwitch::handlePendingUpdates() {
   auto newAppliedState = newDesiredState;
   // Now apply the update and notify subscribers
   if (newDesiredState != oldAppliedState) {
-    auto isTransaction = updates.begin()->hwFailureProtected() &&
-        getHw()->transactionsSupported();
-    // There was some change during these state updates
-    newAppliedState =
-        applyUpdate(oldAppliedState, newDesiredState, isTransaction);
+    auto hwFailureProtected = updates.begin()->hwFailureProtected();
+    auto isTransaction =
+        hwFailureProtected && getHw()->transactionsSupported();
+    if (hwFailureProtected &&
+        !resourceAccountant_->isValidUpdate(
+            StateDelta(oldAppliedState, newDesiredState))) {
+      // The hardware can't hold the new state, fail the update the way a
+      // failure to program it would, but without touching the hardware
+      XLOG(WARNING) << "Update " << updates.begin()->getName()
+                    << " exceeds hardware resources, rejecting it";
+      fb303::fbData->incrementCounter(kHwResourceRejects);
+      newAppliedState = oldAppliedState;
+    } else {
+      // There was some change during these state updates
+      newAppliedState =
+          applyUpdate(oldAppliedState, newDesiredState, isTransaction);
+    }
     if (newDesiredState != newAppliedState) {
       if (isExiting()) {
         /*
@@ -1041,6 +1085,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   }
 
   setStateInternal(newAppliedState);
+  resourceAccountant_->stateChanged(StateDelta(oldState, newAppliedState));
 
   // Notifies all observers of the current state update.
   notifyStateObservers(StateDelta(oldState, newAppliedState));
@@ -1376,6 +1421,9 @@ void SwSwitch::stopThreads() {
     lacpEventBase_.runInEventBaseThread(
         [this] { lacpEventBase_.terminateLoopSoon(); });
   }
+  for (auto& evb : lacpShardEventBases_) {
+    evb->runInEventBaseThread([evb = evb.get()] { evb->terminateLoopSoon(); });
+  }
   if (neighborCacheThread_) {
     neighborCacheEventBase_.runInEventBaseThread(
         [this] { neighborCacheEventBase_.terminateLoopSoon(); });
@@ -1395,6 +1443,9 @@ void SwSwitch::stopThreads() {
   if (lacpThread_) {
     lacpThread_->join();
   }
+  for (auto& thread : lacpShardThreads_) {
+    thread->join();
+  }
   if (neighborCacheThread_) {
     neighborCacheThread_->join();
   }
@@ -1413,6 +1464,20 @@ void SwSwitch::stopThreads() {
   platform_->stop();
 }
 
+folly::EventBase* SwSwitch::getLacpEvb(AggregatePortID aggPortID) {
+  auto shard = static_cast<uint32_t>(aggPortID) %
+      (lacpShardEventBases_.size() + 1);
+  return shard == 0 ? &lacpEventBase_ : lacpShardEventBases_[shard - 1].get();
+}
+
+std::vector<folly::EventBase*> SwSwitch::getLacpEvbs() {
+  std::vector<folly::EventBase*> evbs{&lacpEventBase_};
+  for (const auto& evb : lacpShardEventBases_) {
+    evbs.push_back(evb.get());
+  }
+  return evbs;
+}
+
 void SwSwitch::threadLoop(StringPiece name, EventBase* eventBase) {
   initThread(name);
   eventBase->loopForever();
@@ -1708,15 +1773,27 @@ void SwSwitch::applyConfig(const std::string& reason, bool reload) {
   auto target = reload ? platform_->reloadConfig() : platform_->config();
   const auto& newConfig = *target->thrift.sw();
   applyConfig(reason, newConfig);
-  target->dumpConfig(platform_->getRunningConfigDumpFile());
+  // The dump holds the whole agent config, not just the switch config, so it
+  // is up to date only if no part of the agent config changed
+  auto targetHash = agentConfigHash(target->thrift);
+  if (targetHash != runningConfigDumpHash_) {
+    target->dumpConfig(platform_->getRunningConfigDumpFile());
+    runningConfigDumpHash_ = targetHash;
+  }
 }
 
 void SwSwitch::applyConfig(
     const std::string& reason,
     const cfg::SwitchConfig& newConfig) {
   // We don't need to hold a lock here. updateStateBlocking() does that for us.
+  auto begin = steady_clock::now();
+  auto newConfigHash = switchConfigHash(newConfig);
   auto routeUpdater = getRouteUpdater();
   auto oldConfig = getConfig();
+  // The state is only known to be built from oldConfig once a config was
+  // applied by this process, e.g. not on the first apply after warm boot
+  const cfg::SwitchConfig* prevConfig =
+      *getConfigAppliedInfo().lastAppliedInMs() ? &oldConfig : nullptr;
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
@@ -1738,21 +1815,30 @@ void SwSwitch::applyConfig(
           XLOG(WARN) << "Current platform doesn't have QsfpCache. "
                      << "No need to build TransceiverMap";
         }
-        auto newState = rib_
-            ? applyThriftConfig(
-                  originalState, &newConfig, getPlatform(), &routeUpdater)
-            : applyThriftConfig(originalState, &newConfig, getPlatform());
+        auto newState = rib_ ? applyThriftConfig(
+                                   originalState,
+                                   &newConfig,
+                                   getPlatform(),
+                                   &routeUpdater,
+                                   prevConfig)
+                             : applyThriftConfig(
+                                   originalState,
+                                   &newConfig,
+                                   getPlatform(),
+                                   static_cast<RoutingInformationBase*>(
+                                       nullptr),
+                                   prevConfig);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
         }
 
         // Update config cached in SwSwitch. Update this even if the config did
-        // not change (as this might be during warmboot).
-        curConfig_ = newConfig;
-        curConfigStr_ =
-            apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-                newConfig);
+        // not change the state (as this might be during warmboot).
+        if (newConfigHash != curConfigHash_) {
+          curConfig_ = newConfig;
+          curConfigHash_ = newConfigHash;
+        }
 
         if (!newState) {
           // if config is not updated, the new state will return null
@@ -1788,6 +1874,14 @@ void SwSwitch::applyConfig(
     // TODO - figure out a way to send full agent config
     fsdbSyncer_->cfgUpdated(oldConfig, newConfig);
   }
+  restart_time::recordDuration(
+      "config_apply",
+      duration_cast<milliseconds>(steady_clock::now() - begin));
+}
+
+std::string SwSwitch::getConfigStr() const {
+  return apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+      curConfig_);
 }
 
 void SwSwitch::updateConfigAppliedInfo() {
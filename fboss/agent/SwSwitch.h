@@ -36,6 +36,7 @@
 #include <mutex>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -70,6 +71,7 @@ class LookupClassRouteUpdater;
 class MacTableManager;
 class ResolvedNexthopMonitor;
 class ResolvedNexthopProbeScheduler;
+class ResourceAccountant;
 class StaticL2ForNeighborObserver;
 class MKAServiceManager;
 template <typename AddressT>
@@ -440,6 +442,19 @@ class SwSwitch : public HwSwitch::Callback {
     return &lacpEventBase_;
   }
 
+  /*
+   * Get the EventBase over which LacpControllers for members of aggPortID
+   * should execute. Aggregate ports are sharded across
+   * --lacp_event_base_shards event bases, all members of an aggregate port
+   * land on the same one.
+   */
+  folly::EventBase* getLacpEvb(AggregatePortID aggPortID);
+
+  /*
+   * All the LACP EventBases, getLacpEvb() being the first one.
+   */
+  std::vector<folly::EventBase*> getLacpEvbs();
+
   /*
    * Get the EventBase for the update thread
    */
@@ -700,9 +715,8 @@ class SwSwitch : public HwSwitch::Callback {
    */
   bool getAndClearNeighborHit(RouterID vrf, folly::IPAddress ip);
 
-  const std::string& getConfigStr() const {
-    return curConfigStr_;
-  }
+  // JSON of the current config, serialized on demand
+  std::string getConfigStr() const;
   const cfg::SwitchConfig& getConfig() const {
     return curConfig_;
   }
@@ -841,8 +855,11 @@ class SwSwitch : public HwSwitch::Callback {
 
   void updateConfigAppliedInfo();
 
-  std::string curConfigStr_;
   cfg::SwitchConfig curConfig_;
+  // Content hash of curConfig_, to detect config changes cheaply
+  uint64_t curConfigHash_{0};
+  // Content hash of the agent config last written to the running config dump
+  std::optional<uint64_t> runningConfigDumpHash_;
 
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
@@ -914,6 +931,12 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<std::thread> lacpThread_;
   folly::EventBase lacpEventBase_;
   std::shared_ptr<ThreadHeartbeat> lacpThreadHeartbeat_;
+  /*
+   * Additional LACP threads, when --lacp_event_base_shards > 1.
+   */
+  std::vector<std::unique_ptr<std::thread>> lacpShardThreads_;
+  std::vector<std::unique_ptr<folly::EventBase>> lacpShardEventBases_;
+  std::vector<std::shared_ptr<ThreadHeartbeat>> lacpShardThreadHeartbeats_;
 
   /*
    * A thread dedicated to Arp and Ndp cache entry processing.
@@ -956,6 +979,9 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<LinkAggregationManager> lagManager_;
   std::unique_ptr<ResolvedNexthopMonitor> resolvedNexthopMonitor_;
   std::unique_ptr<ResolvedNexthopProbeScheduler> resolvedNexthopProbeScheduler_;
+  // Hardware table usage of the applied state, only touched by the update
+  // thread once initialized
+  std::unique_ptr<ResourceAccountant> resourceAccountant_;
   std::unique_ptr<RoutingInformationBase> rib_{nullptr};
 
   BootType bootType_{BootType::UNINITIALIZED};
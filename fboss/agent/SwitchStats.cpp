@@ -229,7 +229,14 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
       threadHeartbeatMissCount_(
           map,
           kCounterPrefix + "thread_heartbeat_miss",
-          SUM) {}
+          SUM),
+      macLearnUpdates_(map, kCounterPrefix + "mac.learn", SUM, RATE),
+      macAgeUpdates_(map, kCounterPrefix + "mac.age", SUM, RATE),
+      macUpdatesCoalesced_(
+          map,
+          kCounterPrefix + "mac.update_coalesced",
+          SUM,
+          RATE) {}
 
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
   auto it = ports_.find(portID);
@@ -362,6 +362,15 @@ class SwitchStats : public boost::noncopyable {
   void ThreadHeartbeatMissCount() {
     threadHeartbeatMissCount_.addValue(1);
   }
+  void macLearnUpdate() {
+    macLearnUpdates_.addValue(1);
+  }
+  void macAgeUpdate() {
+    macAgeUpdates_.addValue(1);
+  }
+  void macUpdateCoalesced() {
+    macUpdatesCoalesced_.addValue(1);
+  }
 
   typedef fb303::ThreadCachedServiceData::ThreadLocalStatsMap
       ThreadLocalStatsMap;
@@ -577,6 +586,13 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries pfcDeadlockRecoveryCount_;
   // Number of thread heartbeat misses
   TLTimeseries threadHeartbeatMissCount_;
+  // Number of L2 learn callbacks
+  TLTimeseries macLearnUpdates_;
+  // Number of L2 age callbacks
+  TLTimeseries macAgeUpdates_;
+  // Number of L2 callbacks superseded by a newer one for the same
+  // (VLAN, MAC) before being applied to the switch state
+  TLTimeseries macUpdatesCoalesced_;
 };
 
 } // namespace facebook::fboss
@@ -65,11 +65,18 @@
 #include <folly/io/IOBuf.h>
 #include <folly/json_pointer.h>
 #include <folly/logging/xlog.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Invoke.h>
+#endif
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
 #include <memory>
 
+#include <algorithm>
 #include <limits>
+#include <optional>
+#include <type_traits>
 
 using apache::thrift::ClientReceiveState;
 using apache::thrift::server::TConnectionContext;
@@ -103,6 +110,11 @@ DEFINE_bool(
     false,
     "Allow external mutations of running config");
 
+DEFINE_int32(
+    route_table_stream_chunk_size,
+    1000,
+    "Number of entries serialized at a time by the streaming route table APIs");
+
 namespace facebook::fboss {
 
 namespace util {
@@ -536,6 +548,279 @@ PortLoopbackMode toThriftLoopbackMode(cfg::PortLoopbackMode mode) {
   }
   throw FbossError("Bogus loopback mode: ", mode);
 }
+
+// Largest page served by the paginated route table APIs
+constexpr size_t kMaxRoutePageSize = 10000;
+
+// Number of entries serialized at a time by the streaming table APIs
+size_t getStreamChunkSize() {
+  return std::clamp<int64_t>(
+      FLAGS_route_table_stream_chunk_size, 1, kMaxRoutePageSize);
+}
+
+template <typename AddrT>
+UnicastRoute toUnicastRoute(const Route<AddrT>& route) {
+  UnicastRoute thriftRoute;
+  auto fwdInfo = route.getForwardInfo();
+  thriftRoute.dest()->ip() = toBinaryAddress(route.prefix().network);
+  thriftRoute.dest()->prefixLength() = route.prefix().mask;
+  thriftRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
+  thriftRoute.nextHops() =
+      util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
+  if (fwdInfo.getCounterID().has_value()) {
+    thriftRoute.counterID() = *fwdInfo.getCounterID();
+  }
+  return thriftRoute;
+}
+
+MplsRouteDetails toMplsRouteDetails(const LabelForwardingEntry& entry) {
+  MplsRouteDetails details;
+  details.topLabel() = entry.getID().value();
+  details.nextHopMulti() = entry.getEntryForClients().toThrift();
+  const auto& fwd = entry.getForwardInfo();
+  for (const auto& nh : fwd.getNextHopSet()) {
+    details.nextHops()->push_back(nh.toThrift());
+  }
+  *details.adminDistance() = fwd.getAdminDistance();
+  *details.action() = forwardActionStr(fwd.getAction());
+  return details;
+}
+
+folly::CIDRNetwork toCidrNetwork(const IpPrefix& prefix) {
+  auto addr = toIPAddress(*prefix.ip());
+  auto mask = *prefix.prefixLength();
+  if (mask < 0 || mask > addr.bitCount()) {
+    throw FbossError("Invalid prefix length ", mask, " for ", addr);
+  }
+  return folly::CIDRNetwork(addr.mask(mask), mask);
+}
+
+template <typename AddrT>
+std::optional<RoutePrefix<AddrT>> toRoutePrefixIf(
+    const folly::CIDRNetwork& prefix) {
+  constexpr bool kIsV6 = std::is_same_v<AddrT, IPAddressV6>;
+  if (prefix.first.isV6() != kIsV6) {
+    return std::nullopt;
+  }
+  if constexpr (kIsV6) {
+    return RoutePrefix<AddrT>{prefix.first.asV6(), prefix.second};
+  } else {
+    return RoutePrefix<AddrT>{prefix.first.asV4(), prefix.second};
+  }
+}
+
+/*
+ * Walk the routes of fib that are within `within` (if set) and after `after`
+ * (if set). The FIB is ordered by mask length first, so routes within a prefix
+ * are a contiguous range for each mask length, which we seek to rather than
+ * filtering the whole FIB. Returns false if func ended the walk.
+ */
+template <typename AddrT, typename Func>
+bool walkFib(
+    RouterID rid,
+    const ForwardingInformationBase<AddrT>& fib,
+    const std::optional<folly::CIDRNetwork>& within,
+    const std::optional<folly::CIDRNetwork>& after,
+    Func& func) {
+  std::optional<RoutePrefix<AddrT>> withinPfx;
+  std::optional<RoutePrefix<AddrT>> afterPfx;
+  if (within) {
+    withinPfx = toRoutePrefixIf<AddrT>(*within);
+    if (!withinPfx) {
+      return true;
+    }
+  }
+  if (after) {
+    afterPfx = toRoutePrefixIf<AddrT>(*after);
+    if (!afterPfx && after->first.isV4()) {
+      // v6 routes are walked first, so all of them precede a v4 cursor
+      return true;
+    }
+  }
+  const auto& routes = fib.getAllNodes();
+  auto start = [&](const RoutePrefix<AddrT>& from) {
+    return afterPfx && !(*afterPfx < from) ? routes.upper_bound(*afterPfx)
+                                           : routes.lower_bound(from);
+  };
+  if (!withinPfx) {
+    for (auto it = start(RoutePrefix<AddrT>{AddrT(), 0}); it != routes.end();
+         ++it) {
+      if (!func(rid, it->second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  for (size_t mask = withinPfx->mask; mask <= AddrT::bitCount(); ++mask) {
+    for (auto it = start(RoutePrefix<AddrT>{
+             withinPfx->network, static_cast<uint8_t>(mask)});
+         it != routes.end() && it->first.mask == mask &&
+         it->first.network.inSubnet(withinPfx->network, withinPfx->mask);
+         ++it) {
+      if (!func(rid, it->second)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/*
+ * Walk routes in forAllRoutes() order, i.e. by VRF, v6 before v4 and then by
+ * prefix, restricted to filter and starting after cursor if set. func returns
+ * false to end the walk.
+ */
+template <typename Func>
+void walkRouteTable(
+    const std::shared_ptr<SwitchState>& state,
+    const RouteTableFilter& filter,
+    const std::optional<RouteTableCursor>& cursor,
+    Func func) {
+  std::optional<folly::CIDRNetwork> within;
+  if (filter.prefix()) {
+    within = toCidrNetwork(*filter.prefix());
+  }
+  std::optional<folly::CIDRNetwork> cursorPrefix;
+  if (cursor) {
+    cursorPrefix = toCidrNetwork(*cursor->prefix());
+  }
+  for (const auto& fibContainer : *state->getFibs()) {
+    auto rid = fibContainer->getID();
+    if ((filter.vrf() && rid != RouterID(*filter.vrf())) ||
+        (cursor && rid < RouterID(*cursor->vrf()))) {
+      continue;
+    }
+    std::optional<folly::CIDRNetwork> after;
+    if (cursor && rid == RouterID(*cursor->vrf())) {
+      after = cursorPrefix;
+    }
+    if (!walkFib(rid, *fibContainer->getFibV6(), within, after, func) ||
+        !walkFib(rid, *fibContainer->getFibV4(), within, after, func)) {
+      return;
+    }
+  }
+}
+
+/*
+ * Fill page with up to request.limit routes, converted with toThrift. Routes
+ * for which toThrift returns nullopt are skipped.
+ */
+template <typename PageT, typename ToThriftFn>
+void fillRouteTablePage(
+    const std::shared_ptr<SwitchState>& state,
+    const RouteTablePageRequest& request,
+    PageT& page,
+    ToThriftFn toThrift) {
+  if (*request.limit() <= 0) {
+    throw FbossError(
+        "Route table page limit must be positive, got ", *request.limit());
+  }
+  auto limit = std::min(
+      static_cast<size_t>(*request.limit()), kMaxRoutePageSize);
+  std::optional<RouteTableCursor> cursor;
+  if (request.cursor()) {
+    cursor = *request.cursor();
+  }
+  RouteTableCursor last;
+  walkRouteTable(
+      state,
+      *request.filter(),
+      cursor,
+      [&](RouterID rid, const auto& route) {
+        auto thriftRoute = toThrift(*route);
+        if (!thriftRoute) {
+          return true;
+        }
+        if (page.routes()->size() == limit) {
+          page.nextCursor() = last;
+          return false;
+        }
+        page.routes()->push_back(std::move(*thriftRoute));
+        last.vrf() = static_cast<int32_t>(rid);
+        last.prefix() = getIpPrefix(*route);
+        return true;
+      });
+}
+
+/*
+ * Stream the entries returned by successive fetchChunk() calls, until it
+ * returns an empty chunk. With coroutines chunks are only fetched as the
+ * client consumes the stream, so at most one chunk is materialized at a time.
+ */
+template <typename T, typename FetchChunkFn>
+apache::thrift::ServerStream<T> streamInChunks(FetchChunkFn fetchChunk) {
+#if FOLLY_HAS_COROUTINES
+  return folly::coro::co_invoke(
+      [fetchChunk = std::move(fetchChunk)]() mutable
+      -> folly::coro::AsyncGenerator<T&&> {
+        while (true) {
+          auto chunk = fetchChunk();
+          if (chunk.empty()) {
+            co_return;
+          }
+          for (auto& entry : chunk) {
+            co_yield std::move(entry);
+          }
+        }
+      });
+#else
+  auto streamAndPublisher = apache::thrift::ServerStream<T>::createPublisher();
+  for (auto chunk = fetchChunk(); !chunk.empty(); chunk = fetchChunk()) {
+    for (auto& entry : chunk) {
+      streamAndPublisher.second.next(std::move(entry));
+    }
+  }
+  std::move(streamAndPublisher.second).complete();
+  return std::move(streamAndPublisher.first);
+#endif
+}
+
+/*
+ * Stream the route table of state, pinned for the lifetime of the stream,
+ * one page at a time.
+ */
+template <typename PageT, typename ToThriftFn>
+auto streamRouteTable(
+    std::shared_ptr<SwitchState> state,
+    const RouteTableFilter& filter,
+    ToThriftFn toThrift) {
+  using ThriftRouteT =
+      typename std::remove_reference_t<decltype(*PageT().routes())>::value_type;
+  RouteTablePageRequest request;
+  request.filter() = filter;
+  request.limit() = getStreamChunkSize();
+  return streamInChunks<ThriftRouteT>(
+      [state = std::move(state),
+       request = std::move(request),
+       toThrift = std::move(toThrift),
+       done = false]() mutable {
+        if (done) {
+          return std::vector<ThriftRouteT>();
+        }
+        PageT page;
+        fillRouteTablePage(state, request, page, toThrift);
+        if (page.nextCursor()) {
+          request.cursor() = *page.nextCursor();
+        } else {
+          done = true;
+        }
+        return std::move(*page.routes());
+      });
+}
+
+template <typename AddrT>
+std::optional<UnicastRoute> toResolvedUnicastRoute(const Route<AddrT>& route) {
+  if (!route.isResolved()) {
+    return std::nullopt;
+  }
+  return toUnicastRoute(route);
+}
+
+template <typename AddrT>
+std::optional<RouteDetails> toNormalizedRouteDetails(
+    const Route<AddrT>& route) {
+  return route.toRouteDetails(true);
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -1396,21 +1681,11 @@ void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   ensureConfigured(__func__);
   auto state = sw_->getState();
   forAllRoutes(state, [&routes](RouterID /*rid*/, const auto& route) {
-    UnicastRoute tempRoute;
     if (!route->isResolved()) {
       XLOG(INFO) << "Skipping unresolved route: " << route->toFollyDynamic();
       return;
     }
-    auto fwdInfo = route->getForwardInfo();
-    tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network);
-    tempRoute.dest()->prefixLength() = route->prefix().mask;
-    tempRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
-    tempRoute.nextHops() =
-        util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
-    if (fwdInfo.getCounterID().has_value()) {
-      tempRoute.counterID() = *fwdInfo.getCounterID();
-    }
-    routes.emplace_back(std::move(tempRoute));
+    routes.emplace_back(toUnicastRoute(*route));
   });
 }
 
@@ -1447,6 +1722,47 @@ void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   });
 }
 
+void ThriftHandler::getRouteTablePage(
+    UnicastRoutePage& page,
+    std::unique_ptr<RouteTablePageRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  fillRouteTablePage(sw_->getState(), *request, page, [](const auto& route) {
+    return toResolvedUnicastRoute(route);
+  });
+}
+
+void ThriftHandler::getRouteTableDetailsPage(
+    RouteDetailsPage& page,
+    std::unique_ptr<RouteTablePageRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  fillRouteTablePage(sw_->getState(), *request, page, [](const auto& route) {
+    return toNormalizedRouteDetails(route);
+  });
+}
+
+apache::thrift::ServerStream<UnicastRoute> ThriftHandler::getRouteTableStream(
+    std::unique_ptr<RouteTableFilter> filter) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRouteTable<UnicastRoutePage>(
+      sw_->getState(), *filter, [](const auto& route) {
+        return toResolvedUnicastRoute(route);
+      });
+}
+
+apache::thrift::ServerStream<RouteDetails>
+ThriftHandler::getRouteTableDetailsStream(
+    std::unique_ptr<RouteTableFilter> filter) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRouteTable<RouteDetailsPage>(
+      sw_->getState(), *filter, [](const auto& route) {
+        return toNormalizedRouteDetails(route);
+      });
+}
+
 void ThriftHandler::getIpRoute(
     UnicastRoute& route,
     std::unique_ptr<Address> addr,
@@ -1614,8 +1930,24 @@ void ThriftHandler::startPktCapture(unique_ptr<CaptureInfo> info) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
   auto* mgr = sw_->getCaptureMgr();
+  uint32_t snaplen = 0;
+  if (auto requestedSnaplen = info->snaplen()) {
+    if (*requestedSnaplen <= 0) {
+      throw FbossError(
+          "invalid snaplen ",
+          *requestedSnaplen,
+          " for capture \"",
+          *info->name(),
+          "\": must be positive");
+    }
+    snaplen = *requestedSnaplen;
+  }
   auto capture = make_unique<PktCapture>(
-      *info->name(), *info->maxPackets(), *info->direction(), *info->filter());
+      *info->name(),
+      *info->maxPackets(),
+      *info->direction(),
+      *info->filter(),
+      snaplen);
   mgr->startCapture(std::move(capture));
 }
 
@@ -2200,12 +2532,30 @@ void ThriftHandler::getAllMplsRouteDetails(
   ensureConfigured(__func__);
   const auto labelFib = sw_->getState()->getLabelForwardingInformationBase();
   for (const auto& entry : *labelFib) {
-    MplsRouteDetails details;
-    getMplsRouteDetails(details, entry->getID().label);
-    mplsRouteDetails.push_back(details);
+    mplsRouteDetails.push_back(toMplsRouteDetails(*entry));
   }
 }
 
+apache::thrift::ServerStream<MplsRouteDetails>
+ThriftHandler::getAllMplsRouteDetailsStream() {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamInChunks<MplsRouteDetails>(
+      [labelFib = sw_->getState()->getLabelForwardingInformationBase(),
+       after = std::optional<Label>()]() mutable {
+        const auto& entries = labelFib->getAllNodes();
+        auto chunkSize = getStreamChunkSize();
+        std::vector<MplsRouteDetails> chunk;
+        for (auto it = after ? entries.upper_bound(*after) : entries.begin();
+             it != entries.end() && chunk.size() < chunkSize;
+             ++it) {
+          chunk.push_back(toMplsRouteDetails(*it->second));
+          after = it->first;
+        }
+        return chunk;
+      });
+}
+
 void ThriftHandler::getMplsRouteDetails(
     MplsRouteDetails& mplsRouteDetail,
     MplsLabel topLabel) {
@@ -2214,14 +2564,7 @@ void ThriftHandler::getMplsRouteDetails(
   const auto entry = sw_->getState()
                          ->getLabelForwardingInformationBase()
                          ->getLabelForwardingEntry(topLabel);
-  mplsRouteDetail.topLabel() = entry->getID().value();
-  mplsRouteDetail.nextHopMulti() = entry->getEntryForClients().toThrift();
-  const auto& fwd = entry->getForwardInfo();
-  for (const auto& nh : fwd.getNextHopSet()) {
-    mplsRouteDetail.nextHops()->push_back(nh.toThrift());
-  }
-  *mplsRouteDetail.adminDistance() = fwd.getAdminDistance();
-  *mplsRouteDetail.action() = forwardActionStr(fwd.getAction());
+  mplsRouteDetail = toMplsRouteDetails(*entry);
 }
 
 void ThriftHandler::getHwDebugDump(std::string& out) {
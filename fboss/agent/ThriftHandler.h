@@ -114,6 +114,8 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
 
   void getAllMplsRouteDetails(
       std::vector<MplsRouteDetails>& mplsRouteDetails) override;
+  apache::thrift::ServerStream<MplsRouteDetails> getAllMplsRouteDetailsStream()
+      override;
 
   void getMplsRouteDetails(
       MplsRouteDetails& mplsRouteDetail,
@@ -165,6 +167,16 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+  void getRouteTablePage(
+      UnicastRoutePage& page,
+      std::unique_ptr<RouteTablePageRequest> request) override;
+  void getRouteTableDetailsPage(
+      RouteDetailsPage& page,
+      std::unique_ptr<RouteTablePageRequest> request) override;
+  apache::thrift::ServerStream<UnicastRoute> getRouteTableStream(
+      std::unique_ptr<RouteTableFilter> filter) override;
+  apache::thrift::ServerStream<RouteDetails> getRouteTableDetailsStream(
+      std::unique_ptr<RouteTableFilter> filter) override;
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
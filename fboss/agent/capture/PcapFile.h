@@ -32,7 +32,8 @@ class PcapFile {
 
   void close();
 
-  void writeGlobalHeader();
+  // A snaplen of 0 means packets are not truncated
+  void writeGlobalHeader(uint32_t snaplen = 0);
   void writePackets(const std::vector<PcapPkt>& pkt);
 
   // Move constructor and assignment operator
@@ -11,8 +11,24 @@
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
 
+#include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 
+namespace {
+
+// Shares the first snaplen bytes of src, or all of it if snaplen is 0
+void cloneUpTo(const folly::IOBuf* src, uint32_t snaplen, folly::IOBuf& dst) {
+  if (snaplen == 0 || src->computeChainDataLength() <= snaplen) {
+    src->cloneInto(dst);
+    return;
+  }
+  std::unique_ptr<folly::IOBuf> clone;
+  folly::io::Cursor(src).cloneAtMost(clone, snaplen);
+  dst = std::move(*clone);
+}
+
+} // namespace
+
 namespace facebook::fboss {
 
 PcapPkt::PcapPkt() {}
@@ -20,29 +36,31 @@ PcapPkt::PcapPkt() {}
 PcapPkt::PcapPkt(const RxPacket* pkt)
     : PcapPkt(pkt, std::chrono::system_clock::now()) {}
 
-PcapPkt::PcapPkt(const RxPacket* pkt, TimePoint timestamp)
+PcapPkt::PcapPkt(const RxPacket* pkt, TimePoint timestamp, uint32_t snaplen)
     : initialized_(true),
       rx_(true),
       port_(pkt->getSrcPort()),
       vlan_(pkt->getSrcVlan()),
       timestamp_(timestamp),
       buf_(),
+      origLength_(pkt->buf()->computeChainDataLength()),
       reasons_() {
-  pkt->buf()->cloneInto(buf_);
+  cloneUpTo(pkt->buf(), snaplen, buf_);
 }
 
 PcapPkt::PcapPkt(const TxPacket* pkt)
     : PcapPkt(pkt, std::chrono::system_clock::now()) {}
 
-PcapPkt::PcapPkt(const TxPacket* pkt, TimePoint timestamp)
+PcapPkt::PcapPkt(const TxPacket* pkt, TimePoint timestamp, uint32_t snaplen)
     : initialized_(true),
       rx_(false),
       port_(0),
       vlan_(0),
       timestamp_(timestamp),
       buf_(),
+      origLength_(pkt->buf()->computeChainDataLength()),
       reasons_() {
-  pkt->buf()->cloneInto(buf_);
+  cloneUpTo(pkt->buf(), snaplen, buf_);
 }
 
 PcapPkt::PcapPkt(const RxPacketData* pkt)
@@ -55,6 +73,7 @@ PcapPkt::PcapPkt(const RxPacketData* pkt, TimePoint timestamp)
       vlan_(pkt->srcVlan),
       timestamp_(timestamp),
       buf_(),
+      origLength_(pkt->packetData.size()),
       reasons_(std::move(pkt->reasons)) {
   buf_ = std::move(*folly::IOBuf::copyBuffer(
       pkt->packetData.data(), pkt->packetData.size()));
@@ -70,6 +89,7 @@ PcapPkt::PcapPkt(const TxPacketData* pkt, TimePoint timestamp)
       vlan_(0),
       timestamp_(timestamp),
       buf_(),
+      origLength_(pkt->packetData.size()),
       reasons_() {
   buf_ = std::move(*folly::IOBuf::copyBuffer(
       pkt->packetData.data(), pkt->packetData.size()));
@@ -63,15 +63,18 @@ class PcapPkt {
 
   /*
    * Create a PcapPkt from an RxPacket
+   *
+   * If snaplen is non-zero, only the first snaplen bytes of the packet are
+   * kept. The packet data is shared with the RxPacket, not copied.
    */
   explicit PcapPkt(const RxPacket* pkt);
-  PcapPkt(const RxPacket* pkt, TimePoint timestamp);
+  PcapPkt(const RxPacket* pkt, TimePoint timestamp, uint32_t snaplen = 0);
 
   /*
    * Create a PcapPkt from a TxPacket
    */
   explicit PcapPkt(const TxPacket* pkt);
-  PcapPkt(const TxPacket* pkt, TimePoint timestamp);
+  PcapPkt(const TxPacket* pkt, TimePoint timestamp, uint32_t snaplen = 0);
 
   /*
    * Create a PcapPkt from distribution service data
@@ -106,6 +109,10 @@ class PcapPkt {
   const folly::IOBuf* buf() const {
     return &buf_;
   }
+  // Length of the packet on the wire, buf() may be shorter than that
+  uint32_t origLength() const {
+    return origLength_;
+  }
   std::vector<RxReason> getReasons() {
     return reasons_;
   }
@@ -123,6 +130,7 @@ class PcapPkt {
     vlan_ = other.vlan_;
     timestamp_ = other.timestamp_;
     buf_ = std::move(other.buf_);
+    origLength_ = other.origLength_;
     reasons_ = std::move(other.reasons_);
     return *this;
   }
@@ -147,6 +155,7 @@ class PcapPkt {
   TimePoint timestamp_;
   // The packet contents, starting from the ethernet header.
   folly::IOBuf buf_;
+  uint32_t origLength_{0};
   // Reasons for sending packet to CPU
   std::vector<RxReason> reasons_;
 };
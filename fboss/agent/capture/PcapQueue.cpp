@@ -13,6 +13,10 @@
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/capture/PcapPkt.h"
 
+#include <gflags/gflags.h>
+
+#include <chrono>
+
 DEFINE_int32(
     fboss_pcap_queue_depth,
     10240,
@@ -20,100 +24,107 @@ DEFINE_int32(
     "to buffer in memory while waiting them to be written to the "
     "capture file");
 
+namespace {
+// How often a reader waiting for packets checks whether finish() was called
+constexpr std::chrono::milliseconds kFinishPollInterval{100};
+} // namespace
+
 namespace facebook::fboss {
 
-PcapQueue::PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity)
+PcapQueue::PcapQueue(
+    uint32_t pktCapacity,
+    uint64_t bytesCapacity,
+    uint32_t snaplen)
     : pktCapacity_(
           pktCapacity == 0 ? FLAGS_fboss_pcap_queue_depth : pktCapacity),
-      bytesCapacity_(bytesCapacity) {
-  queue_.reserve(pktCapacity_);
-}
+      bytesCapacity_(bytesCapacity),
+      snaplen_(snaplen),
+      queue_(pktCapacity_ + 1) {}
 
 PcapQueue::~PcapQueue() {}
 
 template <typename PktType>
 void PcapQueue::addPktInternal(const PktType* pkt) {
-  // Check to see if this would exceed the queue capacity.
-  if (queue_.size() >= pktCapacity_) {
-    pktsDropped_ += 1;
+  if (finished_.load(std::memory_order_acquire)) {
     return;
   }
-  auto newBytes = bytesInQueue_ + pkt->buf()->computeChainDataLength();
-  if (bytesCapacity_ > 0 && newBytes >= bytesCapacity_) {
-    pktsDropped_ += 1;
+  // Check to see if this would exceed the queue capacity.
+  if (queue_.sizeGuess() >= static_cast<ssize_t>(pktCapacity_)) {
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
-
-  queue_.emplace_back(pkt);
-}
-
-void PcapQueue::addPkt(const RxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
+  PcapPkt pcapPkt(pkt, std::chrono::system_clock::now(), snaplen_);
+  uint64_t len = 0;
+  if (bytesCapacity_ > 0) {
+    len = pcapPkt.buf()->computeChainDataLength();
+    if (bytesInQueue_.fetch_add(len, std::memory_order_relaxed) + len >=
+        bytesCapacity_) {
+      bytesInQueue_.fetch_sub(len, std::memory_order_relaxed);
+      pktsDropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  if (!queue_.write(std::move(pcapPkt))) {
+    bytesInQueue_.fetch_sub(len, std::memory_order_relaxed);
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
   }
-  cv_.notify_one();
 }
 
-void PcapQueue::addPktLocked(const RxPacket* pkt) {
+void PcapQueue::addPkt(const RxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::addPkt(const TxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
-}
-
-void PcapQueue::addPktLocked(const TxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::finish() {
-  std::lock_guard<std::mutex> guard(mutex_);
-  finished_ = true;
-  cv_.notify_all();
+  if (!finished_.exchange(true, std::memory_order_acq_rel)) {
+    // Never block, e.g. if the reader is gone or racing writers took every
+    // slot. Without the marker the reader notices finished_ when it polls.
+    queue_.write();
+  }
 }
 
 bool PcapQueue::isFinished() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return finished_;
+  return finished_.load(std::memory_order_acquire);
 }
 
 uint64_t PcapQueue::numDropped() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return pktsDropped_;
+  return pktsDropped_.load(std::memory_order_relaxed);
 }
 
 bool PcapQueue::wait(std::vector<PcapPkt>* swapQueue) {
   swapQueue->clear();
   swapQueue->reserve(pktCapacity_);
-
-  std::unique_lock<std::mutex> guard(mutex_);
-  while (queue_.empty() && !finished_) {
-    cv_.wait(guard);
-  }
-  if (queue_.empty()) {
-    DCHECK(finished_);
-    queue_.shrink_to_fit();
+  if (readerFinished_) {
     return false;
   }
 
-  swapQueue->swap(queue_);
-  bytesInQueue_ = 0;
-  return true;
+  PcapPkt pkt;
+  while (!queue_.tryReadUntil(
+      std::chrono::steady_clock::now() + kFinishPollInterval, pkt)) {
+    if (finished_.load(std::memory_order_acquire)) {
+      readerFinished_ = true;
+      return false;
+    }
+  }
+  while (true) {
+    if (!pkt.initialized()) {
+      // Queued by finish(), anything queued after it is dropped
+      readerFinished_ = true;
+      break;
+    }
+    if (bytesCapacity_ > 0) {
+      bytesInQueue_.fetch_sub(
+          pkt.buf()->computeChainDataLength(), std::memory_order_relaxed);
+    }
+    swapQueue->push_back(std::move(pkt));
+    if (swapQueue->size() >= pktCapacity_ || !queue_.read(pkt)) {
+      break;
+    }
+  }
+  return !swapQueue->empty();
 }
 
 } // namespace facebook::fboss
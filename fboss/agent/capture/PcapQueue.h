@@ -9,48 +9,48 @@
  */
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
+#include "fboss/agent/capture/PcapPkt.h"
+
+#include <folly/MPMCQueue.h>
+
+#include <atomic>
 #include <vector>
 
 namespace facebook::fboss {
 
 class RxPacket;
 class TxPacket;
-class PcapPkt;
 
 /*
  * PcapQueue stores a queue of PcapPkt objects, for transferring packets
  * from an asynchronous capture thread to a blocking thread that will process
  * the packets.  (For instance, writing them to disk using blocking I/O.)
  *
+ * Packets go through a lock free ring of pre-allocated slots, so the threads
+ * adding packets never contend on a lock with each other or with the reader.
+ * Queued packets share the data of the captured packet, truncated to snaplen
+ * bytes if a snaplen is given.
+ *
  * There can only be a single reader.
  */
 class PcapQueue {
  public:
-  explicit PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity = 0);
+  explicit PcapQueue(
+      uint32_t pktCapacity,
+      uint64_t bytesCapacity = 0,
+      uint32_t snaplen = 0);
   virtual ~PcapQueue();
 
   uint32_t getPktCapacity() const {
     // pktCapacity_ is const, so no need for locking
     return pktCapacity_;
   }
-
-  /*
-   * Get the mutex protecting this PcapQueue.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapQueue mutex.
-   */
-  std::mutex& mutex() const {
-    return mutex_;
+  uint32_t getSnaplen() const {
+    return snaplen_;
   }
 
   void addPkt(const RxPacket* pkt);
-  void addPktLocked(const RxPacket* pkt);
   void addPkt(const TxPacket* pkt);
-  void addPktLocked(const TxPacket* pkt);
 
   /*
    * finish() signals that no more packets will be added to the queue.
@@ -87,15 +87,17 @@ class PcapQueue {
   template <typename PktType>
   void addPktInternal(const PktType* pkt);
 
-  mutable std::mutex mutex_;
-  std::condition_variable cv_;
-
-  bool finished_{false};
   const uint32_t pktCapacity_{0};
-  uint64_t bytesCapacity_{0};
-  uint64_t bytesInQueue_{0};
-  uint64_t pktsDropped_{0};
-  std::vector<PcapPkt> queue_;
+  const uint64_t bytesCapacity_{0};
+  const uint32_t snaplen_{0};
+  std::atomic<bool> finished_{false};
+  std::atomic<uint64_t> bytesInQueue_{0};
+  std::atomic<uint64_t> pktsDropped_{0};
+  // finish() queues an uninitialized PcapPkt to wake up the reader, in a slot
+  // of its own unless racing writers took it
+  folly::MPMCQueue<PcapPkt> queue_;
+  // Only used by the reader
+  bool readerFinished_{false};
 };
 
 } // namespace facebook::fboss
@@ -18,14 +18,16 @@ using folly::StringPiece;
 
 namespace facebook::fboss {
 
-PcapWriter::PcapWriter(uint32_t maxBufferedPkts) : queue_(maxBufferedPkts) {}
+PcapWriter::PcapWriter(uint32_t maxBufferedPkts, uint32_t snaplen)
+    : queue_(maxBufferedPkts, 0, snaplen) {}
 
 PcapWriter::PcapWriter(
     StringPiece path,
     bool overwriteExisting,
-    uint32_t maxBufferedPkts)
+    uint32_t maxBufferedPkts,
+    uint32_t snaplen)
     : file_(path, overwriteExisting),
-      queue_(maxBufferedPkts),
+      queue_(maxBufferedPkts, 0, snaplen),
       thread_(&PcapWriter::threadMain, this) {}
 
 PcapWriter::~PcapWriter() {
@@ -60,7 +62,7 @@ void PcapWriter::finish() {
 
 void PcapWriter::threadMain() {
   try {
-    file_.writeGlobalHeader();
+    file_.writeGlobalHeader(queue_.getSnaplen());
     writeLoop();
     file_.close();
   } catch (const std::exception& ex) {
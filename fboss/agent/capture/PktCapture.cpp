@@ -9,7 +9,11 @@
  */
 #include "fboss/agent/capture/PktCapture.h"
 
+#include "fboss/agent/packet/Ethertype.h"
+
 #include <folly/Conv.h>
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
 #include <folly/logging/xlog.h>
 #include <sstream>
 
@@ -17,6 +21,34 @@ using folly::StringPiece;
 
 namespace facebook::fboss {
 
+bool PacketFilter::passesEtherType(const folly::IOBuf* buf) const {
+  if (etherTypes_.empty()) {
+    return true;
+  }
+  folly::io::Cursor cursor(buf);
+  // Skip the destination and source MACs
+  if (!cursor.canAdvance(2 * folly::MacAddress::SIZE)) {
+    return false;
+  }
+  cursor.skip(2 * folly::MacAddress::SIZE);
+  uint16_t etherType;
+  if (!cursor.tryReadBE(etherType)) {
+    return false;
+  }
+  while (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN) ||
+         etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_QINQ)) {
+    // Skip the VLAN tag control info
+    if (!cursor.canAdvance(2)) {
+      return false;
+    }
+    cursor.skip(2);
+    if (!cursor.tryReadBE(etherType)) {
+      return false;
+    }
+  }
+  return etherTypes_.find(etherType) != etherTypes_.end();
+}
+
 PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
@@ -27,8 +59,10 @@ PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
     CaptureDirection direction,
-    const CaptureFilter& captureFilter)
+    const CaptureFilter& captureFilter,
+    uint32_t snaplen)
     : name_(name.str()),
+      writer_(0 /* maxBufferedPkts */, snaplen),
       maxPackets_(maxPackets),
       direction_(direction),
       packetFilter_(captureFilter) {}
@@ -43,23 +77,34 @@ void PktCapture::stop() {
   XLOG(INFO) << "Stopped packet capture " << toString(true);
 }
 
+template <typename PktType>
+bool PktCapture::capturePacket(
+    const PktType* pkt,
+    std::atomic<uint64_t>& numPackets) {
+  if (!packetFilter_.passes(pkt)) {
+    return numPacketsTaken_.load(std::memory_order_relaxed) < maxPackets_;
+  }
+  auto taken = numPacketsTaken_.fetch_add(1, std::memory_order_relaxed);
+  if (taken >= maxPackets_) {
+    return false;
+  }
+  numPackets.fetch_add(1, std::memory_order_relaxed);
+  writer_.addPkt(pkt);
+  return taken + 1 < maxPackets_;
+}
+
 bool PktCapture::packetReceived(const RxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_TX &&
-      true == packetFilter_.passes(pkt)) {
-    ++numPacketsReceived_;
-    writer_.addPktLocked(pkt);
+  if (direction_ == CaptureDirection::CAPTURE_ONLY_TX) {
+    return numPacketsTaken_.load(std::memory_order_relaxed) < maxPackets_;
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return capturePacket(pkt, numPacketsReceived_);
 }
 
 bool PktCapture::packetSent(const TxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX) {
-    ++numPacketsSent_;
-    writer_.addPktLocked(pkt);
+  if (direction_ == CaptureDirection::CAPTURE_ONLY_RX) {
+    return numPacketsTaken_.load(std::memory_order_relaxed) < maxPackets_;
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return capturePacket(pkt, numPacketsSent_);
 }
 
 std::string PktCapture::toString(bool withStats) const {
@@ -70,14 +115,14 @@ std::string PktCapture::toString(bool withStats) const {
              : ((direction_ == CaptureDirection::CAPTURE_ONLY_RX) ? "RX only"
                                                                   : "TX only"));
   if (withStats) {
-    ss << ", Packet received:" << numPacketsReceived_
-       << ", Packet sent:" << numPacketsSent_;
+    ss << ", Packet received:" << numPacketsReceived_.load()
+       << ", Packet sent:" << numPacketsSent_.load();
   }
   return ss.str();
 }
 
 int PktCapture::getCaptureCount() {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  return (numPacketsSent_ + numPacketsReceived_);
+  return numPacketsSent_.load(std::memory_order_relaxed) +
+      numPacketsReceived_.load(std::memory_order_relaxed);
 }
 } // namespace facebook::fboss
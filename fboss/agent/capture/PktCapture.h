@@ -14,40 +14,61 @@
 
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
+#include <folly/io/IOBuf.h>
+#include <atomic>
 #include <string>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
 
 namespace facebook::fboss {
 
+/*
+ * Filters are built once from the capture filter config, into sets that are
+ * cheap to look packets up in. An empty set matches any packet.
+ */
 class RxPacketFilter {
  public:
   explicit RxPacketFilter(const RxCaptureFilter& rxCaptureFilter)
       : cosQueues_(
             rxCaptureFilter.get_cosQueues().begin(),
-            rxCaptureFilter.get_cosQueues().end()) {}
+            rxCaptureFilter.get_cosQueues().end()),
+        srcPorts_(
+            rxCaptureFilter.get_srcPorts().begin(),
+            rxCaptureFilter.get_srcPorts().end()) {}
   bool passes(const RxPacket* pkt) const {
     return (
-        cosQueues_.empty() ||
-        cosQueues_.find(static_cast<CpuCosQueueId>(pkt->cosQueue())) !=
-            cosQueues_.end());
+        (cosQueues_.empty() ||
+         cosQueues_.find(static_cast<CpuCosQueueId>(pkt->cosQueue())) !=
+             cosQueues_.end()) &&
+        (srcPorts_.empty() ||
+         srcPorts_.find(pkt->getSrcPort()) != srcPorts_.end()));
   }
 
  private:
   boost::container::flat_set<CpuCosQueueId> cosQueues_;
+  boost::container::flat_set<PortID> srcPorts_;
 };
 
 class PacketFilter {
  public:
   explicit PacketFilter(const CaptureFilter& captureFilter)
-      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()) {}
+      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()),
+        etherTypes_(
+            captureFilter.get_etherTypes().begin(),
+            captureFilter.get_etherTypes().end()) {}
 
-  bool passes(const RxPacket* pkt) {
-    return rxPacketFilter_.passes(pkt);
+  bool passes(const RxPacket* pkt) const {
+    return rxPacketFilter_.passes(pkt) && passesEtherType(pkt->buf());
+  }
+  bool passes(const TxPacket* pkt) const {
+    return passesEtherType(pkt->buf());
   }
 
  private:
+  bool passesEtherType(const folly::IOBuf* buf) const;
+
   RxPacketFilter rxPacketFilter_;
+  boost::container::flat_set<uint16_t> etherTypes_;
 };
 
 /*
@@ -63,7 +84,8 @@ class PktCapture {
       folly::StringPiece name,
       uint64_t maxPackets,
       CaptureDirection direction,
-      const CaptureFilter& captureFilter);
+      const CaptureFilter& captureFilter,
+      uint32_t snaplen = 0);
 
   const std::string& name() const {
     return name_;
@@ -72,6 +94,12 @@ class PktCapture {
   void start(folly::StringPiece path);
   void stop();
 
+  /*
+   * Capture a packet if it matches the filter.
+   *
+   * Returns false once maxPackets packets were captured. These methods are
+   * safe to call from any thread, and never block.
+   */
   bool packetReceived(const RxPacket* pkt);
   bool packetSent(const TxPacket* pkt);
   int getCaptureCount();
@@ -83,14 +111,18 @@ class PktCapture {
   PktCapture(PktCapture const&) = delete;
   PktCapture& operator=(PktCapture const&) = delete;
 
+  template <typename PktType>
+  bool capturePacket(const PktType* pkt, std::atomic<uint64_t>& numPackets);
+
   const std::string name_;
 
-  // Note: the rest of the state in this class is protcted by
-  // the PcapWriter's mutex.
   PcapWriter writer_;
   uint64_t maxPackets_{0};
-  uint64_t numPacketsReceived_{0};
-  uint64_t numPacketsSent_{0};
+  // Packets captured, or about to be. Can go past maxPackets_ as packets
+  // beyond it are not captured.
+  std::atomic<uint64_t> numPacketsTaken_{0};
+  std::atomic<uint64_t> numPacketsReceived_{0};
+  std::atomic<uint64_t> numPacketsSent_{0};
   CaptureDirection direction_{CaptureDirection::CAPTURE_TX_RX};
   PacketFilter packetFilter_;
 };
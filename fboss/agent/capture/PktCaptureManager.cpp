@@ -16,6 +16,10 @@
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
 using folly::StringPiece;
 using std::string;
 using std::unique_ptr;
@@ -56,7 +60,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
   auto path =
       folly::to<std::string>(captureDir_, "/", capture->name(), ".pcap");
 
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   const auto& name = capture->name();
   if (activeCaptures_.find(name) != activeCaptures_.end()) {
@@ -69,7 +73,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
 }
 
 void PktCaptureManager::stopCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
@@ -82,12 +86,13 @@ void PktCaptureManager::stopCapture(StringPiece name) {
   capturesRunning_.store(!activeCaptures_.empty(), std::memory_order_release);
 }
 
-unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+std::shared_ptr<PktCapture> PktCaptureManager::forgetCapture(
+    StringPiece name) {
+  std::lock_guard<folly::SharedMutex> g(mutex_);
   auto nameStr = name.str();
   auto activeIt = activeCaptures_.find(nameStr);
   if (activeIt != activeCaptures_.end()) {
-    std::unique_ptr<PktCapture> capture = std::move(activeIt->second);
+    auto capture = std::move(activeIt->second);
     activeCaptures_.erase(activeIt);
     capturesRunning_.store(!activeCaptures_.empty(), std::memory_order_release);
     capture->stop();
@@ -96,7 +101,7 @@ unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
 
   auto inactiveIt = inactiveCaptures_.find(nameStr);
   if (inactiveIt != inactiveCaptures_.end()) {
-    std::unique_ptr<PktCapture> capture = std::move(inactiveIt->second);
+    auto capture = std::move(inactiveIt->second);
     inactiveCaptures_.erase(inactiveIt);
     return capture;
   }
@@ -105,49 +110,69 @@ unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
 }
 
 void PktCaptureManager::stopAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   // FIXME
 }
 
 void PktCaptureManager::forgetAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
   // FIXME
 }
 
 template <typename Fn>
 void PktCaptureManager::invokeCaptures(const Fn& fn) {
-  std::lock_guard<std::mutex> g(mutex_);
+  // Finished captures are held until deactivated, so none of them can be
+  // freed, and its address reused by a new capture, in the meantime
+  std::vector<std::shared_ptr<PktCapture>> finishedCaptures;
+  {
+    std::shared_lock<folly::SharedMutex> g(mutex_);
+    for (const auto& entry : activeCaptures_) {
+      PktCapture* capture = entry.second.get();
+      bool stillActive = false;
+      try {
+        stillActive = fn(capture);
+      } catch (const std::exception& ex) {
+        XLOG(ERR) << "error when processing packet for capture "
+                  << capture->name() << " : " << folly::exceptionStr(ex);
+        stillActive = false;
+      }
+      if (!stillActive) {
+        finishedCaptures.push_back(entry.second);
+      }
+    }
+  }
+  if (!finishedCaptures.empty()) {
+    deactivateCaptures(finishedCaptures);
+  }
+}
+
+void PktCaptureManager::deactivateCaptures(
+    const std::vector<std::shared_ptr<PktCapture>>& captures) {
+  std::lock_guard<folly::SharedMutex> g(mutex_);
 
+  // Another thread may have deactivated or forgotten some of these captures
+  // since, so only look at the ones still active.
   for (auto it = activeCaptures_.begin(); it != activeCaptures_.end();
        /* increment in loop */) {
-    // Increment the iterator now, in case this capture deactivates itself and
-    // we need to remove it from the active captures.
     auto thisIt = it;
     ++it;
     PktCapture* capture = thisIt->second.get();
-    bool stillActive = false;
+    if (std::find(captures.begin(), captures.end(), thisIt->second) ==
+        captures.end()) {
+      continue;
+    }
+    XLOG(INFO) << "auto-stopping packet capture \"" << capture->name()
+               << "\"";
     try {
-      stillActive = fn(capture);
+      inactiveCaptures_[capture->name()] = std::move(thisIt->second);
     } catch (const std::exception& ex) {
-      XLOG(ERR) << "error when processing packet for capture "
-                << capture->name() << " : " << folly::exceptionStr(ex);
-      stillActive = false;
-    }
-
-    if (!stillActive) {
-      XLOG(INFO) << "auto-stopping packet capture \"" << capture->name()
-                 << "\"";
-      try {
-        inactiveCaptures_[capture->name()] = std::move(thisIt->second);
-      } catch (const std::exception& ex) {
-        XLOG(ERR) << "error adding capture " << capture->name()
-                  << " to the inactive list";
-        // Can't do much else here.  Just continue and forget the capture.
-      }
-      activeCaptures_.erase(thisIt);
+      XLOG(ERR) << "error adding capture " << capture->name()
+                << " to the inactive list";
+      // Can't do much else here.  Just continue and forget the capture.
     }
+    activeCaptures_.erase(thisIt);
   }
 
   bool running = !activeCaptures_.empty();
@@ -177,7 +202,7 @@ void PktCaptureManager::checkCaptureName(folly::StringPiece name) {
 // routine as used in tests to verify if the pkt capture buffer
 // limit has been reached
 int PktCaptureManager::getCaptureCount(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::shared_lock<folly::SharedMutex> g(mutex_);
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
   if (it == activeCaptures_.end()) {
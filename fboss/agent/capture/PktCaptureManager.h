@@ -10,12 +10,13 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <folly/SharedMutex.h>
 
 #include <atomic>
 #include <map>
 #include <memory>
-#include <mutex>
 #include <string>
+#include <vector>
 #include "fboss/agent/PacketObserver.h"
 
 namespace facebook::fboss {
@@ -39,7 +40,7 @@ class PktCaptureManager : public PacketObserverIf {
   void startCapture(std::unique_ptr<PktCapture> capture);
 
   void stopCapture(folly::StringPiece name);
-  std::unique_ptr<PktCapture> forgetCapture(folly::StringPiece name);
+  std::shared_ptr<PktCapture> forgetCapture(folly::StringPiece name);
 
   void stopAllCaptures();
   void forgetAllCaptures();
@@ -75,15 +76,22 @@ class PktCaptureManager : public PacketObserverIf {
 
   template <typename Fn>
   void invokeCaptures(const Fn& fn);
+  void deactivateCaptures(
+      const std::vector<std::shared_ptr<PktCapture>>& captures);
   void packetReceivedImpl(const RxPacket* pkt);
   void packetSentImpl(const TxPacket* pkt);
 
   std::atomic<bool> capturesRunning_{false};
 
-  std::mutex mutex_;
+  /*
+   * Packets are handed to the active captures holding mutex_ shared, so rx
+   * and tx threads don't serialize on it. Changes to the captures hold it
+   * exclusively.
+   */
+  folly::SharedMutex mutex_;
   std::string captureDir_;
-  std::map<std::string, std::unique_ptr<PktCapture>> activeCaptures_;
-  std::map<std::string, std::unique_ptr<PktCapture>> inactiveCaptures_;
+  std::map<std::string, std::shared_ptr<PktCapture>> activeCaptures_;
+  std::map<std::string, std::shared_ptr<PktCapture>> inactiveCaptures_;
   PacketObservers* observer_{nullptr};
 };
 
@@ -21,7 +21,9 @@
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Format.h>
 #include <folly/Memory.h>
+#include <folly/testing/TestUtil.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -269,3 +271,43 @@ TEST(CaptureTest, FullCapture) {
   //
   // EXPECT_BUF_EQ(updatedIpPktData, pcapPkts.at(4).data);
 }
+
+TEST(CaptureTest, FilteredCapture) {
+  folly::test::TemporaryDirectory tmpDir;
+  PacketObservers observers;
+  PktCaptureManager mgr(tmpDir.path().string(), &observers);
+
+  // Only capture ARP received on port 3
+  CaptureFilter filter;
+  filter.rxCaptureFilter()->srcPorts() = {3};
+  filter.etherTypes() = {0x0806};
+  mgr.startCapture(make_unique<PktCapture>(
+      "arp", 100, CaptureDirection::CAPTURE_ONLY_RX, filter, 32));
+
+  auto makePkt = [](uint16_t etherType, PortID port) {
+    auto pkt = MockRxPacket::fromHex(folly::to<string>(
+        // dst mac, src mac
+        "02 00 01 00 00 01  02 00 02 01 02 03"
+        // 802.1q, VLAN 1
+        "81 00 00 01",
+        folly::sformat("{:04x}", etherType)));
+    pkt->padToLength(68);
+    pkt->setSrcPort(port);
+    pkt->setSrcVlan(VlanID(1));
+    return pkt;
+  };
+  mgr.packetReceived(makePkt(0x0806, PortID(3)).get());
+  mgr.packetReceived(makePkt(0x0800, PortID(3)).get());
+  mgr.packetReceived(makePkt(0x0806, PortID(4)).get());
+  mgr.packetReceived(makePkt(0x0806, PortID(3)).get());
+  EXPECT_EQ(mgr.getCaptureCount("arp"), 2);
+  mgr.stopCapture("arp");
+
+  auto pcapPkts = readPcapFile(
+      folly::to<string>(mgr.getCaptureDir(), "/arp.pcap").c_str());
+  ASSERT_EQ(2, pcapPkts.size());
+  for (const auto& pktInfo : pcapPkts) {
+    EXPECT_EQ(68, pktInfo.hdr.len);
+    EXPECT_EQ(32, pktInfo.hdr.caplen);
+  }
+}
@@ -71,3 +71,22 @@ TEST(PcapQueueTest, SimpleAdd) {
   ByteRange waitedPktData = waitedPktBufClone->coalesce();
   EXPECT_EQ(expectedPktData, waitedPktData);
 }
+
+TEST(PcapQueueTest, FinishFullQueueWithoutReader) {
+  PcapQueue queue(2);
+  auto pkt = MockRxPacket::fromHex("02 00 01 00 00 01  02 00 02 01 02 03");
+  for (int i = 0; i < 4; ++i) {
+    queue.addPkt(pkt.get());
+  }
+  EXPECT_EQ(2, queue.numDropped());
+  // Nobody reads, finish() must still return, even twice
+  queue.finish();
+  queue.finish();
+  EXPECT_TRUE(queue.isFinished());
+
+  // A reader started later gets the queued packets, then sees the end
+  std::vector<PcapPkt> waitedPkts;
+  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
+  waiter.join();
+  EXPECT_EQ(2, waitedPkts.size());
+}
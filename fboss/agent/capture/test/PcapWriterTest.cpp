@@ -101,3 +101,26 @@ TEST(PcapWriterTest, Drop) {
     EXPECT_EQ(68, pktInfo.hdr.caplen);
   }
 }
+
+TEST(PcapWriterTest, Snaplen) {
+  char tmpPath[] = "fbossPcapTest.XXXXXX";
+  int tmpFD = mkstemp(tmpPath);
+  folly::checkUnixError(tmpFD, "failed to create temporary file");
+  SCOPE_EXIT {
+    close(tmpFD);
+    unlink(tmpPath);
+  };
+
+  PcapWriter writer(tmpPath, true, 0, 32);
+  addPackets(&writer, 10);
+  writer.finish();
+  EXPECT_EQ(0, writer.numDropped());
+
+  auto pcapPkts = readPcapFile(tmpPath);
+  EXPECT_EQ(10, pcapPkts.size());
+  for (const auto& pktInfo : pcapPkts) {
+    EXPECT_EQ(68, pktInfo.hdr.len);
+    EXPECT_EQ(32, pktInfo.hdr.caplen);
+    EXPECT_EQ(32, pktInfo.data.size());
+  }
+}
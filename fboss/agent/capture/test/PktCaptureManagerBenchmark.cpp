@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/PacketObserver.h"
+#include "fboss/agent/capture/PktCapture.h"
+#include "fboss/agent/capture/PktCaptureManager.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/testing/TestUtil.h>
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+/*
+ * Drives received packets through PktCaptureManager while a capture is
+ * running, from one or more rx threads, as the SwSwitch rx path does.
+ */
+namespace {
+
+std::unique_ptr<MockRxPacket> makePacket() {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00 00 01"
+      // IPv4
+      "08 00"
+      // Version(4), IHL(5), DSCP(0), ECN(0), Total Length(20)
+      "45  00  00 14"
+      // Identification(0), Flags(0), Fragment offset(0)
+      "00 00  00 00"
+      // TTL(31), Protocol(6), Checksum (0, fake)
+      "1F  06  00 00"
+      // Source IP (1.2.3.4)
+      "01 02 03 04"
+      // Destination IP (10.0.0.10)
+      "0a 00 00 0a");
+  pkt->padToLength(1500);
+  pkt->setSrcPort(PortID(1));
+  pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+void captureRxPackets(
+    size_t iters,
+    int numThreads,
+    const CaptureFilter& filter,
+    uint32_t snaplen) {
+  folly::BenchmarkSuspender suspender;
+  folly::test::TemporaryDirectory tmpDir;
+  PacketObservers observers;
+  PktCaptureManager mgr(tmpDir.path().string(), &observers);
+  mgr.startCapture(std::make_unique<PktCapture>(
+      "bench",
+      std::numeric_limits<uint64_t>::max(),
+      CaptureDirection::CAPTURE_ONLY_RX,
+      filter,
+      snaplen));
+  auto pkt = makePacket();
+
+  suspender.dismiss();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t iter = 0; iter < iters / numThreads; ++iter) {
+        mgr.packetReceived(pkt.get());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  suspender.rehire();
+  mgr.stopCapture("bench");
+}
+
+void captureAll(size_t iters, int numThreads) {
+  captureRxPackets(iters, numThreads, CaptureFilter(), 0);
+}
+
+void captureSnaplen(size_t iters, int numThreads) {
+  captureRxPackets(iters, numThreads, CaptureFilter(), 128);
+}
+
+void captureFilteredOut(size_t iters, int numThreads) {
+  CaptureFilter filter;
+  // ARP only
+  filter.etherTypes() = {0x0806};
+  captureRxPackets(iters, numThreads, filter, 0);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(captureAll, 1);
+BENCHMARK_PARAM(captureAll, 4);
+BENCHMARK_PARAM(captureSnaplen, 1);
+BENCHMARK_PARAM(captureSnaplen, 4);
+BENCHMARK_PARAM(captureFilteredOut, 1);
+BENCHMARK_PARAM(captureFilteredOut, 4);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/hw/bcm/BcmSflowExporter.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -16,8 +17,11 @@
 #include <fcntl.h>
 #include <ifaddrs.h>
 
+#include <fb303/ServiceData.h>
 #include <folly/Range.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <optional>
 
@@ -27,7 +31,36 @@
 
 using namespace std;
 
+DEFINE_int32(
+    sflow_export_queue_size,
+    8192,
+    "Number of sFlow samples that can be queued for export, "
+    "further samples are dropped");
+DEFINE_int32(
+    sflow_export_max_samples_per_datagram,
+    1,
+    "Max number of serialized sFlow samples packed back to back in one "
+    "datagram. Collectors must read samples until the end of the datagram "
+    "if this is more than 1");
+DEFINE_int32(
+    sflow_export_mtu,
+    1500,
+    "MTU towards sFlow collectors, datagrams are not packed beyond it");
+DEFINE_int32(
+    sflow_export_flush_interval_us,
+    1000,
+    "Max time an sFlow sample is held back to be sent with other samples");
+
 namespace {
+constexpr auto kSflowExportDropped = "sflow_export.dropped";
+constexpr auto kSflowExportSendFailed = "sflow_export.send_failed";
+// Time from a sample being queued to it being sent
+constexpr auto kSflowExportLatency = "sflow_export.latency.us";
+// IPv6 and UDP headers
+constexpr int kUdpOverhead = 48;
+// Wake up at least this often to check for shutdown
+constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
 std::optional<folly::IPAddress> getLocalIPv6FromWhoAmI() {
   const std::string whoAmIFn = "/etc/fbwhoami";
   const std::string key = "DEVICE_PRIMARY_IPV6";
@@ -165,28 +198,37 @@ BcmSflowExporter::BcmSflowExporter(const folly::SocketAddress& address)
   }
 }
 
-ssize_t BcmSflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
-  XLOG(DBG4) << "Sending an sFlow packet to " << address_.describe();
+size_t BcmSflowExporter::sendUDPDatagrams(std::vector<iovec>& datagrams) {
+  XLOG(DBG4) << "Sending " << datagrams.size() << " sFlow packets to "
+             << address_.describe();
 
   sockaddr_storage addrStorage;
   address_.getAddress(&addrStorage);
 
-  struct msghdr msg = {};
-  msg.msg_name = reinterpret_cast<void*>(&addrStorage);
-  msg.msg_namelen = address_.getActualSize();
-  msg.msg_iov = vec;
-  msg.msg_iovlen = iovec_len;
-  msg.msg_control = nullptr;
-  msg.msg_controllen = 0;
-  msg.msg_flags = 0;
-  auto ret = ::sendmsg(socket_, &msg, 0);
-  if (ret < 0) {
-    XLOG(DBG1) << "Failed sending sFlow packet to " << address_.describe()
-               << " reason: " << folly::errnoStr(errno);
+  std::vector<mmsghdr> msgs(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    auto& msg = msgs[i].msg_hdr;
+    msg.msg_name = reinterpret_cast<void*>(&addrStorage);
+    msg.msg_namelen = address_.getActualSize();
+    msg.msg_iov = &datagrams[i];
+    msg.msg_iovlen = 1;
   }
-  XLOG(DBG4) << "Sent " << ret << " bytes of sFlow packet to "
-             << address_.describe();
-  return ret;
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    auto ret = ::sendmmsg(socket_, msgs.data() + sent, msgs.size() - sent, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      XLOG(DBG1) << "Failed sending " << msgs.size() - sent
+                 << " sFlow packets to " << address_.describe()
+                 << " reason: " << folly::errnoStr(errno);
+      break;
+    }
+    sent += ret;
+  }
+  XLOG(DBG4) << "Sent " << sent << " sFlow packets to " << address_.describe();
+  return sent;
 }
 
 BcmSflowExporter::~BcmSflowExporter() {
@@ -195,20 +237,42 @@ BcmSflowExporter::~BcmSflowExporter() {
   }
 }
 
+BcmSflowExporterTable::BcmSflowExporterTable()
+    : queue_(FLAGS_sflow_export_queue_size) {
+  fb303::fbData->addHistogram(kSflowExportLatency, 100, 0, 10000);
+  fb303::fbData->exportHistogramPercentile(kSflowExportLatency, 50, 95, 99);
+}
+
+BcmSflowExporterTable::~BcmSflowExporterTable() {
+  if (exportThread_) {
+    stop_.store(true, std::memory_order_release);
+    exportThread_->join();
+  }
+}
+
 bool BcmSflowExporterTable::contains(
     const shared_ptr<SflowCollector>& c) const {
-  auto iter = map_.find(c->getID());
-  return iter != map_.end();
+  auto exporters = map_.rlock();
+  return exporters->find(c->getID()) != exporters->end();
 }
 
 size_t BcmSflowExporterTable::size() const {
-  return map_.size();
+  return map_.rlock()->size();
 }
 
 void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
   try {
     auto exporter = make_unique<BcmSflowExporter>(c->getAddress());
-    map_.emplace(c->getID(), move(exporter));
+    auto exporters = map_.wlock();
+    exporters->emplace(c->getID(), move(exporter));
+    numExporters_.store(exporters->size(), std::memory_order_relaxed);
+    // Switches without sFlow collectors don't need an export thread
+    if (!exportThread_) {
+      exportThread_ = std::make_unique<std::thread>([this]() {
+        folly::setThreadName("SflowExport");
+        exportSamples();
+      });
+    }
   } catch (const fboss::thrift::FbossBaseError& ex) {
     XLOG(ERR) << "Could not add exporter: "
               << c->getAddress().getFullyQualified()
@@ -222,7 +286,9 @@ void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
 
 void BcmSflowExporterTable::removeExporter(const std::string& id) {
   XLOG(INFO) << "Removed sFlow exporter " << id;
-  map_.erase(id);
+  auto exporters = map_.wlock();
+  exporters->erase(id);
+  numExporters_.store(exporters->size(), std::memory_order_relaxed);
 }
 
 void BcmSflowExporterTable::updateSamplingRates(
@@ -241,31 +307,100 @@ void BcmSflowExporterTable::updateSamplingRates(
   localIP_ = getLocalIPv6();
 }
 
-void BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
-  if (map_.empty()) {
+void BcmSflowExporterTable::sendToAll(SflowPacketInfo info) {
+  if (numExporters_.load(std::memory_order_relaxed) == 0) {
     XLOG(DBG1)
         << "zero sFlow collectors with sflow enabled, skipping sample export";
     return;
   }
-  // Serialize info to a string and wrap it in an IOBuf for sending
+  if (!queue_.write(
+          QueuedSample{std::chrono::steady_clock::now(), move(info)})) {
+    fb303::fbData->incrementCounter(kSflowExportDropped, 1);
+  }
+}
+
+void BcmSflowExporterTable::exportSamples() {
+  PendingDatagrams pending;
+  QueuedSample sample;
+  while (!stop_.load(std::memory_order_acquire)) {
+    auto now = std::chrono::steady_clock::now();
+    auto flushTime = pending.queued.empty()
+        ? now + kIdleWait
+        : pending.queued.front() +
+            std::chrono::microseconds(FLAGS_sflow_export_flush_interval_us);
+    // Don't wait past kIdleWait either, so that stop_ is noticed even with
+    // a long flush interval
+    if (flushTime > now &&
+        queue_.tryReadUntil(std::min(flushTime, now + kIdleWait), sample)) {
+      addSample(pending, sample);
+    } else if (
+        !pending.payloads.empty() &&
+        flushTime <= std::chrono::steady_clock::now()) {
+      flush(pending);
+    }
+  }
+  // Whatever is left at shutdown is not sent
+  auto dropped = pending.numSamples;
+  while (queue_.read(sample)) {
+    dropped++;
+  }
+  if (dropped > 0) {
+    fb303::fbData->incrementCounter(kSflowExportDropped, dropped);
+  }
+}
+
+void BcmSflowExporterTable::addSample(
+    PendingDatagrams& pending,
+    const QueuedSample& sample) {
   string output;
-  apache::thrift::BinarySerializer::serialize(info, &output);
-  auto buf = folly::IOBuf::wrapBuffer(output.data(), output.length());
-
-  // Map the IOBuf to a Linux iovec like a champ
-  iovec vec[16] = {};
-  size_t iovec_len = buf->fillIov(vec, sizeof(vec) / sizeof(vec[0])).numIovecs;
-  if (UNLIKELY(iovec_len == 0)) {
-    buf->coalesce();
-    vec[0].iov_base = const_cast<uint8_t*>(buf->data());
-    vec[0].iov_len = buf->length();
-    iovec_len = 1;
+  apache::thrift::BinarySerializer::serialize(sample.info, &output);
+
+  size_t maxPayloadSize = std::max(FLAGS_sflow_export_mtu - kUdpOverhead, 0);
+  if (!pending.payloads.empty() &&
+      pending.lastDatagramSamples <
+          FLAGS_sflow_export_max_samples_per_datagram &&
+      pending.payloads.back().size() + output.size() <= maxPayloadSize) {
+    pending.payloads.back().append(output);
+    pending.lastDatagramSamples++;
+    pending.numSamples++;
+    return;
+  }
+  if (pending.payloads.size() == kMaxDatagramsPerSend) {
+    flush(pending);
   }
+  pending.payloads.push_back(move(output));
+  pending.queued.push_back(sample.queued);
+  pending.lastDatagramSamples = 1;
+  pending.numSamples++;
+}
 
-  for (const auto& c : map_) {
-    // TODO: prob need to handle ret code?
-    c.second->sendUDPDatagram(vec, iovec_len);
+void BcmSflowExporterTable::flush(PendingDatagrams& pending) {
+  std::vector<iovec> vecs(pending.payloads.size());
+  for (size_t i = 0; i < pending.payloads.size(); ++i) {
+    vecs[i].iov_base = pending.payloads[i].data();
+    vecs[i].iov_len = pending.payloads[i].size();
+  }
+  {
+    auto exporters = map_.rlock();
+    for (const auto& c : *exporters) {
+      auto sent = c.second->sendUDPDatagrams(vecs);
+      if (sent < vecs.size()) {
+        fb303::fbData->incrementCounter(
+            kSflowExportSendFailed, vecs.size() - sent);
+      }
+    }
+  }
+  auto now = std::chrono::steady_clock::now();
+  for (auto queued : pending.queued) {
+    fb303::fbData->addHistogramValue(
+        kSflowExportLatency,
+        std::chrono::duration_cast<std::chrono::microseconds>(now - queued)
+            .count());
   }
+  pending.payloads.clear();
+  pending.queued.clear();
+  pending.lastDatagramSamples = 0;
+  pending.numSamples = 0;
 }
 
 } // namespace facebook::fboss
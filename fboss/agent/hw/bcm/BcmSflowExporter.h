@@ -9,10 +9,18 @@
  */
 #pragma once
 
+#include <sys/socket.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <folly/IPAddress.h>
+#include <folly/MPMCQueue.h>
 #include <folly/SocketAddress.h>
+#include <folly/Synchronized.h>
 
 #include "fboss/agent/if/gen-cpp2/sflow_types.h"
 #include "fboss/agent/state/SflowCollector.h"
@@ -31,9 +39,10 @@ class BcmSflowExporter {
   ~BcmSflowExporter();
 
   /*
-   * Send out the data in vec using UDP.  Called after init().
+   * Send out each of the datagrams using UDP, with as few sendmmsg calls as
+   * the socket allows. Returns the number of datagrams sent.
    */
-  ssize_t sendUDPDatagram(iovec* vec, const size_t iovec_len);
+  size_t sendUDPDatagrams(std::vector<iovec>& datagrams);
 
  private:
   // no copy or assignment
@@ -44,10 +53,20 @@ class BcmSflowExporter {
   int socket_{-1};
 };
 
+/*
+ * sendToAll() is called on the rx path for every sampled packet, so it only
+ * queues the sample. An export thread serializes the queued samples, packs up
+ * to --sflow_export_max_samples_per_datagram of them back to back in each
+ * datagram (within --sflow_export_mtu) and sends the pending datagrams to each
+ * collector with a single sendmmsg. Datagrams are flushed once
+ * kMaxDatagramsPerSend of them are pending, or once the oldest pending sample
+ * was queued --sflow_export_flush_interval_us ago. Samples are dropped if the
+ * queue is full. The export thread is started along with the first collector.
+ */
 class BcmSflowExporterTable {
  public:
-  BcmSflowExporterTable() = default;
-  ~BcmSflowExporterTable() = default;
+  BcmSflowExporterTable();
+  ~BcmSflowExporterTable();
 
   bool contains(const std::shared_ptr<SflowCollector>& collector) const;
   size_t size() const;
@@ -56,19 +75,46 @@ class BcmSflowExporterTable {
 
   void updateSamplingRates(PortID id, int64_t inRate, int64_t outRate);
 
-  void sendToAll(const SflowPacketInfo& info);
+  void sendToAll(SflowPacketInfo info);
 
  private:
   // no copy or assignment
   BcmSflowExporterTable(BcmSflowExporterTable const&) = delete;
   BcmSflowExporterTable& operator=(BcmSflowExporterTable const&) = delete;
 
-  std::unordered_map<std::string, std::unique_ptr<BcmSflowExporter>> map_;
+  static constexpr size_t kMaxDatagramsPerSend = 64;
+
+  struct QueuedSample {
+    std::chrono::steady_clock::time_point queued;
+    SflowPacketInfo info;
+  };
+
+  struct PendingDatagrams {
+    std::vector<std::string> payloads;
+    // when the oldest sample of each datagram was queued
+    std::vector<std::chrono::steady_clock::time_point> queued;
+    int lastDatagramSamples{0};
+    size_t numSamples{0};
+  };
+
+  void exportSamples();
+  void addSample(PendingDatagrams& pending, const QueuedSample& sample);
+  void flush(PendingDatagrams& pending);
+
+  folly::Synchronized<
+      std::unordered_map<std::string, std::unique_ptr<BcmSflowExporter>>>
+      map_;
+  std::atomic<size_t> numExporters_{0};
   std::unordered_map<
       PortID,
       std::pair<int64_t /* ingress rate */, int64_t /* egress rate */>>
       port2samplingRates_;
   folly::IPAddress localIP_;
+
+  folly::MPMCQueue<QueuedSample> queue_;
+  std::atomic<bool> stop_{false};
+  // Only accessed from the thread adding collectors, and on destruction
+  std::unique_ptr<std::thread> exportThread_;
 };
 
 } // namespace facebook::fboss
@@ -3177,7 +3177,7 @@ bool BcmSwitch::handleSflowPacket(BcmPacketT& bcmPacket) noexcept {
              << *info.srcPort() << ',' << *info.dstPort() << ',' << *info.vlan()
              << ',' << info.packetData()->length() << ")\n";
 
-  sFlowExporterTable_->sendToAll(info);
+  sFlowExporterTable_->sendToAll(std::move(info));
 
   // If it is only here because of sFlow, we're done
   if (sampleOnly) {
@@ -300,13 +300,18 @@ void BcmWarmBootCache::populateFromWarmBootState(
     }
   }
 
+  // Egress ids referenced by hosts and MPLS next hops, with repeats. These
+  // are counted once all are collected, see below.
+  std::vector<EgressId> egressIdsInWarmBootFile;
+  FlatMapBuilder<HostTableInWarmBootFile> hostTableBuilder;
+  hostTableBuilder.reserve(hostTable[kHosts].size());
   // Extract BcmHost and its egress object from the warm boot file
   for (const auto& hostEntry : hostTable[kHosts]) {
     auto egressId = hostEntry[kEgressId].asInt();
     if (egressId == BcmEgressBase::INVALID) {
       continue;
     }
-    egressId2WeightInWarmBootFile_[egressId]++;
+    egressIdsInWarmBootFile.push_back(egressId);
 
     std::optional<bcm_if_t> intf{std::nullopt};
     auto ip = folly::IPAddress(hostEntry[kIp].stringPiece());
@@ -323,7 +328,7 @@ void BcmWarmBootCache::populateFromWarmBootState(
     }
     auto vrf = hostEntry[kVrf].asInt();
     auto key = std::make_tuple(vrf, ip, intf);
-    vrfIp2EgressFromBcmHostInWarmBootFile_[key] = egressId;
+    hostTableBuilder.add(key, egressId);
 
     int classID = 0;
     if (hostEntry.find(kClassID) != hostEntry.items().end()) {
@@ -337,6 +342,7 @@ void BcmWarmBootCache::populateFromWarmBootState(
                << ") pointing to the egress entry, id=" << egressId
                << " classID: " << classID;
   }
+  vrfIp2EgressFromBcmHostInWarmBootFile_ = hostTableBuilder.build();
 
   // extract MPLS next hop and its egress object from the  warm boot file
   const auto& mplsNextHops = (warmBootState[kHwSwitch].find(kMplsNextHops) !=
@@ -349,7 +355,7 @@ void BcmWarmBootCache::populateFromWarmBootState(
     if (egressId == BcmEgressBase::INVALID) {
       continue;
     }
-    egressId2WeightInWarmBootFile_[egressId]++;
+    egressIdsInWarmBootFile.push_back(egressId);
     auto vrf = mplsNextHop[kVrf].asInt();
     auto ip = folly::IPAddress(mplsNextHop[kIp].stringPiece());
     auto intfID = InterfaceID(mplsNextHop[kIntf].asInt());
@@ -372,6 +378,16 @@ void BcmWarmBootCache::populateFromWarmBootState(
     }
   }
 
+  std::sort(egressIdsInWarmBootFile.begin(), egressIdsInWarmBootFile.end());
+  FlatMapBuilder<EgressId2Weight> egressId2WeightBuilder;
+  for (auto it = egressIdsInWarmBootFile.begin();
+       it != egressIdsInWarmBootFile.end();) {
+    auto next = std::upper_bound(it, egressIdsInWarmBootFile.end(), *it);
+    egressId2WeightBuilder.add(*it, next - it);
+    it = next;
+  }
+  egressId2WeightInWarmBootFile_ = egressId2WeightBuilder.build();
+
   // get l3 intfs for each known vlan in warmboot state file
   // TODO(pshaikh): in earlier warm boot state file, kIntfTable could be
   // absent after two pushes this condition can be removed
@@ -514,6 +530,8 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
   bcm_l3_info_t l3Info;
   bcm_l3_info_t_init(&l3Info);
   bcm_l3_info(hw_->getUnit(), &l3Info);
+  canUseHostTableForHostRoutes_ =
+      hw_->getPlatform()->canUseHostTableForHostRoutes();
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::HOSTTABLE)) {
     // Traverse V4 hosts
     rv = bcm_l3_host_traverse(
@@ -554,9 +572,11 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
       routeTraversalCallback,
       this);
   bcmCheckError(rv, "Failed to traverse v6 routes");
+  finishRouteTraversals();
   // Get egress entries.
   rv = bcm_l3_egress_traverse(hw_->getUnit(), egressTraversalCallback, this);
   bcmCheckError(rv, "Failed to traverse egress");
+  finishEgressTraversal();
   // Traverse ecmp egress entries
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::HSDK)) {
     rv = bcm_l3_ecmp_traverse(
@@ -568,6 +588,7 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
         hw_->getUnit(), ecmpEgressTraversalCallback<bcm_if_t>, this);
   }
   bcmCheckError(rv, "Failed to traverse ecmp egress");
+  finishEcmpTraversal();
 
   // populate acls, acl stats
   populateAcls(
@@ -584,6 +605,23 @@ void BcmWarmBootCache::populate(const folly::dynamic& warmBootState) {
   populateRxReasonToQueue();
 }
 
+void BcmWarmBootCache::finishRouteTraversals() {
+  vrfAndIP2Route_ = vrfAndIP2RouteBuilder_.build();
+}
+
+void BcmWarmBootCache::finishEgressTraversal() {
+  egressId2Egress_ = egressId2EgressBuilder_.build();
+  traversedEgressIds_.clear();
+}
+
+void BcmWarmBootCache::finishEcmpTraversal() {
+  egressIds2Ecmp_ = egressIds2EcmpBuilder_.build([](const auto& ecmp) {
+    XLOG(FATAL) << "Got a duplicated call for ecmp id: "
+                << ecmp.second.ecmp_intf
+                << " referencing: " << toEgressId2WeightStr(ecmp.first);
+  });
+}
+
 bool BcmWarmBootCache::fillVlanPortInfo(Vlan* vlan) {
   auto vlanItr = vlan2VlanInfo_.find(vlan->getID());
   if (vlanItr != vlan2VlanInfo_.end()) {
@@ -625,7 +663,7 @@ int BcmWarmBootCache::egressTraversalCallback(
     bcm_l3_egress_t* egress,
     void* userData) {
   BcmWarmBootCache* cache = static_cast<BcmWarmBootCache*>(userData);
-  CHECK(cache->egressId2Egress_.find(egressId) == cache->egressId2Egress_.end())
+  CHECK(cache->traversedEgressIds_.insert(egressId).second)
       << "Double callback for egress id: " << egressId;
   // Look up egressId in egressId2WeightInWarmBootFile_
   // to populate both dropEgressId_ and toCPUEgressId_.
@@ -635,7 +673,7 @@ int BcmWarmBootCache::egressTraversalCallback(
     // reference it.
     XLOG(DBG1) << "Adding bcm egress entry for: " << egressIdItr->first
                << " which is referenced by at least one host or route entry.";
-    cache->egressId2Egress_[egressId] = *egress;
+    cache->egressId2EgressBuilder_.add(egressId, *egress);
   } else {
     // found egress ID that is not used by any host entry, we shall
     // only have two of them. One is for drop and the other one is for TO CPU.
@@ -677,11 +715,11 @@ int BcmWarmBootCache::routeTraversalCallback(
   auto mask = isIPv6 ? IPAddress::fromBinary(ByteRange(
                            route->l3a_ip6_mask, sizeof(route->l3a_ip6_mask)))
                      : IPAddress::fromLongHBO(route->l3a_ip_mask);
-  if (cache->getHw()->getPlatform()->canUseHostTableForHostRoutes() &&
+  if (cache->canUseHostTableForHostRoutes_ &&
       ((isIPv6 && mask == getFullMaskIPv6Address()) ||
        (!isIPv6 && mask == getFullMaskIPv4Address()))) {
     // This is a host route.
-    cache->vrfAndIP2Route_[make_pair(route->l3a_vrf, ip)] = *route;
+    cache->vrfAndIP2RouteBuilder_.add(make_pair(route->l3a_vrf, ip), *route);
     XLOG(DBG3) << "Adding host route found in route table. vrf: "
                << route->l3a_vrf << " ip: " << ip << " mask: " << mask;
   } else {
@@ -734,12 +772,9 @@ int BcmWarmBootCache::ecmpEgressTraversalCallback(
   CHECK_GT(egressId2Weight.size(), 0)
       << "There must be at least one egress pointed to by the ecmp egress id: "
       << ecmp->ecmp_intf;
-  CHECK(
-      cache->egressIds2Ecmp_.find(egressId2Weight) ==
-      cache->egressIds2Ecmp_.end())
-      << "Got a duplicated call for ecmp id: " << ecmp->ecmp_intf
-      << " referencing: " << toEgressId2WeightStr(egressId2Weight);
-  cache->egressIds2Ecmp_[egressId2Weight] = *ecmp;
+  // Duplicated calls are caught once the traversal is done, when building
+  // egressIds2Ecmp_
+  cache->egressIds2EcmpBuilder_.add(egressId2Weight, *ecmp);
   XLOG(DBG1) << "Added ecmp egress id : " << ecmp->ecmp_intf
              << " pointing to : " << toEgressId2WeightStr(egressId2Weight)
              << " egress ids";
@@ -22,6 +22,7 @@ extern "C" {
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 #include <folly/dynamic.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
@@ -43,6 +44,7 @@ extern "C" {
 #include "fboss/agent/state/LabelForwardingAction.h"
 #include "fboss/agent/state/QosPolicy.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/FlatMapBuilder.h"
 
 namespace facebook::fboss {
 
@@ -204,6 +206,13 @@ class BcmWarmBootCache {
       int memberCount,
       T* memberArray,
       void* userData);
+  /*
+   * Build the maps from the entries found by the route (both host and
+   * prefix), egress and ECMP traversals, once each traversal is done.
+   */
+  void finishRouteTraversals();
+  void finishEgressTraversal();
+  void finishEcmpTraversal();
 
   /**
    * Helper functions for populate AclEntry since we don't have
@@ -643,6 +652,8 @@ class BcmWarmBootCache {
   // No copy or assignment.
   BcmWarmBootCache(const BcmWarmBootCache&) = delete;
   BcmWarmBootCache& operator=(const BcmWarmBootCache&) = delete;
+  // Drives the traversal callbacks with synthetic entries, without h/w
+  friend class BcmWarmBootCachePopulateBenchmarkHelper;
   const BcmSwitchIf* hw_;
   Vlan2VlanInfo vlan2VlanInfo_;
   Vlan2Station vlan2Station_;
@@ -668,6 +679,16 @@ class BcmWarmBootCache {
   VrfAndIP2Route vrfAndIP2Route_;
   EgressId2Egress egressId2Egress_;
   EgressIds2Ecmp egressIds2Ecmp_;
+  // Entries found by the h/w traversals in populate(), built into the flat
+  // maps above once each traversal is done.
+  FlatMapBuilder<VrfAndIP2Route> vrfAndIP2RouteBuilder_;
+  FlatMapBuilder<EgressId2Egress> egressId2EgressBuilder_;
+  FlatMapBuilder<EgressIds2Ecmp> egressIds2EcmpBuilder_;
+  // All egress ids seen by the egress traversal, including the ones not
+  // added to egressId2EgressBuilder_, to catch double callbacks.
+  folly::F14FastSet<EgressId> traversedEgressIds_;
+  // Read from the platform once per populate(), not once per route callback
+  bool canUseHostTableForHostRoutes_{false};
   LabelStackKey2TunnelId labelStackKey2TunnelId_;
   bcm_if_t dropEgressId_;
   bcm_if_t toCPUEgressId_;
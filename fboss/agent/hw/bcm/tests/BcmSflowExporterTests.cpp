@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/FileUtil.h>
+#include <folly/SocketAddress.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <array>
+
+DECLARE_int32(sflow_export_max_samples_per_datagram);
+DECLARE_int32(sflow_export_flush_interval_us);
+
+using namespace facebook::fboss;
+
+namespace {
+
+/*
+ * Local UDP socket standing in for an sFlow collector.
+ */
+class TestCollector {
+ public:
+  TestCollector() {
+    socket_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_NE(socket_, -1);
+    timeval timeout{1, 0};
+    CHECK_EQ(
+        setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)),
+        0);
+    folly::SocketAddress addr("127.0.0.1", 0);
+    sockaddr_storage addrStorage;
+    addr.getAddress(&addrStorage);
+    CHECK_EQ(
+        bind(
+            socket_,
+            reinterpret_cast<sockaddr*>(&addrStorage),
+            addr.getActualSize()),
+        0);
+    addr.setFromLocalAddress(folly::NetworkSocket::fromFd(socket_));
+    collector_ = std::make_shared<SflowCollector>("127.0.0.1", addr.getPort());
+  }
+  ~TestCollector() {
+    folly::closeNoInt(socket_);
+  }
+
+  const std::shared_ptr<SflowCollector>& collector() const {
+    return collector_;
+  }
+
+  // Returns the samples of the next datagram, none on timeout
+  std::vector<SflowPacketInfo> receive() {
+    std::array<uint8_t, 9000> buf;
+    auto len = folly::readNoInt(socket_, buf.data(), buf.size());
+    std::vector<SflowPacketInfo> samples;
+    folly::ByteRange data(buf.data(), std::max<ssize_t>(len, 0));
+    while (!data.empty()) {
+      SflowPacketInfo info;
+      data.advance(apache::thrift::BinarySerializer::deserialize(data, info));
+      samples.push_back(std::move(info));
+    }
+    return samples;
+  }
+
+ private:
+  int socket_{-1};
+  std::shared_ptr<SflowCollector> collector_;
+};
+
+SflowPacketInfo makeSample(int srcPort) {
+  SflowPacketInfo info;
+  *info.ingressSampled() = true;
+  info.srcPort() = srcPort;
+  *info.packetData() = std::string(128, 'x');
+  return info;
+}
+
+class BcmSflowExporterTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    FLAGS_sflow_export_max_samples_per_datagram = 1;
+    FLAGS_sflow_export_flush_interval_us = 1000;
+  }
+
+  // Receives datagrams until numSamples samples are read
+  std::vector<std::vector<SflowPacketInfo>> receiveSamples(
+      TestCollector& collector,
+      size_t numSamples) {
+    std::vector<std::vector<SflowPacketInfo>> datagrams;
+    size_t received = 0;
+    while (received < numSamples) {
+      auto samples = collector.receive();
+      if (samples.empty()) {
+        break;
+      }
+      received += samples.size();
+      datagrams.push_back(std::move(samples));
+    }
+    return datagrams;
+  }
+};
+
+} // namespace
+
+TEST_F(BcmSflowExporterTest, sendToAllCollectors) {
+  TestCollector collector1;
+  TestCollector collector2;
+  BcmSflowExporterTable table;
+  table.addExporter(collector1.collector());
+  table.addExporter(collector2.collector());
+  EXPECT_EQ(table.size(), 2u);
+
+  for (int i = 0; i < 3; ++i) {
+    table.sendToAll(makeSample(i));
+  }
+  for (auto* collector : {&collector1, &collector2}) {
+    auto datagrams = receiveSamples(*collector, 3);
+    ASSERT_EQ(datagrams.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_EQ(datagrams[i].size(), 1u);
+      EXPECT_EQ(*datagrams[i][0].srcPort(), i);
+    }
+  }
+}
+
+TEST_F(BcmSflowExporterTest, packSamplesPerDatagram) {
+  FLAGS_sflow_export_max_samples_per_datagram = 4;
+  FLAGS_sflow_export_flush_interval_us = 100000;
+  TestCollector collector;
+  BcmSflowExporterTable table;
+  table.addExporter(collector.collector());
+
+  for (int i = 0; i < 8; ++i) {
+    table.sendToAll(makeSample(i));
+  }
+  auto datagrams = receiveSamples(collector, 8);
+  ASSERT_GE(datagrams.size(), 2u);
+  int srcPort = 0;
+  for (const auto& samples : datagrams) {
+    EXPECT_LE(samples.size(), 4u);
+    for (const auto& sample : samples) {
+      EXPECT_EQ(*sample.srcPort(), srcPort++);
+    }
+  }
+  EXPECT_EQ(srcPort, 8);
+}
+
+TEST_F(BcmSflowExporterTest, removedCollector) {
+  TestCollector collector;
+  BcmSflowExporterTable table;
+  table.addExporter(collector.collector());
+  EXPECT_TRUE(table.contains(collector.collector()));
+  table.removeExporter(collector.collector()->getID());
+  EXPECT_FALSE(table.contains(collector.collector()));
+
+  table.sendToAll(makeSample(0));
+  EXPECT_TRUE(collector.receive().empty());
+}
+
+TEST_F(BcmSflowExporterTest, countSamplesDroppedAtStop) {
+  FLAGS_sflow_export_max_samples_per_datagram = 4;
+  // Long enough for the samples to still be pending at destruction
+  FLAGS_sflow_export_flush_interval_us = 10000000;
+  TestCollector collector;
+  fb303::fbData->incrementCounter("sflow_export.dropped", 0);
+  auto dropped = fb303::fbData->getCounter("sflow_export.dropped");
+  {
+    BcmSflowExporterTable table;
+    table.addExporter(collector.collector());
+    for (int i = 0; i < 6; ++i) {
+      table.sendToAll(makeSample(i));
+    }
+  }
+  EXPECT_EQ(fb303::fbData->getCounter("sflow_export.dropped"), dropped + 6);
+}
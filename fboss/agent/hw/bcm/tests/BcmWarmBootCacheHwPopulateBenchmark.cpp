@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/hw/bcm/BcmSwitch.h"
+#include "fboss/agent/hw/bcm/BcmWarmBootCache.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+
+#include <folly/Benchmark.h>
+#include <folly/dynamic.h>
+
+namespace facebook::fboss {
+
+/*
+ * Measures populating the warm boot cache on h/w, i.e. reading back the warm
+ * boot file and traversing the SDK tables, with RSW scale routes, host
+ * entries, egress and ECMP objects programmed in h/w. See
+ * BcmWarmBootCachePopulateBenchmark for the same without h/w.
+ */
+BENCHMARK(BcmWarmBootCacheHwPopulate) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  auto hwSwitch = static_cast<BcmSwitch*>(ensemble->getHwSwitch());
+  auto config =
+      utility::onePortPerVlanConfig(hwSwitch, ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+  utility::RSWRouteScaleGenerator routeGenerator(
+      ensemble->getProgrammedState());
+  ensemble->applyNewState(
+      routeGenerator.resolveNextHops(ensemble->getProgrammedState()));
+  auto updater = ensemble->getRouteUpdater();
+  updater.programRoutes(
+      RouterID(0), ClientID::BGPD, routeGenerator.getThriftRoutes());
+
+  // Same content as the warm boot file written on graceful exit
+  folly::dynamic switchState = folly::dynamic::object;
+  switchState[kSwSwitch] = ensemble->getProgrammedState()->toFollyDynamic();
+  switchState[kHwSwitch] = hwSwitch->toFollyDynamic();
+  BcmWarmBootCache warmBootCache(hwSwitch);
+
+  suspender.dismiss();
+  warmBootCache.populate(switchState);
+  suspender.rehire();
+}
+
+} // namespace facebook::fboss
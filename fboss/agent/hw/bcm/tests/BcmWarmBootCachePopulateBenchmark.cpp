@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Measures populating the warm boot cache host, route, egress and ECMP
+ * tables. Synthetic traversal data is fed through the same callbacks and map
+ * builds that BcmWarmBootCache::populate() uses with the SDK traversals, so
+ * no hardware is needed. Entries are handed to the callbacks in h/w table
+ * order, which is unrelated to the order of the cache keys.
+ */
+
+#include "fboss/agent/hw/bcm/BcmWarmBootCache.h"
+
+extern "C" {
+#include <bcm/l3.h>
+#include <bcm/mpls.h>
+}
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace facebook::fboss {
+
+class BcmWarmBootCachePopulateBenchmarkHelper {
+ public:
+  /*
+   * numHosts v4 and v6 neighbors, each with its own egress and host entry,
+   * one /128 host route and one /64 route per v6 neighbor, and one ECMP
+   * group of kEcmpWidth neighbors per kEcmpWidth neighbors.
+   */
+  explicit BcmWarmBootCachePopulateBenchmarkHelper(size_t numHosts) {
+    std::mt19937 rng(folly::randomNumberSeed());
+    for (size_t i = 0; i < numHosts; ++i) {
+      egressIdsInWarmBootFile_[kEgressIdBase + i] = 1;
+      bcm_l3_egress_t egress;
+      std::memset(&egress, 0, sizeof(egress));
+      egress.intf = kIntfIdBase + i % 64;
+      egress.mpls_label = BCM_MPLS_LABEL_INVALID;
+      egresses_.emplace_back(kEgressIdBase + i, egress);
+
+      bcm_l3_host_t host;
+      std::memset(&host, 0, sizeof(host));
+      host.l3a_intf = kEgressIdBase + i;
+      if (i % 2) {
+        host.l3a_flags = BCM_L3_IP6;
+        setV6Address(host.l3a_ip6_addr, i);
+      } else {
+        host.l3a_ip_addr = 0x0a000000 + i;
+      }
+      hosts_.push_back(host);
+
+      if (host.l3a_flags & BCM_L3_IP6) {
+        routes_.push_back(makeV6Route(i, 128, host.l3a_intf));
+        routes_.push_back(makeV6Route(i, 64, kEcmpIdBase + i / kEcmpWidth));
+      }
+    }
+    // The drop and to CPU egresses, which no host entry references
+    for (uint32 flags : {BCM_L3_DST_DISCARD, BCM_L3_L2TOCPU}) {
+      bcm_l3_egress_t egress;
+      std::memset(&egress, 0, sizeof(egress));
+      egress.flags = flags;
+      egress.mpls_label = BCM_MPLS_LABEL_INVALID;
+      egresses_.emplace_back(kEgressIdBase + egresses_.size(), egress);
+    }
+    for (size_t i = 0; i + kEcmpWidth <= numHosts; i += kEcmpWidth) {
+      bcm_l3_egress_ecmp_t ecmp;
+      std::memset(&ecmp, 0, sizeof(ecmp));
+      ecmp.ecmp_intf = kEcmpIdBase + i / kEcmpWidth;
+      std::vector<bcm_if_t> members;
+      for (size_t j = 0; j < kEcmpWidth; ++j) {
+        members.push_back(kEgressIdBase + i + j);
+        ecmp2EgressIdsInWarmBootFile_[ecmp.ecmp_intf][members.back()] = 1;
+      }
+      ecmps_.emplace_back(ecmp, std::move(members));
+    }
+    std::shuffle(hosts_.begin(), hosts_.end(), rng);
+    std::shuffle(routes_.begin(), routes_.end(), rng);
+    std::shuffle(egresses_.begin(), egresses_.end(), rng);
+    std::shuffle(ecmps_.begin(), ecmps_.end(), rng);
+  }
+
+  // What populate() reads from the warm boot file before the traversals
+  void loadWarmBootFile(BcmWarmBootCache* cache) const {
+    cache->egressId2WeightInWarmBootFile_ = egressIdsInWarmBootFile_;
+    cache->hwSwitchEcmp2EgressIds_ = ecmp2EgressIdsInWarmBootFile_;
+    cache->canUseHostTableForHostRoutes_ = true;
+  }
+
+  // The traversals of populate(), in the same order
+  void traverse(BcmWarmBootCache* cache) {
+    for (auto& host : hosts_) {
+      BcmWarmBootCache::hostTraversalCallback(0, 0, &host, cache);
+    }
+    for (auto& route : routes_) {
+      BcmWarmBootCache::routeTraversalCallback(0, 0, &route, cache);
+    }
+    cache->finishRouteTraversals();
+    for (auto& [egressId, egress] : egresses_) {
+      BcmWarmBootCache::egressTraversalCallback(0, egressId, &egress, cache);
+    }
+    cache->finishEgressTraversal();
+    for (auto& [ecmp, members] : ecmps_) {
+      BcmWarmBootCache::ecmpEgressTraversalCallback<bcm_if_t>(
+          0, &ecmp, members.size(), members.data(), cache);
+    }
+    cache->finishEcmpTraversal();
+  }
+
+  static size_t cachedEntries(const BcmWarmBootCache& cache) {
+    return cache.vrfIp2Host_.size() + cache.vrfAndIP2Route_.size() +
+        cache.vrfPrefix2Route_.size() + cache.egressId2Egress_.size() +
+        cache.egressIds2Ecmp_.size();
+  }
+
+ private:
+  static constexpr bcm_if_t kEgressIdBase = 100000;
+  static constexpr bcm_if_t kEcmpIdBase = 200000;
+  static constexpr bcm_if_t kIntfIdBase = 2000;
+  static constexpr size_t kEcmpWidth = 16;
+
+  // 2401:db00::/32 addresses
+  static void setV6Address(bcm_ip6_t addr, size_t i) {
+    std::memset(addr, 0, sizeof(bcm_ip6_t));
+    addr[0] = 0x24;
+    addr[1] = 0x01;
+    addr[2] = 0xdb;
+    for (int byte = 0; byte < 4; ++byte) {
+      addr[15 - byte] = (i >> (8 * byte)) & 0xff;
+      // Distinct /64 prefixes as well
+      addr[7 - byte] = (i >> (8 * byte)) & 0xff;
+    }
+  }
+
+  static bcm_l3_route_t makeV6Route(size_t i, int maskLen, bcm_if_t intf) {
+    bcm_l3_route_t route;
+    std::memset(&route, 0, sizeof(route));
+    route.l3a_flags = BCM_L3_IP6;
+    setV6Address(route.l3a_ip6_net, i);
+    for (int byte = 0; byte < 16; ++byte) {
+      if (byte * 8 >= maskLen) {
+        route.l3a_ip6_net[byte] = 0;
+      } else {
+        route.l3a_ip6_mask[byte] = 0xff;
+      }
+    }
+    route.l3a_intf = intf;
+    return route;
+  }
+
+  BcmWarmBootCache::EgressId2Weight egressIdsInWarmBootFile_;
+  BcmWarmBootCache::Ecmp2EgressIds ecmp2EgressIdsInWarmBootFile_;
+  std::vector<bcm_l3_host_t> hosts_;
+  std::vector<bcm_l3_route_t> routes_;
+  std::vector<std::pair<bcm_if_t, bcm_l3_egress_t>> egresses_;
+  std::vector<std::pair<bcm_l3_egress_ecmp_t, std::vector<bcm_if_t>>> ecmps_;
+};
+
+namespace {
+
+void populateFromTraversals(size_t iters, size_t numHosts) {
+  folly::BenchmarkSuspender suspender;
+  BcmWarmBootCachePopulateBenchmarkHelper helper(numHosts);
+  for (size_t iter = 0; iter < iters; ++iter) {
+    // The callbacks only use the h/w for MPLS egresses, which there are none
+    BcmWarmBootCache cache(nullptr);
+    helper.loadWarmBootFile(&cache);
+    suspender.dismiss();
+    helper.traverse(&cache);
+    suspender.rehire();
+    folly::doNotOptimizeAway(
+        BcmWarmBootCachePopulateBenchmarkHelper::cachedEntries(cache));
+  }
+}
+
+} // namespace
+
+BENCHMARK_PARAM(populateFromTraversals, 10000);
+BENCHMARK_PARAM(populateFromTraversals, 50000);
+BENCHMARK_PARAM(populateFromTraversals, 100000);
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/ProdConfigFactory.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+
+namespace facebook::fboss {
+
+/*
+ * Re-apply a prod RSW config with a one line change (a port description)
+ * 100 times, as automated config pushes do. Only the switch state is built,
+ * nothing is programmed in hardware, so this times ThriftConfigApplier alone.
+ */
+BENCHMARK(HwApplyProdConfig) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  auto config = utility::createProdRswConfig(
+      ensemble->getHwSwitch(),
+      ensemble->masterLogicalPortIds(),
+      ensemble->isSai());
+  ensemble->applyInitialConfig(config);
+  // Create a dummy rib since we don't want to go through
+  // HwSwitchEnsemble and write to HW
+  auto rib = RoutingInformationBase::fromFollyDynamic(
+      ensemble->getRib()->toFollyDynamic(), nullptr, nullptr);
+  auto state = ensemble->getProgrammedState();
+  auto prevConfig = config;
+  suspender.dismiss();
+  for (auto i = 0; i < 100; ++i) {
+    config.ports()->front().description() = folly::to<std::string>("desc", i);
+    auto newState = applyThriftConfig(
+        state, &config, ensemble->getPlatform(), rib.get(), &prevConfig);
+    if (newState) {
+      newState->publish();
+      state = newState;
+    }
+    prevConfig = config;
+  }
+  suspender.rehire();
+}
+
+} // namespace facebook::fboss
@@ -26,19 +26,54 @@
 #include <folly/init/Init.h>
 #include <folly/json.h>
 
+#include <atomic>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 DEFINE_bool(json, true, "Output in json form");
 DEFINE_bool(
     setup_for_warmboot,
     false,
     "Set to true will prepare the device for warmboot");
+DEFINE_int32(
+    rx_slow_path_held_packets,
+    1024,
+    "Number of most recent rx packets whose buffer is held, as a deferred "
+    "consumer (capture, tun write, queued handler) would");
 
 namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 
+/*
+ * Counts packets delivered to the agent and holds a clone of the most recent
+ * ones, so rx buffers are shared with and outlive the rx callback.
+ */
+class RxPacketHolder : public HwSwitchEnsemble::HwSwitchEventObserverIf {
+ public:
+  explicit RxPacketHolder(size_t numHeld) : held_(numHeld) {}
+
+  uint64_t packetsReceived() const {
+    return packetsReceived_.load();
+  }
+
+ private:
+  void packetReceived(RxPacket* pkt) noexcept override {
+    auto count = packetsReceived_++;
+    if (!held_.empty()) {
+      held_[count % held_.size()] = pkt->buf()->clone();
+    }
+  }
+  void linkStateChanged(PortID /*port*/, bool /*up*/) override {}
+  void l2LearningUpdateReceived(
+      L2Entry /*l2Entry*/,
+      L2EntryUpdateType /*l2EntryUpdateType*/) override {}
+
+  std::atomic<uint64_t> packetsReceived_{0};
+  std::vector<std::unique_ptr<folly::IOBuf>> held_;
+};
+
 void runRxSlowPathBenchmark() {
   constexpr int kEcmpWidth = 1;
   auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
@@ -77,6 +112,8 @@ void runRxSlowPathBenchmark() {
       folly::IPAddressV6(kDstIp),
       8000,
       8001);
+  RxPacketHolder rxPacketHolder(FLAGS_rx_slow_path_held_packets);
+  ensemble->addHwEventObserver(&rxPacketHolder);
   hwSwitch->sendPacketSwitchedSync(std::move(txPacket));
 
   constexpr auto kBurnIntevalInSeconds = 5;
@@ -85,12 +122,15 @@ void runRxSlowPathBenchmark() {
   constexpr uint8_t kCpuQueue = 0;
   auto [pktsBefore, bytesBefore] =
       utility::getCpuQueueOutPacketsAndBytes(hwSwitch, kCpuQueue);
+  auto agentPktsBefore = rxPacketHolder.packetsReceived();
   auto timeBefore = std::chrono::steady_clock::now();
   CHECK_NE(pktsBefore, 0);
   std::this_thread::sleep_for(std::chrono::seconds(kBurnIntevalInSeconds));
   auto [pktsAfter, bytesAfter] =
       utility::getCpuQueueOutPacketsAndBytes(hwSwitch, kCpuQueue);
+  auto agentPktsAfter = rxPacketHolder.packetsReceived();
   auto timeAfter = std::chrono::steady_clock::now();
+  ensemble->removeHwEventObserver(&rxPacketHolder);
   std::chrono::duration<double, std::milli> durationMillseconds =
       timeAfter - timeBefore;
   uint32_t pps = (static_cast<double>(pktsAfter - pktsBefore) /
@@ -99,16 +139,22 @@ void runRxSlowPathBenchmark() {
   uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
                           durationMillseconds.count()) *
       1000;
+  uint32_t agentPps =
+      (static_cast<double>(agentPktsAfter - agentPktsBefore) /
+       durationMillseconds.count()) *
+      1000;
 
   if (FLAGS_json) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
+    cpuRxRateJson["agent_rx_pps"] = agentPps;
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(INFO) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " agent rx pps: " << agentPps;
   }
 }
 } // namespace facebook::fboss
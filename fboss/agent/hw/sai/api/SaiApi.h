@@ -11,12 +11,12 @@
 
 #include "fboss/agent/hw/sai/api/HwWriteBehavior.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallProfiler.h"
 #include "fboss/agent/hw/sai/api/SaiApiError.h"
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiAttribute.h"
 #include "fboss/agent/hw/sai/api/SaiAttributeDataTypes.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
-#include "fboss/lib/FunctionCallTimeReporter.h"
 #include "fboss/lib/TupleUtils.h"
 
 #include <folly/Format.h>
@@ -82,7 +82,7 @@ class SaiApi {
     auto g{SaiApiLock::getInstance()->lock()};
     sai_status_t status;
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::CREATE);
       status = impl()._create(
           &key, switch_id, saiAttributeTs.size(), saiAttributeTs.data());
     }
@@ -118,7 +118,7 @@ class SaiApi {
     auto g{SaiApiLock::getInstance()->lock()};
     sai_status_t status;
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::CREATE);
       status =
           impl()._create(entry, saiAttributeTs.size(), saiAttributeTs.data());
     }
@@ -144,7 +144,7 @@ class SaiApi {
     auto g{SaiApiLock::getInstance()->lock()};
     sai_status_t status;
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::REMOVE);
       status = impl()._remove(key);
     }
     saiApiCheckError(
@@ -178,7 +178,7 @@ class SaiApi {
     auto g{SaiApiLock::getInstance()->lock()};
     sai_status_t status;
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::GET_ATTRIBUTE);
       status = impl()._getAttribute(key, attr.saiAttr());
     }
     /*
@@ -191,7 +191,7 @@ class SaiApi {
     if (status == SAI_STATUS_BUFFER_OVERFLOW) {
       attr.realloc();
       {
-        TIME_CALL;
+        SaiApiCallTimer timer(apiType(), SaiApiCallType::GET_ATTRIBUTE);
         status = impl()._getAttribute(key, attr.saiAttr());
       }
     }
@@ -303,7 +303,7 @@ class SaiApi {
     }
     sai_status_t status;
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::SET_ATTRIBUTE);
       status = impl()._setAttribute(key, saiAttr(attr));
     }
     saiApiCheckError(
@@ -346,7 +346,7 @@ class SaiApi {
     sai_status_t status;
     sai_status_t retStatus[adapterKeys.size()];
     {
-      TIME_CALL;
+      SaiApiCallTimer timer(apiType(), SaiApiCallType::BULK_SET_ATTRIBUTE);
       status = impl()._bulkSetAttribute(
           adapterKeys.data(), attrs.data(), retStatus, adapterKeys.size());
     }
@@ -457,7 +457,7 @@ class SaiApi {
       counters.resize(numCounters);
       sai_status_t status;
       {
-        TIME_CALL
+        SaiApiCallTimer timer(apiType(), SaiApiCallType::GET_STATS);
         status = impl()._getStats(
             key, counters.size(), counterIds, mode, counters.data());
       }
@@ -484,7 +484,7 @@ class SaiApi {
       }
       sai_status_t status;
       {
-        TIME_CALL
+        SaiApiCallTimer timer(apiType(), SaiApiCallType::CLEAR_STATS);
         status = impl()._clearStats(key, numCounters, counterIds);
       }
       saiApiCheckError(status, apiType(), "Failed to clear stats");
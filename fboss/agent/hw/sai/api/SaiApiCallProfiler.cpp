@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiCallProfiler.h"
+
+#include "fboss/agent/hw/sai/api/LoggingUtil.h"
+
+#include <folly/lang/Bits.h>
+
+#include <fmt/format.h>
+#include <algorithm>
+
+DEFINE_bool(
+    enable_sai_call_latency_stats,
+    true,
+    "Record latency histograms of SAI calls, per SAI api and call type");
+
+namespace facebook::fboss {
+
+folly::StringPiece saiApiCallTypeToString(SaiApiCallType callType) {
+  switch (callType) {
+    case SaiApiCallType::CREATE:
+      return "create";
+    case SaiApiCallType::REMOVE:
+      return "remove";
+    case SaiApiCallType::GET_ATTRIBUTE:
+      return "get";
+    case SaiApiCallType::SET_ATTRIBUTE:
+      return "set";
+    case SaiApiCallType::BULK_SET_ATTRIBUTE:
+      return "bulk_set";
+    case SaiApiCallType::GET_STATS:
+      return "get_stats";
+    case SaiApiCallType::CLEAR_STATS:
+      return "clear_stats";
+    case SaiApiCallType::NUM_CALL_TYPES:
+      break;
+  }
+  return "unknown";
+}
+
+void SaiApiCallProfiler::Latencies::merge(const Latencies& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  totalUsecs += other.totalUsecs;
+  maxUsecs = std::max(maxUsecs, other.maxUsecs);
+}
+
+uint64_t SaiApiCallProfiler::Latencies::percentileUsecs(
+    double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(count * percentile / 100.0);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets - 1; ++i) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return std::min(uint64_t(1) << i, maxUsecs);
+    }
+  }
+  return maxUsecs;
+}
+
+void SaiApiCallProfiler::AtomicLatencies::record(uint64_t usecs) {
+  // Single writer, so plain load + store rather than read-modify-write
+  auto bump = [](std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(
+        counter.load(std::memory_order_relaxed) + value,
+        std::memory_order_relaxed);
+  };
+  auto bucket = std::min<size_t>(folly::findLastSet(usecs), kNumBuckets - 1);
+  bump(buckets[bucket], 1);
+  bump(count, 1);
+  bump(totalUsecs, usecs);
+  if (usecs > maxUsecs.load(std::memory_order_relaxed)) {
+    maxUsecs.store(usecs, std::memory_order_relaxed);
+  }
+}
+
+SaiApiCallProfiler::Latencies SaiApiCallProfiler::AtomicLatencies::load()
+    const {
+  Latencies latencies;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    latencies.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+  }
+  latencies.count = count.load(std::memory_order_relaxed);
+  latencies.totalUsecs = totalUsecs.load(std::memory_order_relaxed);
+  latencies.maxUsecs = maxUsecs.load(std::memory_order_relaxed);
+  return latencies;
+}
+
+SaiApiCallProfiler::ThreadLatencies::~ThreadLatencies() {
+  auto exited = profiler->exitedThreadLatencies_.wlock();
+  for (size_t api = 0; api < kNumApis; ++api) {
+    for (size_t callType = 0; callType < kNumCallTypes; ++callType) {
+      auto key = std::make_pair(
+          static_cast<sai_api_t>(api), static_cast<SaiApiCallType>(callType));
+      auto threadLatencies = latencies[index(key.first, key.second)].load();
+      if (threadLatencies.count) {
+        (*exited)[key].merge(threadLatencies);
+      }
+    }
+  }
+}
+
+SaiApiCallProfiler* SaiApiCallProfiler::getInstance() {
+  // Leaked, so that threads exiting after static destruction can still fold
+  // their latencies in
+  static auto* profiler = new SaiApiCallProfiler();
+  return profiler;
+}
+
+void SaiApiCallProfiler::record(
+    sai_api_t api,
+    SaiApiCallType callType,
+    std::chrono::steady_clock::duration duration) {
+  if (UNLIKELY(api >= kNumApis)) {
+    return;
+  }
+  auto usecs =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  threadLatencies_->latencies[index(api, callType)].record(
+      std::max<int64_t>(usecs, 0));
+}
+
+SaiApiCallProfiler::Snapshot SaiApiCallProfiler::getSnapshot() const {
+  // A thread exiting while we walk may be missed by this snapshot, but it is
+  // never counted twice: it leaves the walk before it folds its latencies
+  // into exitedThreadLatencies_.
+  auto snapshot = exitedThreadLatencies_.copy();
+  auto threads = threadLatencies_.accessAllThreads();
+  for (const auto& thread : threads) {
+    for (size_t api = 0; api < kNumApis; ++api) {
+      for (size_t callType = 0; callType < kNumCallTypes; ++callType) {
+        auto key = std::make_pair(
+            static_cast<sai_api_t>(api),
+            static_cast<SaiApiCallType>(callType));
+        auto threadLatencies =
+            thread.latencies[index(key.first, key.second)].load();
+        if (threadLatencies.count) {
+          snapshot[key].merge(threadLatencies);
+        }
+      }
+    }
+  }
+  return snapshot;
+}
+
+std::string SaiApiCallProfiler::dump() const {
+  std::string out = fmt::format(
+      "{:<20} {:<12} {:>12} {:>10} {:>10} {:>10} {:>10}\n",
+      "api",
+      "call",
+      "count",
+      "avg_us",
+      "p50_us",
+      "p99_us",
+      "max_us");
+  for (const auto& [key, latencies] : getSnapshot()) {
+    out += fmt::format(
+        "{:<20} {:<12} {:>12} {:>10} {:>10} {:>10} {:>10}\n",
+        saiApiTypeToString(key.first).str(),
+        saiApiCallTypeToString(key.second).str(),
+        latencies.count,
+        latencies.totalUsecs / latencies.count,
+        latencies.percentileUsecs(50),
+        latencies.percentileUsecs(99),
+        latencies.maxUsecs);
+  }
+  return out;
+}
+
+} // namespace facebook::fboss
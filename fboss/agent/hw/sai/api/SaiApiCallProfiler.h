@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/lib/FunctionCallTimeReporter.h"
+
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
+#include <folly/ThreadLocal.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+
+extern "C" {
+#include <sai.h>
+}
+
+DECLARE_bool(enable_sai_call_latency_stats);
+
+namespace facebook::fboss {
+
+enum class SaiApiCallType : uint8_t {
+  CREATE,
+  REMOVE,
+  GET_ATTRIBUTE,
+  SET_ATTRIBUTE,
+  BULK_SET_ATTRIBUTE,
+  GET_STATS,
+  CLEAR_STATS,
+  NUM_CALL_TYPES,
+};
+
+folly::StringPiece saiApiCallTypeToString(SaiApiCallType callType);
+
+/*
+ * Latency histograms of SAI calls, per SAI api and call type.
+ *
+ * Calls are recorded in histograms owned by the calling thread, with relaxed
+ * atomic stores and no locking, so recording stays cheap enough to leave on
+ * in production. Histograms of all threads are only merged when read, i.e.
+ * by the periodic stats update and on demand over thrift.
+ */
+class SaiApiCallProfiler {
+ public:
+  // Bucket 0 counts calls under 1us, bucket i > 0 calls in [2^(i-1), 2^i)us.
+  // The last bucket also counts anything slower.
+  static constexpr size_t kNumBuckets = 32;
+
+  struct Latencies {
+    std::array<uint64_t, kNumBuckets> buckets{};
+    uint64_t count{0};
+    uint64_t totalUsecs{0};
+    uint64_t maxUsecs{0};
+
+    void merge(const Latencies& other);
+    // Upper bound of the bucket holding the given percentile
+    uint64_t percentileUsecs(double percentile) const;
+  };
+  using Snapshot =
+      std::map<std::pair<sai_api_t, SaiApiCallType>, Latencies>;
+
+  static SaiApiCallProfiler* getInstance();
+
+  void record(
+      sai_api_t api,
+      SaiApiCallType callType,
+      std::chrono::steady_clock::duration duration);
+
+  // Merged latencies of all threads, for apis and calls seen so far
+  Snapshot getSnapshot() const;
+  std::string dump() const;
+
+ private:
+  static constexpr size_t kNumApis = SAI_API_MAX;
+  static constexpr size_t kNumCallTypes =
+      static_cast<size_t>(SaiApiCallType::NUM_CALL_TYPES);
+
+  // Written only by the owning thread, read by any
+  struct AtomicLatencies {
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalUsecs{0};
+    std::atomic<uint64_t> maxUsecs{0};
+
+    void record(uint64_t usecs);
+    Latencies load() const;
+  };
+
+  struct ThreadLatencies {
+    explicit ThreadLatencies(SaiApiCallProfiler* profiler)
+        : profiler(profiler) {}
+    // Folds this thread's latencies into exitedThreadLatencies_
+    ~ThreadLatencies();
+
+    SaiApiCallProfiler* profiler;
+    std::array<AtomicLatencies, kNumApis * kNumCallTypes> latencies;
+  };
+  struct ThreadLatenciesTag {};
+
+  static size_t index(sai_api_t api, SaiApiCallType callType) {
+    return api * kNumCallTypes + static_cast<size_t>(callType);
+  }
+
+  folly::ThreadLocal<
+      ThreadLatencies,
+      ThreadLatenciesTag,
+      folly::AccessModeStrict>
+      threadLatencies_{[this]() { return new ThreadLatencies(this); }};
+  folly::Synchronized<Snapshot> exitedThreadLatencies_;
+};
+
+/*
+ * Times the SAI call made in its scope, for both SaiApiCallProfiler and
+ * FunctionCallTimeReporter.
+ */
+class SaiApiCallTimer {
+ public:
+  SaiApiCallTimer(sai_api_t api, SaiApiCallType callType)
+      : api_(api),
+        callType_(callType),
+        enabled_(FLAGS_enable_sai_call_latency_stats) {
+    FunctionCallTimeReporter::callStart();
+    if (enabled_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+  ~SaiApiCallTimer() {
+    FunctionCallTimeReporter::callEnd();
+    if (enabled_) {
+      SaiApiCallProfiler::getInstance()->record(
+          api_, callType_, std::chrono::steady_clock::now() - start_);
+    }
+  }
+  SaiApiCallTimer(const SaiApiCallTimer&) = delete;
+  SaiApiCallTimer& operator=(const SaiApiCallTimer&) = delete;
+
+ private:
+  sai_api_t api_;
+  SaiApiCallType callType_;
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace facebook::fboss
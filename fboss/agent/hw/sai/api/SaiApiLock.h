@@ -32,9 +32,20 @@ class SaiApiLock {
 
  public:
   static std::shared_ptr<SaiApiLock> getInstance();
+  /*
+   * Off by default, so every SAI api call is serialized. Nothing in the agent
+   * turns it on: the SAI adaptor, not the ASIC, decides whether concurrent
+   * calls are safe, and HwAsic has no feature for it. A platform whose vendor
+   * adaptor supports concurrent calls opts in by calling this before
+   * SaiSwitch init, which also lets SaiStore::reload() reload object types
+   * in parallel on warm boot.
+   */
   void setAdaptorIsThreadSafe(bool isThreadSafe) {
     adaptorIsThreadSafe_ = isThreadSafe;
   }
+  bool isAdaptorThreadSafe() const {
+    return adaptorIsThreadSafe_;
+  }
   ScopedApiLock lock() const {
     return {mutex_, adaptorIsThreadSafe_};
   }
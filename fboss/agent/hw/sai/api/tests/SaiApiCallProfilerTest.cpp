@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiCallProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::fboss;
+using namespace std::chrono_literals;
+
+namespace {
+SaiApiCallProfiler::Latencies getLatencies(
+    sai_api_t api,
+    SaiApiCallType callType) {
+  auto snapshot = SaiApiCallProfiler::getInstance()->getSnapshot();
+  auto it = snapshot.find(std::make_pair(api, callType));
+  return it == snapshot.end() ? SaiApiCallProfiler::Latencies() : it->second;
+}
+} // namespace
+
+TEST(SaiApiCallProfilerTest, recordAcrossThreads) {
+  auto profiler = SaiApiCallProfiler::getInstance();
+  auto before = getLatencies(SAI_API_WRED, SaiApiCallType::SET_ATTRIBUTE);
+  // Recorded by a thread that exits before we look
+  std::thread([profiler]() {
+    profiler->record(SAI_API_WRED, SaiApiCallType::SET_ATTRIBUTE, 5us);
+    profiler->record(SAI_API_WRED, SaiApiCallType::SET_ATTRIBUTE, 100us);
+  }).join();
+  profiler->record(SAI_API_WRED, SaiApiCallType::SET_ATTRIBUTE, 3ms);
+
+  auto after = getLatencies(SAI_API_WRED, SaiApiCallType::SET_ATTRIBUTE);
+  EXPECT_EQ(before.count + 3, after.count);
+  EXPECT_EQ(before.totalUsecs + 3105, after.totalUsecs);
+  EXPECT_GE(after.maxUsecs, 3000);
+}
+
+TEST(SaiApiCallProfilerTest, percentiles) {
+  SaiApiCallProfiler::Latencies latencies;
+  // 99 calls in [4, 8)us and 1 in [1024, 2048)us
+  latencies.buckets[3] = 99;
+  latencies.buckets[11] = 1;
+  latencies.count = 100;
+  latencies.maxUsecs = 1500;
+  EXPECT_EQ(8, latencies.percentileUsecs(50));
+  EXPECT_EQ(8, latencies.percentileUsecs(98));
+  EXPECT_EQ(1500, latencies.percentileUsecs(99));
+  EXPECT_EQ(1500, latencies.percentileUsecs(100));
+}
+
+TEST(SaiApiCallProfilerTest, timer) {
+  auto before = getLatencies(SAI_API_SCHEDULER, SaiApiCallType::CREATE);
+  { SaiApiCallTimer timer(SAI_API_SCHEDULER, SaiApiCallType::CREATE); }
+  auto after = getLatencies(SAI_API_SCHEDULER, SaiApiCallType::CREATE);
+  EXPECT_EQ(before.count + 1, after.count);
+}
@@ -2,8 +2,6 @@
 
 #pragma once
 
-#include <boost/signals2.hpp>
-
 #include "fboss/agent/hw/sai/api/BridgeApi.h"
 #include "fboss/agent/hw/sai/api/FdbApi.h"
 #include "fboss/agent/hw/sai/api/NeighborApi.h"
@@ -92,25 +90,57 @@ class SaiObjectEventPublisher {
   using PublisherObject = const SaiObject<PublishedObjectTrait>;
 
  private:
+  using SubscriberNode = SaiObjectEventSubscriberNode<PublishedObjectTrait>;
+
+  /*
+   * Subscribers to one publisher key, in an intrusive list threaded through
+   * the subscribers themselves. Subscribers unlink themselves when destroyed,
+   * so they are never notified after they are gone.
+   */
   class Subscription {
-    // a subscription, using boost signals since they are fast in issuing
-    // notifications to large number of subscribers, thread safe, re-entrant.
-    template <typename T>
-    using CreateSignal =
-        boost::signals2::signal<void(std::shared_ptr<const T>)>;
-    CreateSignal<SaiObject<PublishedObjectTrait>> createSignal_;
-    using CreateSignalSlot =
-        typename CreateSignal<SaiObject<PublishedObjectTrait>>::slot_type;
-
-    using RemoveSignal = boost::signals2::signal<void()>;
-    RemoveSignal removeSignal_;
-    using RemoveSignalSlot = typename RemoveSignal::slot_type;
-
-    using LinkDownSignal = boost::signals2::signal<void()>;
-    LinkDownSignal linkDownSignal_;
-    using LinkDownSignalSlot = typename LinkDownSignal::slot_type;
-
-    friend class SaiObjectEventPublisher<PublishedObjectTrait>;
+   public:
+    Subscription() = default;
+    ~Subscription() {
+      // every subscriber holds the subscription, so none can be left
+      DCHECK(!head_.isLinked());
+    }
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    void add(Subscriber* subscriber) {
+      auto* node = subscriber->subscriberNode();
+      node->setSequence(nextSequence_++);
+      node->insertAfter(head_.prev());
+    }
+
+    /*
+     * Invoke notify on every subscriber. Subscribers may subscribe or go
+     * away from within notify. A cursor node kept after the subscriber being
+     * notified marks where to resume, whichever nodes get unlinked. Those
+     * who subscribed during notification are skipped, they were told the
+     * publisher state when subscribing.
+     */
+    template <typename NotifyFn>
+    void notifyAll(NotifyFn&& notify) {
+      auto endSequence = nextSequence_;
+      SubscriberNode cursor;
+      auto* node = head_.next();
+      while (node != &head_) {
+        auto* subscriber = node->subscriber();
+        if (!subscriber || node->sequence() >= endSequence) {
+          node = node->next();
+          continue;
+        }
+        cursor.insertAfter(node);
+        notify(subscriber);
+        node = cursor.next();
+        cursor.unlink();
+      }
+    }
+
+   private:
+    SubscriberNode head_;
+    uint64_t nextSequence_{0};
   };
 
  public:
@@ -121,30 +151,12 @@ class SaiObjectEventPublisher {
 
     auto subscription = result.first;
 
-    // add a subscriber here for create or remove notifications.
     // subscriptions are self managed, because they're put in ref map.
-    // further if subscriber gets removed, its not notified because
-    // "track_foreign" will delete its slot in general following principles hold
     // 1. a subscription exists only if at least one subscriber exists
     // 2. a subscription is deleted if no subscriber exists
-    // 3. a slot for subscriber in subscription is freed if subscriber is
-    // removed.
-    // 4. a subscriber is not notified only if it exists
-    typename Subscription::CreateSignalSlot createSignalSlot = std::bind(
-        &Subscriber::afterCreate, subscriber.get(), std::placeholders::_1);
-    subscription->createSignal_.connect(
-        createSignalSlot.track_foreign(subscriberWeakPtr));
-
-    typename Subscription::RemoveSignalSlot removeSignalSlot =
-        std::bind(&Subscriber::beforeRemove, subscriber.get());
-    subscription->removeSignal_.connect(
-        removeSignalSlot.track_foreign(subscriberWeakPtr));
-
-    typename Subscription::LinkDownSignalSlot linkDownSignalSlot =
-        std::bind(&Subscriber::linkDown, subscriber.get());
-    subscription->linkDownSignal_.connect(
-        linkDownSignalSlot.track_foreign(subscriberWeakPtr));
-
+    // 3. a subscriber leaves the subscription when it is removed
+    // 4. a subscriber is notified only if it exists
+    subscription->add(subscriber.get());
     subscriber->saveSubscription(subscription);
     XLOGF(
         DBG3,
@@ -160,31 +172,36 @@ class SaiObjectEventPublisher {
 
   void notifyCreate(Key key, const std::shared_ptr<PublisherObject> object) {
     livePublishers_.emplace(key, object);
-    auto subscription = subscriptions_.get(key);
+    // hold the subscription, in case its last subscriber goes away while
+    // being notified
+    auto subscription = subscriptions_.ref(key);
     if (!subscription) {
       return;
     }
     XLOGF(DBG3, "publisher object {} notify create", key);
-    subscription->createSignal_(object);
+    subscription->notifyAll(
+        [&object](Subscriber* subscriber) { subscriber->afterCreate(object); });
   }
 
   void notifyDelete(Key key) {
     XLOGF(DBG3, "publisher object {} notify remove", key);
     livePublishers_.erase(key);
-    auto subscription = subscriptions_.get(key);
+    auto subscription = subscriptions_.ref(key);
     if (!subscription) {
       return;
     }
-    subscription->removeSignal_();
+    subscription->notifyAll(
+        [](Subscriber* subscriber) { subscriber->beforeRemove(); });
   }
 
   void notifyLinkDown(Key key) {
     XLOGF(DBG3, "publisher object {} notify link down", key);
-    auto subscription = subscriptions_.get(key);
+    auto subscription = subscriptions_.ref(key);
     if (!subscription) {
       return;
     }
-    subscription->linkDownSignal_();
+    subscription->notifyAll(
+        [](Subscriber* subscriber) { subscriber->linkDown(); });
   }
 
  private:
@@ -14,7 +14,10 @@ SaiObjectEventSubscriber<PublishedObjectTrait>::SaiObjectEventSubscriber(
     : publisherAttrs_(attr) {}
 
 template <typename PublishedObjectTrait>
-SaiObjectEventSubscriber<PublishedObjectTrait>::~SaiObjectEventSubscriber() {}
+SaiObjectEventSubscriber<PublishedObjectTrait>::~SaiObjectEventSubscriber() {
+  // leave the subscriber list before releasing the subscription holding it
+  subscriberNode_.unlink();
+}
 
 template <typename PublishedObjectTrait>
 typename SaiObjectEventSubscriber<PublishedObjectTrait>::PublisherObjectWeakPtr
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <any>
+#include <cstdint>
 #include <memory>
 
 #include "fboss/agent/hw/sai/store/Traits.h"
@@ -15,6 +16,69 @@ template <typename>
 class SaiObject;
 
 namespace detail {
+template <typename PublisherObjectTraits>
+struct SaiObjectEventSubscriber;
+
+/*
+ * Node of the intrusive, circular list of subscribers to a publisher object.
+ * Every subscriber embeds one, so subscribing and notifying never allocate.
+ * A node unlinks itself when destroyed. The list head, and the cursors
+ * placed by the publisher while notifying, are nodes without a subscriber.
+ */
+template <typename PublisherObjectTraits>
+class SaiObjectEventSubscriberNode {
+ public:
+  using Subscriber = SaiObjectEventSubscriber<PublisherObjectTraits>;
+
+  explicit SaiObjectEventSubscriberNode(Subscriber* subscriber = nullptr)
+      : subscriber_(subscriber) {}
+  ~SaiObjectEventSubscriberNode() {
+    unlink();
+  }
+  SaiObjectEventSubscriberNode(const SaiObjectEventSubscriberNode&) = delete;
+  SaiObjectEventSubscriberNode& operator=(
+      const SaiObjectEventSubscriberNode&) = delete;
+
+  bool isLinked() const {
+    return next_ != this;
+  }
+  void insertAfter(SaiObjectEventSubscriberNode* node) {
+    unlink();
+    prev_ = node;
+    next_ = node->next_;
+    next_->prev_ = this;
+    node->next_ = this;
+  }
+  void unlink() {
+    prev_->next_ = next_;
+    next_->prev_ = prev_;
+    prev_ = next_ = this;
+  }
+
+  SaiObjectEventSubscriberNode* next() const {
+    return next_;
+  }
+  SaiObjectEventSubscriberNode* prev() const {
+    return prev_;
+  }
+  Subscriber* subscriber() const {
+    return subscriber_;
+  }
+  // Order in which subscribers joined the list
+  uint64_t sequence() const {
+    return sequence_;
+  }
+  void setSequence(uint64_t sequence) {
+    sequence_ = sequence;
+  }
+
+ private:
+  SaiObjectEventSubscriberNode* prev_{this};
+  SaiObjectEventSubscriberNode* next_{this};
+  Subscriber* subscriber_;
+  uint64_t sequence_{0};
+};
+
 /*
  * A subscriber interface as used by  publisher
  * afterCreate and beforeRemove methods are invoked by publishers after and
@@ -50,6 +114,10 @@ struct SaiObjectEventSubscriber {
     subscription_ = std::move(subscription);
   }
 
+  SaiObjectEventSubscriberNode<PublisherObjectTraits>* subscriberNode() {
+    return &subscriberNode_;
+  }
+
  protected:
   void setPublisherObject(PublisherObjectSharedPtr object = nullptr);
 
@@ -60,6 +128,7 @@ struct SaiObjectEventSubscriber {
   // dependencies in object, publisher, and subscriber types investigate and
   // eliminate this any type with proper type
   std::any subscription_;
+  SaiObjectEventSubscriberNode<PublisherObjectTraits> subscriberNode_{this};
 };
 
 /* A single subscriber for a publisher using particular published object trait.
@@ -9,6 +9,19 @@
  */
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    8,
+    "Threads reloading SaiStore object types in parallel, used only if the "
+    "platform has marked the SAI adaptor thread safe via "
+    "SaiApiLock::setAdaptorIsThreadSafe()");
 
 namespace facebook::fboss {
 
@@ -27,18 +40,38 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  auto reloadStore = [adapterKeysJson,
+                      adapterKeys2AdapterHostKeyJson](auto& store) {
+    const folly::dynamic* adapterKeys = adapterKeysJson
+        ? adapterKeysJson->get_ptr(store.objectTypeName())
+        : nullptr;
+    const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
+        ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
+        : nullptr;
+
+    store.reload(adapterKeys, adapterHostKeys);
+  };
+  if (!SaiApiLock::getInstance()->isAdaptorThreadSafe() ||
+      FLAGS_sai_store_reload_threads <= 1) {
+    tupleForEach(reloadStore, stores_);
+    return;
+  }
+  // Each object store only reads its own object type from the adapter, so
+  // stores can be reloaded concurrently once SAI calls need not be serialized
+  folly::CPUThreadPoolExecutor executor(
+      FLAGS_sai_store_reload_threads,
+      std::make_shared<folly::NamedThreadFactory>("SaiStoreReload"));
+  std::vector<folly::Future<folly::Unit>> reloads;
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
-        const folly::dynamic* adapterKeys = adapterKeysJson
-            ? adapterKeysJson->get_ptr(store.objectTypeName())
-            : nullptr;
-        const folly::dynamic* adapterHostKeys = adapterKeys2AdapterHostKeyJson
-            ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
-            : nullptr;
-
-        store.reload(adapterKeys, adapterHostKeys);
+      [&executor, &reloadStore, &reloads](auto& store) {
+        reloads.push_back(folly::via(
+            &executor, [&reloadStore, &store]() { reloadStore(store); }));
       },
       stores_);
+  for (auto& result : folly::collectAll(std::move(reloads)).get()) {
+    // rethrows the first failure, if any
+    result.value();
+  }
 }
 
 void SaiStore::release() {
@@ -30,6 +30,8 @@
 #include <optional>
 #include <sstream>
 #include <type_traits>
+#include <unordered_map>
+#include <variant>
 
 extern "C" {
 #include <sai.h>
@@ -60,6 +62,14 @@ class SaiObjectStore {
       SaiObjectWithCounters<SaiObjectTraits>,
       SaiObject<SaiObjectTraits>>::type;
   using ObjectTraits = SaiObjectTraits;
+  // Adapter host keys saved at warm boot, for objects whose adapter host key
+  // can not be recovered from the adapter
+  using AdapterHostKeyIndex = std::conditional_t<
+      AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value,
+      std::monostate,
+      std::unordered_map<
+          typename SaiObjectTraits::AdapterKey,
+          typename SaiObjectTraits::AdapterHostKey>>;
 
   explicit SaiObjectStore(sai_object_id_t switchId) : switchId_(switchId) {}
   SaiObjectStore() {}
@@ -147,8 +157,20 @@ class SaiObjectStore {
               }),
           keys.end());
     }
+    // Index the saved adapter host keys once, rather than converting every
+    // adapter key to a string to look it up in the json
+    std::optional<AdapterHostKeyIndex> adapterHostKeys;
+    if constexpr (!AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value) {
+      if (adapterKeys2AdapterHostKey) {
+        adapterHostKeys =
+            adapterHostKeyIndexFromFollyDynamic(*adapterKeys2AdapterHostKey);
+      }
+    }
+    objects_.reserve(objects_.size() + keys.size());
+    warmBootHandles_.reserve(warmBootHandles_.size() + keys.size());
     for (const auto k : keys) {
-      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
+      ObjectType obj = getObject(
+          k, adapterHostKeys ? &adapterHostKeys.value() : nullptr);
       auto adapterHostKey = obj.adapterHostKey();
       XLOGF(DBG5, "SaiStore reloaded {}", obj);
       auto ins = objects_.refOrInsert(adapterHostKey, std::move(obj));
@@ -316,6 +338,7 @@ class SaiObjectStore {
   static std::vector<typename SaiObjectTraits::AdapterKey>
   adapterKeysFromFollyDynamic(const folly::dynamic& json) {
     std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    adapterKeys.reserve(json.size());
     for (const auto& obj : json) {
       adapterKeys.push_back(fromFollyDynamic<SaiObjectTraits>(obj));
     }
@@ -403,9 +426,9 @@ class SaiObjectStore {
  private:
   ObjectType getObject(
       typename ObjectTraits::AdapterKey key,
-      const folly::dynamic* adapterKey2AdapterHostKey) {
+      const AdapterHostKeyIndex* adapterHostKeys) {
     if constexpr (!AdapterHostKeyWarmbootRecoverable<SaiObjectTraits>::value) {
-      auto ahk = getAdapterHostKey(key, adapterKey2AdapterHostKey);
+      auto ahk = getAdapterHostKey(key, adapterHostKeys);
       if (ahk) {
         return ObjectType(key, ahk.value());
       } else {
@@ -458,15 +481,31 @@ class SaiObjectStore {
 
   std::optional<typename SaiObjectTraits::AdapterHostKey> getAdapterHostKey(
       const typename SaiObjectTraits::AdapterKey& key,
-      const folly::dynamic* adapterKeys2AdapterHostKey) {
-    if (!adapterKeys2AdapterHostKey) {
+      const AdapterHostKeyIndex* adapterHostKeys) {
+    if (!adapterHostKeys) {
       return std::nullopt;
     }
-    auto iter = adapterKeys2AdapterHostKey->find(folly::to<std::string>(key));
-    CHECK(iter != adapterKeys2AdapterHostKey->items().end());
+    auto iter = adapterHostKeys->find(key);
+    CHECK(iter != adapterHostKeys->end());
+    return iter->second;
+  }
 
-    return SaiObject<SaiObjectTraits>::follyDynamicToAdapterHostKey(
-        iter->second);
+  static AdapterHostKeyIndex adapterHostKeyIndexFromFollyDynamic(
+      const folly::dynamic& adapterKeys2AdapterHostKey) {
+    static_assert(
+        AdapterKeyIsObjectId<SaiObjectTraits>::value,
+        "adapter host keys are only saved for objects keyed by object id");
+    AdapterHostKeyIndex adapterHostKeys;
+    adapterHostKeys.reserve(adapterKeys2AdapterHostKey.size());
+    for (const auto& [adapterKey, adapterHostKey] :
+         adapterKeys2AdapterHostKey.items()) {
+      adapterHostKeys.emplace(
+          typename SaiObjectTraits::AdapterKey{
+              folly::to<sai_object_id_t>(adapterKey.stringPiece())},
+          SaiObject<SaiObjectTraits>::follyDynamicToAdapterHostKey(
+              adapterHostKey));
+    }
+    return adapterHostKeys;
   }
 
   std::optional<sai_object_id_t> switchId_;
@@ -508,6 +547,8 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   * Object types are reloaded in parallel only if the platform opted in to
+   * SaiApiLock::setAdaptorIsThreadSafe(), otherwise one at a time.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
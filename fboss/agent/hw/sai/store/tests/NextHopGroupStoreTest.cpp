@@ -9,6 +9,7 @@
  */
 
 #include "fboss/agent/hw/sai/api/NextHopGroupApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
@@ -246,6 +247,40 @@ TEST_F(NextHopGroupStoreTest, nextHopGroupJson) {
   EXPECT_EQ(iter->second, json);
 }
 
+TEST_F(NextHopGroupStoreTest, nextHopGroupWarmBootReload) {
+  auto nextHopGroupId = createNextHopGroup();
+  folly::IPAddress ip1{"10.10.10.1"};
+  folly::IPAddress ip2{"10.10.10.2"};
+  createNextHopGroupMember(nextHopGroupId, createNextHop(ip1), 8);
+  createNextHopGroupMember(nextHopGroupId, createNextHop(ip2), 9);
+
+  SaiStore s(0);
+  s.reload();
+  auto adapterKeys = s.adapterKeysFollyDynamic();
+  auto adapterKeys2AdapterHostKeys =
+      s.adapterKeys2AdapterHostKeysFollyDynamic();
+  s.exitForWarmBoot();
+
+  SaiNextHopGroupTraits::AdapterHostKey k;
+  k.insert(std::make_pair(SaiIpNextHopTraits::AdapterHostKey{42, ip1}, 8));
+  k.insert(std::make_pair(SaiIpNextHopTraits::AdapterHostKey{42, ip2}, 9));
+  for (auto adaptorIsThreadSafe : {false, true}) {
+    // Object stores are reloaded in parallel with a thread safe adaptor
+    SaiApiLock::getInstance()->setAdaptorIsThreadSafe(adaptorIsThreadSafe);
+    SaiStore s2(0);
+    s2.reload(&adapterKeys, &adapterKeys2AdapterHostKeys);
+    SaiApiLock::getInstance()->setAdaptorIsThreadSafe(false);
+    auto& store = s2.get<SaiNextHopGroupTraits>();
+    EXPECT_EQ(store.size(), 1);
+    auto got = store.get(k);
+    ASSERT_TRUE(got);
+    EXPECT_EQ(got->adapterKey(), nextHopGroupId);
+    EXPECT_EQ(s2.get<SaiNextHopGroupMemberTraits>().size(), 2);
+    EXPECT_EQ(s2.get<SaiIpNextHopTraits>().size(), 2);
+    s2.exitForWarmBoot();
+  }
+}
+
 TEST_F(NextHopGroupStoreTest, bulkSetNextHopGroup) {
 #if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
   // Create a next hop group
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber-defs.h"
+#include "fboss/agent/hw/sai/store/SaiObjectEventSubscriber.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+using Traits = SaiVlanRouterInterfaceTraits;
+
+const InterfaceID kIntf(1);
+
+class TestSubscriber : public detail::SaiObjectEventSubscriber<Traits> {
+ public:
+  TestSubscriber(int id, std::vector<int>* notified)
+      : detail::SaiObjectEventSubscriber<Traits>(kIntf),
+        id_(id),
+        notified_(notified) {}
+
+  void afterCreate(PublisherObjectSharedPtr /* object */) override {
+    notify();
+  }
+  void beforeRemove() override {
+    notify();
+  }
+  void linkDown() override {
+    notify();
+  }
+
+  // Invoked on every notification, may destroy this subscriber
+  std::function<void()> onNotify;
+
+ private:
+  void notify() {
+    notified_->push_back(id_);
+    if (onNotify) {
+      // the callback may destroy this subscriber, and with it onNotify
+      auto callback = onNotify;
+      callback();
+    }
+  }
+
+  int id_;
+  std::vector<int>* notified_;
+};
+} // namespace
+
+class SaiObjectEventPublisherTest : public ::testing::Test {
+ public:
+  std::shared_ptr<TestSubscriber> subscribe(int id) {
+    auto subscriber = std::make_shared<TestSubscriber>(id, &notified);
+    publisher.subscribe(subscriber);
+    return subscriber;
+  }
+
+  detail::SaiObjectEventPublisher<Traits> publisher;
+  std::vector<int> notified;
+};
+
+TEST_F(SaiObjectEventPublisherTest, notifyAllInSubscribeOrder) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  auto s3 = subscribe(3);
+  publisher.notifyCreate(kIntf, nullptr);
+  publisher.notifyLinkDown(kIntf);
+  publisher.notifyDelete(kIntf);
+  EXPECT_EQ(notified, std::vector<int>({1, 2, 3, 1, 2, 3, 1, 2, 3}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, removeNextSubscriberDuringNotify) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  auto s3 = subscribe(3);
+  s1->onNotify = [&s2]() { s2.reset(); };
+  publisher.notifyCreate(kIntf, nullptr);
+  EXPECT_EQ(notified, std::vector<int>({1, 3}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, removeSelfDuringNotify) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  auto s3 = subscribe(3);
+  s2->onNotify = [&s2]() { s2.reset(); };
+  publisher.notifyDelete(kIntf);
+  publisher.notifyCreate(kIntf, nullptr);
+  EXPECT_EQ(notified, std::vector<int>({1, 2, 3, 1, 3}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, removeAllSubscribersDuringNotify) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  s1->onNotify = [&s1, &s2]() {
+    s2.reset();
+    s1.reset();
+  };
+  publisher.notifyDelete(kIntf);
+  EXPECT_EQ(notified, std::vector<int>({1}));
+
+  // the subscription went away with its last subscriber, a new one works
+  notified.clear();
+  auto s3 = subscribe(3);
+  publisher.notifyCreate(kIntf, nullptr);
+  EXPECT_EQ(notified, std::vector<int>({3}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, subscribeDuringNotify) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  std::shared_ptr<TestSubscriber> s3;
+  s1->onNotify = [this, &s1, &s3]() {
+    s1->onNotify = nullptr;
+    s3 = subscribe(3);
+  };
+  publisher.notifyCreate(kIntf, nullptr);
+  // s3 learns the publisher is live when subscribing, and is not notified
+  // of the same creation a second time
+  EXPECT_EQ(notified, std::vector<int>({1, 3, 2}));
+
+  notified.clear();
+  publisher.notifyDelete(kIntf);
+  EXPECT_EQ(notified, std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(SaiObjectEventPublisherTest, subscribeAndRemoveDuringNotify) {
+  auto s1 = subscribe(1);
+  auto s2 = subscribe(2);
+  std::shared_ptr<TestSubscriber> s3;
+  s2->onNotify = [this, &s1, &s2, &s3]() {
+    s1.reset();
+    s3 = subscribe(3);
+    s2.reset();
+  };
+  publisher.notifyDelete(kIntf);
+  EXPECT_EQ(notified, std::vector<int>({1, 2}));
+
+  notified.clear();
+  publisher.notifyCreate(kIntf, nullptr);
+  EXPECT_EQ(notified, std::vector<int>({3}));
+}
@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/hw/sai/switch/SaiHandler.h"
 
+#include "fboss/agent/hw/sai/api/SaiApiCallProfiler.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 #include <folly/logging/xlog.h>
@@ -56,4 +57,8 @@ void SaiHandler::diagCmd(
   result = diagCmdServer_.diagCmd(std::move(cmd), std::move(client));
 }
 
+void SaiHandler::dumpSaiApiCallLatencies(std::string& out) {
+  out = SaiApiCallProfiler::getInstance()->dump();
+}
+
 } // namespace facebook::fboss
@@ -37,6 +37,8 @@ class SaiHandler : virtual public SaiCtrlSvIf, public ThriftHandler {
       int16_t serverTimeoutMsecs = 0,
       bool bypassFilter = false) override;
 
+  void dumpSaiApiCallLatencies(std::string& out) override;
+
  private:
   const SaiSwitch* hw_;
   StreamingDiagShellServer diagShell_;
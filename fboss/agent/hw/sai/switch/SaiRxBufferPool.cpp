@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/switch/SaiRxBufferPool.h"
+
+#include <fb303/ServiceData.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <cstring>
+
+DEFINE_int32(
+    sai_rx_buffer_pool_size,
+    4096,
+    "Number of buffers in the pool SAI rx packets are copied into");
+DEFINE_int32(
+    sai_rx_buffer_size,
+    2048,
+    "Size of the buffers of the SAI rx buffer pool, larger packets are "
+    "copied into heap buffers");
+
+namespace facebook::fboss {
+
+SaiRxBufferPool::SaiRxBufferPool(uint32_t numBuffers, uint32_t bufferSize)
+    : numBuffers_(numBuffers),
+      bufferSize_(bufferSize),
+      slab_(new uint8_t[size_t(numBuffers) * bufferSize]),
+      freeBuffers_(numBuffers) {
+  for (uint32_t i = 0; i < numBuffers_; i++) {
+    freeBuffers_.blockingWrite(i);
+  }
+}
+
+SaiRxBufferPool::~SaiRxBufferPool() {
+  CHECK_EQ(numFreeBuffers(), numBuffers_)
+      << "Rx buffers still in use when destroying the pool";
+}
+
+SaiRxBufferPool* SaiRxBufferPool::get() {
+  static SaiRxBufferPool* pool = new SaiRxBufferPool(
+      FLAGS_sai_rx_buffer_pool_size, FLAGS_sai_rx_buffer_size);
+  return pool;
+}
+
+std::unique_ptr<folly::IOBuf> SaiRxBufferPool::copyPacket(
+    const void* data,
+    size_t length) {
+  uint32_t index;
+  if (length > bufferSize_ || !freeBuffers_.read(index)) {
+    fb303::fbData->incrementCounter("sai_rx_buffer_pool.heap_alloc");
+    return folly::IOBuf::copyBuffer(data, length);
+  }
+  auto* buf = slab_.get() + size_t(index) * bufferSize_;
+  std::memcpy(buf, data, length);
+  return folly::IOBuf::takeOwnership(
+      buf, bufferSize_, length, freeBuffer, this);
+}
+
+void SaiRxBufferPool::freeBuffer(void* buf, void* pool) {
+  auto* self = static_cast<SaiRxBufferPool*>(pool);
+  auto index = (static_cast<uint8_t*>(buf) - self->slab_.get()) /
+      self->bufferSize_;
+  // Can't fail, the queue has room for every buffer
+  self->freeBuffers_.write(index);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include <folly/io/IOBuf.h>
+
+#include <memory>
+
+namespace facebook::fboss {
+
+/*
+ * Pool of fixed size buffers for packets received through SAI.
+ *
+ * The SDK only lends us the packet buffer for the duration of the rx
+ * callback, so the packet is copied once into a buffer of the pool. The
+ * returned IOBuf owns that buffer: clones of it share the buffer and it goes
+ * back to the pool when the last one is destroyed, from whichever thread
+ * that happens on. Consumers that defer work on the packet (captures, tun
+ * writes, queued handlers) can therefore keep a clone instead of copying.
+ *
+ * Packets larger than a pool buffer, or received while every buffer is in
+ * use, are copied into a heap allocated IOBuf instead.
+ */
+class SaiRxBufferPool {
+ public:
+  SaiRxBufferPool(uint32_t numBuffers, uint32_t bufferSize);
+  ~SaiRxBufferPool();
+
+  // Process wide pool sized by --sai_rx_buffer_pool_size and
+  // --sai_rx_buffer_size. Never destroyed, as packets may outlive SaiSwitch.
+  static SaiRxBufferPool* get();
+
+  std::unique_ptr<folly::IOBuf> copyPacket(const void* data, size_t length);
+
+  uint32_t bufferSize() const {
+    return bufferSize_;
+  }
+  uint32_t numBuffers() const {
+    return numBuffers_;
+  }
+  size_t numFreeBuffers() const {
+    return freeBuffers_.size();
+  }
+
+ private:
+  // Non-copyable
+  SaiRxBufferPool(const SaiRxBufferPool&) = delete;
+  SaiRxBufferPool& operator=(const SaiRxBufferPool&) = delete;
+
+  static void freeBuffer(void* buf, void* pool);
+
+  const uint32_t numBuffers_;
+  const uint32_t bufferSize_;
+  std::unique_ptr<uint8_t[]> slab_;
+  // Indices of the buffers not handed out
+  folly::MPMCQueue<uint32_t> freeBuffers_;
+};
+
+} // namespace facebook::fboss
@@ -12,23 +12,19 @@
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/switch/SaiRxBufferPool.h"
 
 #include <folly/io/IOBuf.h>
 
 namespace facebook::fboss {
 
-void freeRxPacket(void* /* ptr */, void* /* arg */) {
-  // The packet is on the stack, don't "free" it.
-}
-
 SaiRxPacket::SaiRxPacket(
     size_t buffer_size,
     const void* buffer,
     PortID portId,
     VlanID vlanId,
     cfg::PacketRxReason rxReason) {
-  buf_ = folly::IOBuf::takeOwnership(
-      const_cast<void*>(buffer), buffer_size, freeRxPacket, nullptr);
+  buf_ = SaiRxBufferPool::get()->copyPacket(buffer, buffer_size);
   len_ = buffer_size;
   srcPort_ = portId;
   srcVlan_ = vlanId;
@@ -41,8 +37,7 @@ SaiRxPacket::SaiRxPacket(
     AggregatePortID aggregatePortID,
     VlanID vlanId,
     cfg::PacketRxReason rxReason) {
-  buf_ = folly::IOBuf::takeOwnership(
-      const_cast<void*>(buffer), buffer_size, freeRxPacket, nullptr);
+  buf_ = SaiRxBufferPool::get()->copyPacket(buffer, buffer_size);
   len_ = buffer_size;
   srcAggregatePort_ = aggregatePortID;
   srcVlan_ = vlanId;
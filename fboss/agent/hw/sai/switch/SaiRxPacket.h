@@ -16,6 +16,11 @@
 
 namespace facebook::fboss {
 
+/*
+ * Packet received through the SAI rx callback. The SDK buffer is only valid
+ * during the callback, so the packet data is copied into a buffer of the
+ * SaiRxBufferPool, which the packet (and any clone of its IOBuf) owns.
+ */
 class SaiRxPacket : public RxPacket {
  public:
   SaiRxPacket(
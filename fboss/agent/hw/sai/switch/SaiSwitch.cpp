@@ -25,6 +25,7 @@
 #include "fboss/agent/hw/sai/api/HostifApi.h"
 #include "fboss/agent/hw/sai/api/HwWriteBehavior.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiCallProfiler.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
@@ -65,6 +66,7 @@
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "folly/MacAddress.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/logging/xlog.h>
 
 #include <chrono>
@@ -966,6 +968,26 @@ std::map<PortID, phy::PhyInfo> SaiSwitch::updateAllPhyInfoLocked() const {
   return returnPhyParams;
 }
 
+void SaiSwitch::publishSaiApiCallLatencies() const {
+  for (const auto& [key, latencies] :
+       SaiApiCallProfiler::getInstance()->getSnapshot()) {
+    auto prefix = folly::to<std::string>(
+        "sai.",
+        saiApiTypeToString(key.first),
+        ".",
+        saiApiCallTypeToString(key.second),
+        ".");
+    fb303::fbData->setCounter(prefix + "count", latencies.count);
+    fb303::fbData->setCounter(
+        prefix + "avg_us", latencies.totalUsecs / latencies.count);
+    fb303::fbData->setCounter(
+        prefix + "p50_us", latencies.percentileUsecs(50));
+    fb303::fbData->setCounter(
+        prefix + "p99_us", latencies.percentileUsecs(99));
+    fb303::fbData->setCounter(prefix + "max_us", latencies.maxUsecs);
+  }
+}
+
 void SaiSwitch::fetchL2Table(std::vector<L2EntryThrift>* l2Table) const {
   std::lock_guard<std::mutex> lock(saiSwitchMutex_);
   fetchL2TableLocked(lock, l2Table);
@@ -66,5 +66,6 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     managerTable_->counterManager().updateStats();
   }
+  publishSaiApiCallLatencies();
 }
 } // namespace facebook::fboss
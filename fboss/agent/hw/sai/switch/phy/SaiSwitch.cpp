@@ -25,5 +25,6 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     }
     ++portsIter;
   }
+  publishSaiApiCallLatencies();
 }
 } // namespace facebook::fboss
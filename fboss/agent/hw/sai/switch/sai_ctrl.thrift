@@ -14,4 +14,10 @@ service SaiCtrl extends ctrl.FbossCtrl {
     1: string input,
     2: ctrl.ClientInformation client,
   ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Table of SAI call latencies (count, avg, p50, p99, max) per SAI api and
+   * call type, since agent start.
+   */
+  string dumpSaiApiCallLatencies();
 }
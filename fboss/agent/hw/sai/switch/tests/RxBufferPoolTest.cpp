@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/switch/SaiRxBufferPool.h"
+#include "fboss/agent/hw/sai/switch/SaiRxPacket.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+TEST(RxBufferPoolTest, bufferOutlivesSource) {
+  SaiRxBufferPool pool(4, 128);
+  std::unique_ptr<folly::IOBuf> clone;
+  {
+    std::array<uint8_t, 64> packet;
+    packet.fill(0xab);
+    auto buf = pool.copyPacket(packet.data(), packet.size());
+    EXPECT_EQ(pool.numFreeBuffers(), 3);
+    clone = buf->clone();
+    packet.fill(0);
+  }
+  // The clone still holds the pool buffer with the original data
+  EXPECT_EQ(pool.numFreeBuffers(), 3);
+  ASSERT_EQ(clone->length(), 64);
+  for (size_t i = 0; i < clone->length(); i++) {
+    EXPECT_EQ(clone->data()[i], 0xab);
+  }
+  clone.reset();
+  EXPECT_EQ(pool.numFreeBuffers(), 4);
+}
+
+TEST(RxBufferPoolTest, heapFallback) {
+  SaiRxBufferPool pool(1, 128);
+  std::array<uint8_t, 256> packet{};
+  // Larger than a pool buffer
+  auto large = pool.copyPacket(packet.data(), packet.size());
+  EXPECT_EQ(large->length(), packet.size());
+  EXPECT_EQ(pool.numFreeBuffers(), 1);
+
+  auto first = pool.copyPacket(packet.data(), 64);
+  EXPECT_EQ(pool.numFreeBuffers(), 0);
+  // Pool exhausted
+  auto second = pool.copyPacket(packet.data(), 64);
+  EXPECT_EQ(second->length(), 64);
+  first.reset();
+  EXPECT_EQ(pool.numFreeBuffers(), 1);
+}
+
+TEST(RxBufferPoolTest, freeFromOtherThread) {
+  SaiRxBufferPool pool(16, 128);
+  std::array<uint8_t, 64> packet{};
+  std::vector<std::unique_ptr<folly::IOBuf>> bufs;
+  for (int i = 0; i < 16; i++) {
+    bufs.push_back(pool.copyPacket(packet.data(), packet.size()));
+  }
+  EXPECT_EQ(pool.numFreeBuffers(), 0);
+  std::thread([&bufs]() { bufs.clear(); }).join();
+  EXPECT_EQ(pool.numFreeBuffers(), 16);
+}
+
+TEST(RxBufferPoolTest, rxPacketOwnsBuffer) {
+  std::unique_ptr<folly::IOBuf> clone;
+  {
+    std::array<uint8_t, 64> packet;
+    packet.fill(0xcd);
+    auto rxPacket = std::make_unique<SaiRxPacket>(
+        packet.size(),
+        packet.data(),
+        PortID(1),
+        VlanID(1),
+        cfg::PacketRxReason::UNMATCHED);
+    clone = rxPacket->buf()->clone();
+    packet.fill(0);
+  }
+  ASSERT_EQ(clone->length(), 64);
+  EXPECT_EQ(clone->data()[0], 0xcd);
+  EXPECT_EQ(clone->data()[63], 0xcd);
+}
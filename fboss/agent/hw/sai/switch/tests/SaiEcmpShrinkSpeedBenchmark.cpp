@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/switch/SaiFdbManager.h"
+#include "fboss/agent/hw/sai/switch/SaiNextHopGroupManager.h"
+#include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+/*
+ * ECMP shrink on link down, as in HwEcmpShrinkSpeedBenchmark, but on FakeSai.
+ * This times the software side of the fast path: FDB entry -> neighbor ->
+ * next hop -> next hop group member removal, fanned out through the SAI
+ * object event publishers.
+ */
+namespace facebook::fboss {
+
+namespace {
+
+constexpr size_t kEcmpWidth = 4;
+
+class SaiEcmpShrinkSetup : public ManagerTestBase {
+ public:
+  SaiEcmpShrinkSetup() {
+    setupStage = SetupStage::PORT | SetupStage::VLAN | SetupStage::INTERFACE;
+    SetUp();
+  }
+  ~SaiEcmpShrinkSetup() override {
+    nextHopGroups.clear();
+    TearDown();
+  }
+  void TestBody() override {}
+
+  /*
+   * Every group has a next hop over interface 0, whose port goes down. The
+   * first group has kEcmpWidth next hops, the others add distinct sets of
+   * next hops over interfaces 1-9.
+   */
+  void setupNextHopGroups(size_t numGroups) {
+    for (size_t i = 0; i < testInterfaces.size(); ++i) {
+      resolveArp(i, testInterfaces[i].remoteHosts[0]);
+    }
+    uint32_t firstMask = (1u << (kEcmpWidth - 1)) - 1;
+    CHECK_LT(firstMask + numGroups, size_t{1} << (testInterfaces.size() - 1));
+    for (uint32_t mask = firstMask; mask < firstMask + numGroups; ++mask) {
+      RouteNextHopEntry::NextHopSet swNextHops{makeNextHop(testInterfaces[0])};
+      for (size_t i = 1; i < testInterfaces.size(); ++i) {
+        if (mask & (1u << (i - 1))) {
+          swNextHops.insert(makeNextHop(testInterfaces[i]));
+        }
+      }
+      nextHopGroups.push_back(
+          saiManagerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+              swNextHops));
+    }
+  }
+
+  size_t firstGroupSize() const {
+    SaiNextHopGroupTraits::Attributes::NextHopMemberList memberList{};
+    return saiApiTable->nextHopGroupApi()
+        .getAttribute(
+            nextHopGroups.front()->nextHopGroup->adapterKey(), memberList)
+        .size();
+  }
+
+  std::vector<std::shared_ptr<SaiNextHopGroupHandle>> nextHopGroups;
+};
+
+void ecmpGroupShrink(size_t numGroups) {
+  folly::BenchmarkSuspender suspender;
+  SaiEcmpShrinkSetup setup;
+  setup.setupNextHopGroups(numGroups);
+  CHECK_EQ(setup.firstGroupSize(), kEcmpWidth);
+  auto downPort = PortID(setup.testInterfaces[0].remoteHosts[0].port.id);
+  {
+    ScopedCallTimer timeIt;
+    suspender.dismiss();
+    setup.saiManagerTable->fdbManager().handleLinkDown(
+        SaiPortDescriptor(downPort));
+    suspender.rehire();
+  }
+  CHECK_EQ(setup.firstGroupSize(), kEcmpWidth - 1);
+}
+
+} // namespace
+
+BENCHMARK(SaiEcmpGroupShrink) {
+  ecmpGroupShrink(1);
+}
+
+BENCHMARK(SaiEcmpGroupShrinkSharedNextHop) {
+  ecmpGroupShrink(256);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
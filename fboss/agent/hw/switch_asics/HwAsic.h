@@ -201,6 +201,28 @@ class HwAsic {
   virtual uint32_t getMaxVariableWidthEcmpSize() const = 0;
 
   virtual uint32_t getMaxEcmpSize() const = 0;
+
+  /*
+   * Capacity of the forwarding tables, as used by the ResourceAccountant to
+   * reject state updates the hardware could not hold. Route and host tables
+   * are counted in IPv4 entries, IPv6 entries taking several of them. No
+   * value means the capacity is not known and not enforced.
+   */
+  virtual std::optional<uint32_t> getMaxEcmpGroups() const {
+    return std::nullopt;
+  }
+  virtual std::optional<uint32_t> getMaxEcmpMembers() const {
+    return std::nullopt;
+  }
+  virtual std::optional<uint32_t> getMaxRouteTableSize() const {
+    return std::nullopt;
+  }
+  virtual std::optional<uint32_t> getMaxHostTableSize() const {
+    return std::nullopt;
+  }
+  virtual std::optional<uint32_t> getMaxAclEntries() const {
+    return std::nullopt;
+  }
 };
 
 } // namespace facebook::fboss
@@ -101,6 +101,38 @@ class MockAsic : public HwAsic {
   AsicVendor getAsicVendor() const override {
     return HwAsic::AsicVendor::ASIC_VENDOR_MOCK;
   }
+  std::optional<uint32_t> getMaxEcmpGroups() const override {
+    return maxEcmpGroups_;
+  }
+  std::optional<uint32_t> getMaxEcmpMembers() const override {
+    return maxEcmpMembers_;
+  }
+  std::optional<uint32_t> getMaxRouteTableSize() const override {
+    return maxRouteTableSize_;
+  }
+  std::optional<uint32_t> getMaxHostTableSize() const override {
+    return maxHostTableSize_;
+  }
+
+  // Table capacities are not enforced unless tests set them
+  void setMaxEcmpGroups(std::optional<uint32_t> maxEcmpGroups) {
+    maxEcmpGroups_ = maxEcmpGroups;
+  }
+  void setMaxEcmpMembers(std::optional<uint32_t> maxEcmpMembers) {
+    maxEcmpMembers_ = maxEcmpMembers;
+  }
+  void setMaxRouteTableSize(std::optional<uint32_t> maxRouteTableSize) {
+    maxRouteTableSize_ = maxRouteTableSize;
+  }
+  void setMaxHostTableSize(std::optional<uint32_t> maxHostTableSize) {
+    maxHostTableSize_ = maxHostTableSize;
+  }
+
+ private:
+  std::optional<uint32_t> maxEcmpGroups_;
+  std::optional<uint32_t> maxEcmpMembers_;
+  std::optional<uint32_t> maxRouteTableSize_;
+  std::optional<uint32_t> maxHostTableSize_;
 };
 
 } // namespace facebook::fboss
@@ -89,6 +89,12 @@ class Tomahawk4Asic : public BroadcomAsic {
   uint32_t getMaxEcmpSize() const override {
     return 4096;
   }
+  std::optional<uint32_t> getMaxEcmpGroups() const override {
+    return 4096;
+  }
+  std::optional<uint32_t> getMaxEcmpMembers() const override {
+    return 16384;
+  }
 };
 
 } // namespace facebook::fboss
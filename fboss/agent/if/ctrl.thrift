@@ -130,6 +130,42 @@ struct MplsRouteDetails {
   6: optional common.NamedRouteDestination namedRouteDestination;
 }
 
+/*
+ * Restricts route table walks, applied while walking the FIB rather than on
+ * the results. Unset fields match everything.
+ */
+struct RouteTableFilter {
+  1: optional i32 vrf;
+  // Only routes equal to or more specific than this prefix
+  2: optional IpPrefix prefix;
+}
+
+// Position in a route table walk, i.e. the last route returned
+struct RouteTableCursor {
+  1: i32 vrf;
+  2: IpPrefix prefix;
+}
+
+struct RouteTablePageRequest {
+  1: RouteTableFilter filter;
+  // Start after this route. Start from the beginning if unset.
+  2: optional RouteTableCursor cursor;
+  // Capped by the agent at 10000
+  3: i32 limit = 1000;
+}
+
+struct UnicastRoutePage {
+  1: list<UnicastRoute> routes;
+  // Set if there are more routes, pass back to get the next page
+  2: optional RouteTableCursor nextCursor;
+}
+
+struct RouteDetailsPage {
+  1: list<RouteDetails> routes;
+  // Set if there are more routes, pass back to get the next page
+  2: optional RouteTableCursor nextCursor;
+}
+
 struct ArpEntryThrift {
   1: string mac;
   2: i32 port;
@@ -419,11 +455,14 @@ enum CpuCosQueueId {
 
 struct RxCaptureFilter {
   1: list<CpuCosQueueId> cosQueues;
+  2: list<i32> srcPorts;
 # can put additional Rx filters here if need be
 }
 
 struct CaptureFilter {
   1: RxCaptureFilter rxCaptureFilter;
+  // Match on the ethertype after any VLAN tags, for both rx and tx packets
+  2: list<i32> etherTypes;
 }
 
 struct CaptureInfo {
@@ -443,6 +482,11 @@ struct CaptureInfo {
    * set of criteria that packet must meet to be captured
    */
   4: CaptureFilter filter;
+  /*
+   * Only capture the first snaplen bytes of each packet, which must be
+   * positive. Unset to capture whole packets.
+   */
+  5: optional i32 snaplen;
 }
 
 struct RouteUpdateLoggingInfo {
@@ -779,6 +823,26 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
   list<RouteDetails> getRouteTableDetailsByClients(
     1: list<i16> clientId,
   ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Paginated and streaming variants of getRouteTable and
+   * getRouteTableDetails for large FIBs. Routes are returned in the order of
+   * getRouteTableDetails. Each page reflects the switch state at the time it
+   * was served, while a stream is served entirely from the state at the time
+   * it was opened.
+   */
+  UnicastRoutePage getRouteTablePage(1: RouteTablePageRequest request) throws (
+    1: fboss.FbossBaseError error,
+  );
+  RouteDetailsPage getRouteTableDetailsPage(
+    1: RouteTablePageRequest request,
+  ) throws (1: fboss.FbossBaseError error);
+  stream<UnicastRoute> getRouteTableStream(1: RouteTableFilter filter) throws (
+    1: fboss.FbossBaseError error,
+  );
+  stream<RouteDetails> getRouteTableDetailsStream(
+    1: RouteTableFilter filter,
+  ) throws (1: fboss.FbossBaseError error);
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId) throws (
     1: fboss.FbossBaseError error,
   );
@@ -810,6 +874,11 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
     1: fboss.FbossBaseError error,
   );
 
+  /* Streaming variant of getAllMplsRouteDetails */
+  stream<MplsRouteDetails> getAllMplsRouteDetailsStream() throws (
+    1: fboss.FbossBaseError error,
+  );
+
   /* Retrieve MPLS entry for given label */
   MplsRouteDetails getMplsRouteDetails(1: mpls.MplsLabel topLabel) throws (
     1: fboss.FbossBaseError error,
@@ -14,6 +14,7 @@
 #include <re2/re2.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <algorithm>
 
 #include "fboss/agent/FbossError.h"
 
@@ -155,6 +156,78 @@ PlatformMapping::PlatformMapping(const std::string& jsonPlatformMappingStr) {
   if (auto portConfigOverrides = mapping.portConfigOverrides()) {
     portConfigOverrides_ = std::move(*portConfigOverrides);
   }
+  buildIndexes();
+}
+
+void PlatformMapping::buildIndexes() {
+  portNameToID_.clear();
+  for (const auto& port : platformPorts_) {
+    indexPlatformPort(port.second);
+  }
+  profileToSupportedProfiles_.clear();
+  for (size_t i = 0; i < platformSupportedProfiles_.size(); ++i) {
+    profileToSupportedProfiles_[*platformSupportedProfiles_[i]
+                                     .factor()
+                                     ->profileID()]
+        .push_back(i);
+  }
+  portToOverrides_.clear();
+  anyPortOverrides_.clear();
+  for (size_t i = 0; i < portConfigOverrides_.size(); ++i) {
+    indexPortConfigOverride(i);
+  }
+}
+
+void PlatformMapping::indexPlatformPort(const cfg::PlatformPortEntry& port) {
+  portNameToID_.emplace(
+      *port.mapping()->name(), PortID(*port.mapping()->id()));
+}
+
+void PlatformMapping::indexPortConfigOverride(size_t idx) {
+  auto addOverride = [idx](std::vector<size_t>& overrides) {
+    auto it = std::lower_bound(overrides.begin(), overrides.end(), idx);
+    if (it == overrides.end() || *it != idx) {
+      overrides.insert(it, idx);
+    }
+  };
+  if (auto ports = portConfigOverrides_[idx].factor()->ports()) {
+    for (auto port : *ports) {
+      addOverride(portToOverrides_[port]);
+    }
+  } else {
+    addOverride(anyPortOverrides_);
+  }
+}
+
+template <typename Pred>
+const cfg::PlatformPortConfigOverride* PlatformMapping::findPortConfigOverride(
+    std::optional<PortID> portID,
+    Pred&& pred) const {
+  static const std::vector<size_t> kNoOverrides;
+  const auto* portOverrides = &kNoOverrides;
+  if (portID) {
+    if (auto it = portToOverrides_.find(static_cast<int32_t>(*portID));
+        it != portToOverrides_.end()) {
+      portOverrides = &it->second;
+    }
+  }
+  // Walk the port specific and any port overrides merged in config order
+  auto portIt = portOverrides->begin();
+  auto anyPortIt = anyPortOverrides_.begin();
+  while (portIt != portOverrides->end() ||
+         anyPortIt != anyPortOverrides_.end()) {
+    size_t idx;
+    if (anyPortIt == anyPortOverrides_.end() ||
+        (portIt != portOverrides->end() && *portIt < *anyPortIt)) {
+      idx = *portIt++;
+    } else {
+      idx = *anyPortIt++;
+    }
+    if (pred(portConfigOverrides_[idx])) {
+      return &portConfigOverrides_[idx];
+    }
+  }
+  return nullptr;
 }
 
 cfg::PlatformMapping PlatformMapping::toThrift() const {
@@ -170,16 +243,18 @@ cfg::PlatformMapping PlatformMapping::toThrift() const {
 
 void PlatformMapping::merge(PlatformMapping* mapping) {
   for (auto port : mapping->platformPorts_) {
-    platformPorts_.emplace(port.first, std::move(port.second));
+    setPlatformPort(port.first, std::move(port.second));
     mergePortConfigOverrides(
         port.first, mapping->getPortConfigOverrides(port.first));
   }
   mapping->platformPorts_.clear();
+  mapping->portNameToID_.clear();
 
   for (auto incomingProfile : mapping->platformSupportedProfiles_) {
     mergePlatformSupportedProfile(incomingProfile);
   }
   mapping->platformSupportedProfiles_.clear();
+  mapping->profileToSupportedProfiles_.clear();
 
   for (auto chip : mapping->chips_) {
     chips_.emplace(chip.first, std::move(chip.second));
@@ -227,9 +302,20 @@ void PlatformMapping::mergePlatformSupportedProfile(
     }
   }
   // Was not able to merge entry so create new one
+  profileToSupportedProfiles_[*incomingProfile.factor()->profileID()]
+      .push_back(platformSupportedProfiles_.size());
   platformSupportedProfiles_.push_back(incomingProfile);
 }
 
+void PlatformMapping::setPlatformPort(
+    int32_t portID,
+    cfg::PlatformPortEntry port) {
+  auto [it, inserted] = platformPorts_.emplace(portID, std::move(port));
+  if (inserted) {
+    indexPlatformPort(it->second);
+  }
+}
+
 int PlatformMapping::getPimID(PortID portID) const {
   auto itPlatformPort = platformPorts_.find(portID);
   if (itPlatformPort == platformPorts_.end()) {
@@ -303,59 +389,54 @@ std::vector<phy::PinConfig> PlatformMapping::getPortIphyPinConfigs(
         getPlatformPortConfig(portID.value(), profileID);
     const auto& iphyCfg = *platformPortConfig.pins()->iphy();
     // Check whether there's an override
-    for (const auto& portConfigOverride : portConfigOverrides_) {
-      if (!portConfigOverride.pins().has_value()) {
-        // The override is not about Iphy pin configs. Skip
-        continue;
+    if (auto portConfigOverride = findPortConfigOverride(
+            portID, [&matcher](const auto& portConfigOverride) {
+              // Skip overrides not about Iphy pin configs
+              return portConfigOverride.pins().has_value() &&
+                  !portConfigOverride.pins()->iphy()->empty() &&
+                  matcher.matchOverrideWithFactor(
+                      *portConfigOverride.factor());
+            })) {
+      const auto& overrideIphy = *portConfigOverride->pins()->iphy();
+      // make sure the override iphy config size == iphyCfg or override
+      // size == 1, in which case we use the same override for all lanes
+      if (overrideIphy.size() != iphyCfg.size() && overrideIphy.size() != 1) {
+        throw FbossError(
+            "Port ",
+            portID.value(),
+            ", profile ",
+            apache::thrift::util::enumNameSafe(profileID),
+            " has mismatched override iphy lane size:",
+            overrideIphy.size(),
+            ", expected size: ",
+            iphyCfg.size());
       }
-      if (matcher.matchOverrideWithFactor(*portConfigOverride.factor())) {
-        auto overrideIphy = *portConfigOverride.pins()->iphy();
-        if (!overrideIphy.empty()) {
-          // make sure the override iphy config size == iphyCfg or override
-          // size == 1, in which case we use the same override for all lanes
-          if (overrideIphy.size() != iphyCfg.size() &&
-              overrideIphy.size() != 1) {
-            throw FbossError(
-                "Port ",
-                portID.value(),
-                ", profile ",
-                apache::thrift::util::enumNameSafe(profileID),
-                " has mismatched override iphy lane size:",
-                overrideIphy.size(),
-                ", expected size: ",
-                iphyCfg.size());
-          }
-
-          // We need to update the override with the correct PinID for such port
-          // Both default iphyCfg and override iphyCfg are in order by lanes.
-          std::vector<phy::PinConfig> newOverrideIphy;
-          for (int i = 0; i < iphyCfg.size(); i++) {
-            phy::PinConfig pinCfg;
-            pinCfg.id() = *iphyCfg.at(i).id();
-            // Default to the first entry if we run out
-            const auto& override =
-                overrideIphy.at(i < overrideIphy.size() ? i : 0);
-            if (auto tx = override.tx()) {
-              pinCfg.tx() = *tx;
-            }
-            newOverrideIphy.push_back(pinCfg);
-          }
-          return newOverrideIphy;
+
+      // We need to update the override with the correct PinID for such port
+      // Both default iphyCfg and override iphyCfg are in order by lanes.
+      std::vector<phy::PinConfig> newOverrideIphy;
+      for (int i = 0; i < iphyCfg.size(); i++) {
+        phy::PinConfig pinCfg;
+        pinCfg.id() = *iphyCfg.at(i).id();
+        // Default to the first entry if we run out
+        const auto& override = overrideIphy.at(i < overrideIphy.size() ? i : 0);
+        if (auto tx = override.tx()) {
+          pinCfg.tx() = *tx;
         }
+        newOverrideIphy.push_back(pinCfg);
       }
+      return newOverrideIphy;
     }
     // otherwise, we just need to return iphy config directly
     return iphyCfg;
-  } else {
-    for (const auto& portConfigOverride : portConfigOverrides_) {
-      if (!portConfigOverride.pins().has_value()) {
-        // The override is not about Iphy pin configs. Skip
-        continue;
-      }
-      if (matcher.matchOverrideWithFactor(*portConfigOverride.factor())) {
-        return *portConfigOverride.pins()->iphy();
-      }
-    }
+  } else if (
+      auto portConfigOverride = findPortConfigOverride(
+          std::nullopt, [&matcher](const auto& portConfigOverride) {
+            // Skip overrides not about Iphy pin configs
+            return portConfigOverride.pins().has_value() &&
+                matcher.matchOverrideWithFactor(*portConfigOverride.factor());
+          })) {
+    return *portConfigOverride->pins()->iphy();
   }
   throw FbossError("No iphy pins found for matcher", matcher.toString());
 }
@@ -395,56 +476,58 @@ std::vector<phy::PinConfig> PlatformMapping::getPortXphySidePinConfigs(
     return std::vector<phy::PinConfig>();
   }
   const auto& xphySideCfg = xphySideOptional.value();
+  auto getOverrideXphySide = [side](const auto& portConfigOverride) {
+    return side == phy::Side::SYSTEM ? portConfigOverride.pins()->xphySys()
+                                     : portConfigOverride.pins()->xphyLine();
+  };
   // Check whether there's an override
-  for (const auto& portConfigOverride : portConfigOverrides_) {
-    if (!portConfigOverride.pins().has_value()) {
-      // The override is not about pin configs. Skip
-      continue;
-    }
-    auto overrideXphySideOptional = side == phy::Side::SYSTEM
-        ? portConfigOverride.pins()->xphySys()
-        : portConfigOverride.pins()->xphyLine();
-    if (!overrideXphySideOptional.has_value()) {
-      // The override is not about xphy configs. Skip
-      continue;
+  if (auto portConfigOverride = findPortConfigOverride(
+          portID,
+          [&matcher, &getOverrideXphySide](const auto& portConfigOverride) {
+            // Skip overrides not about xphy side pin configs
+            if (!portConfigOverride.pins().has_value()) {
+              return false;
+            }
+            auto overrideXphySideOptional =
+                getOverrideXphySide(portConfigOverride);
+            return overrideXphySideOptional.has_value() &&
+                !overrideXphySideOptional->empty() &&
+                matcher.matchOverrideWithFactor(*portConfigOverride.factor());
+          })) {
+    const auto& overrideXphySideCfg =
+        getOverrideXphySide(*portConfigOverride).value();
+    // make sure the override xphy config size == xphySideCfg or
+    // override size == 1, in which case we use the same override for all
+    // lanes
+    if (overrideXphySideCfg.size() != xphySideCfg.size() &&
+        overrideXphySideCfg.size() != 1) {
+      throw FbossError(
+          "Port ",
+          portID.value(),
+          ", profile ",
+          apache::thrift::util::enumNameSafe(profileID),
+          " has mismatched override xphy side lane size:",
+          overrideXphySideCfg.size(),
+          ", expected size: ",
+          xphySideCfg.size());
     }
-    if (matcher.matchOverrideWithFactor(*portConfigOverride.factor())) {
-      auto overrideXphySideCfg = overrideXphySideOptional.value();
-      if (!overrideXphySideCfg.empty()) {
-        // make sure the override xphy config size == xphySideCfg or
-        // override size == 1, in which case we use the same override for all
-        // lanes
-        if (overrideXphySideCfg.size() != xphySideCfg.size() &&
-            overrideXphySideCfg.size() != 1) {
-          throw FbossError(
-              "Port ",
-              portID.value(),
-              ", profile ",
-              apache::thrift::util::enumNameSafe(profileID),
-              " has mismatched override xphy side lane size:",
-              overrideXphySideCfg.size(),
-              ", expected size: ",
-              xphySideCfg.size());
-        }
 
-        // We need to update the override with the correct PinID for such port
-        // Both default xphySideCfg and override xphySideCfg are in order by
-        // lanes.
-        std::vector<phy::PinConfig> newOverrideXphySide;
-        for (int i = 0; i < xphySideCfg.size(); i++) {
-          phy::PinConfig pinCfg;
-          *pinCfg.id() = *xphySideCfg.at(i).id();
-          // Default to the first entry if we run out
-          const auto& override =
-              overrideXphySideCfg.at(i < overrideXphySideCfg.size() ? i : 0);
-          if (auto tx = override.tx()) {
-            pinCfg.tx() = *tx;
-          }
-          newOverrideXphySide.push_back(pinCfg);
-        }
-        return newOverrideXphySide;
+    // We need to update the override with the correct PinID for such port
+    // Both default xphySideCfg and override xphySideCfg are in order by
+    // lanes.
+    std::vector<phy::PinConfig> newOverrideXphySide;
+    for (int i = 0; i < xphySideCfg.size(); i++) {
+      phy::PinConfig pinCfg;
+      *pinCfg.id() = *xphySideCfg.at(i).id();
+      // Default to the first entry if we run out
+      const auto& override =
+          overrideXphySideCfg.at(i < overrideXphySideCfg.size() ? i : 0);
+      if (auto tx = override.tx()) {
+        pinCfg.tx() = *tx;
       }
+      newOverrideXphySide.push_back(pinCfg);
     }
+    return newOverrideXphySide;
   }
   // otherwise, we just need to return xphy side config directly
   return xphySideCfg;
@@ -463,19 +546,24 @@ phy::PortPinConfig PlatformMapping::getPortXphyPinConfig(
 const std::optional<phy::PortProfileConfig>
 PlatformMapping::getPortProfileConfig(
     PlatformPortProfileConfigMatcher profileMatcher) const {
-  for (const auto& portConfigOverride : portConfigOverrides_) {
-    if (!portConfigOverride.portProfileConfig().has_value()) {
-      // The override is not about portProfileConfig. Skip
-      continue;
-    }
-    if (profileMatcher.matchOverrideWithFactor(*portConfigOverride.factor())) {
-      return *portConfigOverride.portProfileConfig();
-    }
-  }
-  for (auto& supportedProfile : platformSupportedProfiles_) {
-    if (profileMatcher.matchProfileWithFactor(
-            this, supportedProfile.get_factor())) {
-      return supportedProfile.get_profile();
+  if (auto portConfigOverride = findPortConfigOverride(
+          profileMatcher.getPortIDIf(),
+          [&profileMatcher](const auto& portConfigOverride) {
+            // Skip overrides not about portProfileConfig
+            return portConfigOverride.portProfileConfig().has_value() &&
+                profileMatcher.matchOverrideWithFactor(
+                    *portConfigOverride.factor());
+          })) {
+    return *portConfigOverride->portProfileConfig();
+  }
+  if (auto it = profileToSupportedProfiles_.find(profileMatcher.getProfileID());
+      it != profileToSupportedProfiles_.end()) {
+    for (auto idx : it->second) {
+      const auto& supportedProfile = platformSupportedProfiles_[idx];
+      if (profileMatcher.matchProfileWithFactor(
+              this, supportedProfile.get_factor())) {
+        return supportedProfile.get_profile();
+      }
     }
   }
   XLOGF(
@@ -488,12 +576,11 @@ PlatformMapping::getPortProfileConfig(
 std::vector<cfg::PlatformPortConfigOverride>
 PlatformMapping::getPortConfigOverrides(int32_t port) const {
   std::vector<cfg::PlatformPortConfigOverride> overrides;
-  for (const auto& portConfigOverride : portConfigOverrides_) {
-    if (auto portList = portConfigOverride.factor()->ports()) {
-      if (std::find(portList->begin(), portList->end(), port) !=
-          portList->end()) {
-        overrides.push_back(portConfigOverride);
-      }
+  // Visit all the overrides which may apply to the port
+  findPortConfigOverride(PortID(port), [&](const auto& portConfigOverride) {
+    if (portConfigOverride.factor()->ports()) {
+      // Indexed by port, so port is in the list
+      overrides.push_back(portConfigOverride);
     } else if (auto chipList = portConfigOverride.factor()->chips()) {
       auto chip = getPortIphyChip(PortID(port));
       if (std::find(chipList->begin(), chipList->end(), chip) !=
@@ -505,7 +592,8 @@ PlatformMapping::getPortConfigOverrides(int32_t port) const {
       // ports
       overrides.push_back(portConfigOverride);
     }
-  }
+    return false;
+  });
   return overrides;
 }
 
@@ -514,7 +602,8 @@ void PlatformMapping::mergePortConfigOverrides(
     std::vector<cfg::PlatformPortConfigOverride> overrides) {
   for (auto& portOverrides : overrides) {
     int numMismatch = 0;
-    for (auto& curOverride : portConfigOverrides_) {
+    for (size_t idx = 0; idx < portConfigOverrides_.size(); ++idx) {
+      auto& curOverride = portConfigOverrides_[idx];
       if (portOverrides.pins() != curOverride.pins() ||
           portOverrides.factor()->profiles() !=
               curOverride.factor()->profiles() ||
@@ -531,6 +620,7 @@ void PlatformMapping::mergePortConfigOverrides(
       auto curPortList = curOverride.factor()->ports();
       if (portList && curPortList) {
         curPortList->push_back(port);
+        indexPortConfigOverride(idx);
       }
     }
     // if none of the existing override matches, add this override directly
@@ -544,15 +634,14 @@ void PlatformMapping::mergePortConfigOverrides(
       } else {
         portConfigOverrides_.push_back(portOverrides);
       }
+      indexPortConfigOverride(portConfigOverrides_.size() - 1);
     }
   }
 }
 
 const PortID PlatformMapping::getPortID(const std::string& portName) const {
-  for (const auto& platPortEntry : platformPorts_) {
-    if (*platPortEntry.second.mapping()->name() == portName) {
-      return PortID(*platPortEntry.second.mapping()->id());
-    }
+  if (auto it = portNameToID_.find(portName); it != portNameToID_.end()) {
+    return it->second;
   }
   throw FbossError("No PlatformPortEntry found for portName: ", portName);
 }
@@ -14,6 +14,8 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <unordered_map>
+
 namespace facebook {
 namespace fboss {
 
@@ -70,6 +72,14 @@ class PlatformPortProfileConfigMatcher {
 class PlatformMapping {
  public:
   PlatformMapping() {}
+  /*
+   * Each platform checks its mapping into the tree as a JSON string literal
+   * (kJsonPlatformMappingStr), which is parsed here once per process.
+   * Precompiling it into a Compact serialized blob would need a thrift
+   * linked host tool run as a build step for every platform library, so it
+   * is left as JSON; lookups after construction go through the indexes
+   * built by buildIndexes() rather than the parsed thrift structures.
+   */
   explicit PlatformMapping(const std::string& jsonPlatformMappingStr);
   virtual ~PlatformMapping() = default;
 
@@ -105,9 +115,7 @@ class PlatformMapping {
 
   const phy::DataPlanePhyChip& getPortIphyChip(PortID port) const;
 
-  void setPlatformPort(int32_t portID, cfg::PlatformPortEntry port) {
-    platformPorts_.emplace(portID, port);
-  }
+  void setPlatformPort(int32_t portID, cfg::PlatformPortEntry port);
 
   void setChip(const std::string& chipName, phy::DataPlanePhyChip chip) {
     chips_.emplace(chipName, chip);
@@ -152,6 +160,27 @@ class PlatformMapping {
       cfg::PortProfileID profileID) const;
 
  private:
+  void buildIndexes();
+  void indexPlatformPort(const cfg::PlatformPortEntry& port);
+  void indexPortConfigOverride(size_t idx);
+
+  // Returns the first override, in config order, which may apply to portID
+  // (or to any port, if there's no portID) and satisfies pred
+  template <typename Pred>
+  const cfg::PlatformPortConfigOverride* findPortConfigOverride(
+      std::optional<PortID> portID,
+      Pred&& pred) const;
+
+  // Indexes to avoid scanning every override and supported profile on each
+  // lookup. Overrides are indexed by the ports of their factor, the ones
+  // without ports can apply to any port. Indices are kept in config order,
+  // as the first matching override wins.
+  std::unordered_map<int32_t, std::vector<size_t>> portToOverrides_;
+  std::vector<size_t> anyPortOverrides_;
+  std::unordered_map<cfg::PortProfileID, std::vector<size_t>>
+      profileToSupportedProfiles_;
+  std::unordered_map<std::string, PortID> portNameToID_;
+
   // Forbidden copy constructor and assignment operator
   PlatformMapping(PlatformMapping const&) = delete;
   PlatformMapping& operator=(PlatformMapping const&) = delete;
@@ -886,6 +886,16 @@ TEST_F(PlatformMappingTest, VerifyOverrideMerge) {
   }
 }
 
+TEST_F(PlatformMappingTest, VerifyPortIDByName) {
+  // Yamp merges the mapping of each pim into one
+  auto mapping = std::make_unique<YampPlatformMapping>();
+  for (const auto& port : mapping->getPlatformPorts()) {
+    EXPECT_EQ(
+        mapping->getPortID(*port.second.mapping()->name()), PortID(port.first));
+  }
+  EXPECT_THROW(mapping->getPortID("eth9/9/9"), FbossError);
+}
+
 TEST_F(PlatformMappingTest, VerifyWedge40PlatformMapping) {
   // supported profiles
   std::vector<cfg::PortProfileID> expectedProfiles = {
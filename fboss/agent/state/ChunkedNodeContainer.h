@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Sorted map meant to be used as NodeMapTraits::NodeContainer for leaf heavy
+ * maps with 100K+ entries, viz. MacTable, ArpTable and NdpTable.
+ *
+ * The (key, value) pairs are stored sorted, inline in contiguous chunks of at
+ * most kMaxChunkSize pairs. Chunks are shared (copy-on-write) between copies
+ * of the container. So cloning a NodeMap for modification copies one pointer
+ * per chunk rather than one shared_ptr per entry, and a write only copies the
+ * chunk it lands in. Chunks still shared between two versions of a map are
+ * known to be identical, which NodeMapDelta uses to step over them without
+ * comparing their entries (see skipShared()).
+ *
+ * For NodeMaps the values are the shared_ptr nodes, which are still allocated
+ * one by one, each with its own control block. This saves on copying and
+ * comparing versions of a map, not on the memory a single version takes
+ * (see ChunkedNodeContainerBenchmark).
+ *
+ * The interface is the subset of boost::container::flat_map that NodeMapT and
+ * its users rely on.
+ */
+template <typename KeyT, typename ValueT, size_t kMaxChunkSize = 256>
+class ChunkedNodeContainer {
+  static_assert(kMaxChunkSize > 1, "Chunks must be able to split");
+
+ public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<KeyT, ValueT>;
+  using size_type = size_t;
+
+ private:
+  using Chunk = std::vector<value_type>;
+  using ChunkPtr = std::shared_ptr<Chunk>;
+
+  template <bool kConst>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = ChunkedNodeContainer::value_type;
+    using difference_type = ptrdiff_t;
+    using reference =
+        std::conditional_t<kConst, const value_type&, value_type&>;
+    using pointer = std::conditional_t<kConst, const value_type*, value_type*>;
+    using ContainerPtr = std::conditional_t<
+        kConst,
+        const ChunkedNodeContainer*,
+        ChunkedNodeContainer*>;
+
+    IteratorImpl() {}
+    IteratorImpl(ContainerPtr container, size_t chunk, size_t offset)
+        : container_(container), chunk_(chunk), offset_(offset) {}
+    // iterator -> const_iterator
+    template <
+        bool kOtherConst,
+        typename = std::enable_if_t<kConst && !kOtherConst>>
+    /* implicit */ IteratorImpl(const IteratorImpl<kOtherConst>& other)
+        : container_(other.container_),
+          chunk_(other.chunk_),
+          offset_(other.offset_) {}
+
+    reference operator*() const {
+      if constexpr (kConst) {
+        return (*container_->chunks_[chunk_])[offset_];
+      } else {
+        // Writes through a mutable iterator must not show through in other
+        // copies of the container sharing this chunk.
+        return container_->writableChunk(chunk_)[offset_];
+      }
+    }
+    pointer operator->() const {
+      return &operator*();
+    }
+
+    IteratorImpl& operator++() {
+      if (++offset_ == container_->chunks_[chunk_]->size()) {
+        ++chunk_;
+        offset_ = 0;
+      }
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    IteratorImpl& operator--() {
+      if (offset_ == 0) {
+        --chunk_;
+        offset_ = container_->chunks_[chunk_]->size() - 1;
+      } else {
+        --offset_;
+      }
+      return *this;
+    }
+    IteratorImpl operator--(int) {
+      IteratorImpl tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const IteratorImpl& other) const {
+      return chunk_ == other.chunk_ && offset_ == other.offset_;
+    }
+    bool operator!=(const IteratorImpl& other) const {
+      return !operator==(other);
+    }
+
+   private:
+    friend class ChunkedNodeContainer;
+    template <bool>
+    friend class IteratorImpl;
+
+    ContainerPtr container_{nullptr};
+    size_t chunk_{0};
+    size_t offset_{0};
+  };
+
+ public:
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  size_type size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(this, 0, 0);
+  }
+  const_iterator end() const {
+    return const_iterator(this, chunks_.size(), 0);
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+  iterator begin() {
+    return iterator(this, 0, 0);
+  }
+  iterator end() {
+    return iterator(this, chunks_.size(), 0);
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  reverse_iterator rbegin() {
+    return reverse_iterator(end());
+  }
+  reverse_iterator rend() {
+    return reverse_iterator(begin());
+  }
+
+  const_iterator lower_bound(const KeyT& key) const {
+    auto [chunk, offset] = locate(key);
+    return const_iterator(this, chunk, offset);
+  }
+  const_iterator find(const KeyT& key) const {
+    auto [chunk, offset] = locate(key);
+    return matches(chunk, offset, key) ? const_iterator(this, chunk, offset)
+                                       : end();
+  }
+  iterator find(const KeyT& key) {
+    auto [chunk, offset] = locate(key);
+    return matches(chunk, offset, key) ? iterator(this, chunk, offset) : end();
+  }
+  size_type count(const KeyT& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  std::pair<iterator, bool> insert(value_type value) {
+    auto [chunk, offset] = locate(value.first);
+    if (matches(chunk, offset, value.first)) {
+      return std::make_pair(iterator(this, chunk, offset), false);
+    }
+    if (chunks_.empty()) {
+      chunks_.push_back(std::make_shared<Chunk>());
+    } else if (chunk == chunks_.size()) {
+      // Larger than everything, append to the last chunk. Start a new chunk
+      // once it is full rather than split it, so that entries added in
+      // order, as when a table is built or deserialized, fill their chunks.
+      --chunk;
+      offset = chunks_[chunk]->size();
+      if (offset == kMaxChunkSize) {
+        chunks_.push_back(std::make_shared<Chunk>());
+        ++chunk;
+        offset = 0;
+      }
+    }
+    auto& entries = writableChunk(chunk);
+    entries.insert(entries.begin() + offset, std::move(value));
+    ++size_;
+    if (entries.size() > kMaxChunkSize) {
+      splitChunk(chunk);
+      if (offset >= chunks_[chunk]->size()) {
+        offset -= chunks_[chunk]->size();
+        ++chunk;
+      }
+    }
+    return std::make_pair(iterator(this, chunk, offset), true);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  iterator erase(const_iterator pos) {
+    auto chunk = pos.chunk_;
+    auto offset = pos.offset_;
+    auto& entries = writableChunk(chunk);
+    entries.erase(entries.begin() + offset);
+    --size_;
+    if (entries.empty()) {
+      chunks_.erase(chunks_.begin() + chunk);
+      offset = 0;
+    } else if (offset == entries.size()) {
+      ++chunk;
+      offset = 0;
+    }
+    return iterator(this, chunk, offset);
+  }
+  size_type erase(const KeyT& key) {
+    auto it = std::as_const(*this).find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+  void clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+  /*
+   * If lhs and rhs both point to the start of the same shared chunk, advance
+   * them past it and return true. All the entries in between are identical,
+   * without having to look at them.
+   */
+  static bool skipShared(const_iterator& lhs, const_iterator& rhs) {
+    if (lhs.offset_ != 0 || rhs.offset_ != 0 ||
+        lhs.chunk_ >= lhs.container_->chunks_.size() ||
+        rhs.chunk_ >= rhs.container_->chunks_.size() ||
+        lhs.container_->chunks_[lhs.chunk_] !=
+            rhs.container_->chunks_[rhs.chunk_]) {
+      return false;
+    }
+    ++lhs.chunk_;
+    ++rhs.chunk_;
+    return true;
+  }
+
+ private:
+  // {chunk, offset} of the first entry not less than key, or {end, 0}
+  std::pair<size_t, size_t> locate(const KeyT& key) const {
+    auto chunkIt = std::lower_bound(
+        chunks_.begin(),
+        chunks_.end(),
+        key,
+        [](const ChunkPtr& chunk, const KeyT& k) {
+          return chunk->back().first < k;
+        });
+    if (chunkIt == chunks_.end()) {
+      return std::make_pair(chunks_.size(), 0);
+    }
+    const auto& entries = **chunkIt;
+    auto entryIt = std::lower_bound(
+        entries.begin(),
+        entries.end(),
+        key,
+        [](const value_type& entry, const KeyT& k) { return entry.first < k; });
+    return std::make_pair(
+        chunkIt - chunks_.begin(), entryIt - entries.begin());
+  }
+
+  bool matches(size_t chunk, size_t offset, const KeyT& key) const {
+    return chunk < chunks_.size() &&
+        !(key < (*chunks_[chunk])[offset].first);
+  }
+
+  Chunk& writableChunk(size_t chunk) {
+    auto& chunkPtr = chunks_[chunk];
+    if (chunkPtr.use_count() != 1) {
+      chunkPtr = std::make_shared<Chunk>(*chunkPtr);
+    } else {
+      // use_count() is a relaxed load. Synchronize with the release done by
+      // whichever copy last dropped its reference to this chunk, before
+      // writing to it.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *chunkPtr;
+  }
+
+  // Caller must own chunk exclusively, i.e. have called writableChunk()
+  void splitChunk(size_t chunk) {
+    auto& entries = *chunks_[chunk];
+    auto mid = entries.begin() + entries.size() / 2;
+    auto upper = std::make_shared<Chunk>(
+        std::make_move_iterator(mid), std::make_move_iterator(entries.end()));
+    entries.erase(mid, entries.end());
+    // Don't hold on to the capacity the full chunk grew to
+    entries.shrink_to_fit();
+    chunks_.insert(chunks_.begin() + chunk + 1, std::move(upper));
+  }
+
+  // Non empty, sorted and non overlapping
+  std::vector<ChunkPtr> chunks_;
+  size_type size_{0};
+};
+
+} // namespace facebook::fboss
@@ -50,20 +50,32 @@ ForwardingInformationBaseContainer::getFibV6() const {
 std::shared_ptr<ForwardingInformationBaseContainer>
 ForwardingInformationBaseContainer::fromFollyDynamic(
     const folly::dynamic& json) {
+  return fromFollyDynamic(json, nullptr);
+}
+
+std::shared_ptr<ForwardingInformationBaseContainer>
+ForwardingInformationBaseContainer::fromFollyDynamic(
+    const folly::dynamic& json,
+    folly::Executor* executor) {
   auto fibContainer = std::make_shared<ForwardingInformationBaseContainer>(
       RouterID(json[kVrf].asInt()));
   fibContainer->writableFields()->fibV4 =
-      ForwardingInformationBaseV4::fromFollyDynamic(json[kFibV4]);
+      ForwardingInformationBaseV4::fromFollyDynamic(json[kFibV4], executor);
   fibContainer->writableFields()->fibV6 =
-      ForwardingInformationBaseV6::fromFollyDynamic(json[kFibV6]);
+      ForwardingInformationBaseV6::fromFollyDynamic(json[kFibV6], executor);
   return fibContainer;
 }
 
 folly::dynamic ForwardingInformationBaseContainer::toFollyDynamic() const {
+  return toFollyDynamic(nullptr);
+}
+
+folly::dynamic ForwardingInformationBaseContainer::toFollyDynamic(
+    folly::Executor* executor) const {
   folly::dynamic json = folly::dynamic::object;
   json[kVrf] = static_cast<int>(getID());
-  json[kFibV4] = getFibV4()->toFollyDynamic();
-  json[kFibV6] = getFibV6()->toFollyDynamic();
+  json[kFibV4] = getFibV4()->toFollyDynamic(executor);
+  json[kFibV6] = getFibV6()->toFollyDynamic(executor);
   return json;
 }
 
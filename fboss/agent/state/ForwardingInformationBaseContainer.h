@@ -68,6 +68,12 @@ class ForwardingInformationBaseContainer
       const folly::dynamic& json);
   folly::dynamic toFollyDynamic() const override;
 
+  // Same as above, with routes converted in parallel on executor
+  static std::shared_ptr<ForwardingInformationBaseContainer> fromFollyDynamic(
+      const folly::dynamic& json,
+      folly::Executor* executor);
+  folly::dynamic toFollyDynamic(folly::Executor* executor) const;
+
  private:
   // Inherit the constructors required for clone()
   using NodeBaseT::NodeBaseT;
@@ -73,6 +73,32 @@ void ForwardingInformationBaseMap::updateForwardingInformationBaseContainer(
   }
 }
 
+folly::dynamic ForwardingInformationBaseMap::toFollyDynamic(
+    folly::Executor* executor) const {
+  folly::dynamic entries = folly::dynamic::array;
+  for (const auto& fibContainer : *this) {
+    entries.push_back(fibContainer->toFollyDynamic(executor));
+  }
+  folly::dynamic json = folly::dynamic::object;
+  json[kEntries] = std::move(entries);
+  json[kExtraFields] = getExtraFields().toFollyDynamic();
+  return json;
+}
+
+std::shared_ptr<ForwardingInformationBaseMap>
+ForwardingInformationBaseMap::fromFollyDynamic(
+    const folly::dynamic& json,
+    folly::Executor* executor) {
+  auto fibMap = std::make_shared<ForwardingInformationBaseMap>();
+  for (const auto& entry : json[kEntries]) {
+    fibMap->addNode(
+        ForwardingInformationBaseContainer::fromFollyDynamic(entry, executor));
+  }
+  fibMap->writableExtraFields() =
+      ExtraFields::fromFollyDynamic(json[kExtraFields]);
+  return fibMap;
+}
+
 FBOSS_INSTANTIATE_NODE_MAP(
     ForwardingInformationBaseMap,
     ForwardingInformationBaseMapTraits);
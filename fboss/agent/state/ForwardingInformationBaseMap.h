@@ -42,6 +42,17 @@ class ForwardingInformationBaseMap : public NodeMapT<
   void updateForwardingInformationBaseContainer(
       const std::shared_ptr<ForwardingInformationBaseContainer>& fibContainer);
 
+  /*
+   * There are only a few VRFs, so rather than converting VRFs in parallel
+   * these convert one VRF at a time with its routes in parallel on executor.
+   */
+  using NodeMapT::toFollyDynamic;
+  folly::dynamic toFollyDynamic(folly::Executor* executor) const;
+  using NodeMapT::fromFollyDynamic;
+  static std::shared_ptr<ForwardingInformationBaseMap> fromFollyDynamic(
+      const folly::dynamic& json,
+      folly::Executor* executor);
+
  private:
   // Inherit the constructors required for clone()
   using NodeMapT::NodeMapT;
@@ -11,6 +11,7 @@
 
 #include <fboss/agent/gen-cpp2/switch_state_types.h>
 #include <folly/MacAddress.h>
+#include "fboss/agent/state/ChunkedNodeContainer.h"
 #include "fboss/agent/state/MacEntry.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/NodeMapDelta.h"
@@ -23,7 +24,11 @@
 
 namespace facebook::fboss {
 
-using MacTableTraits = NodeMapTraits<folly::MacAddress, MacEntry>;
+using MacTableTraits = NodeMapTraits<
+    folly::MacAddress,
+    MacEntry,
+    NodeMapNoExtraFields,
+    ChunkedNodeContainer<folly::MacAddress, std::shared_ptr<MacEntry>>>;
 
 struct MacTableThriftTraits
     : public ThriftyNodeMapTraits<std::string, state::MacEntryFields> {
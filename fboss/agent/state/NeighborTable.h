@@ -12,6 +12,7 @@
 #include <folly/MacAddress.h>
 #include <folly/dynamic.h>
 #include <folly/json.h>
+#include "fboss/agent/state/ChunkedNodeContainer.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/PortDescriptor.h"
@@ -26,8 +27,7 @@ struct NeighborTableTraits {
   using KeyType = IPADDR;
   using Node = ENTRY;
   using ExtraFields = NodeMapNoExtraFields;
-  using NodeContainer =
-      boost::container::flat_map<KeyType, std::shared_ptr<Node>>;
+  using NodeContainer = ChunkedNodeContainer<KeyType, std::shared_ptr<Node>>;
 
   static KeyType getKey(const std::shared_ptr<Node>& entry) {
     return entry->getIP();
@@ -12,6 +12,7 @@
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/agent/state/ParallelTransform.h"
 
 #include <folly/dynamic.h>
 #include <folly/json.h>
@@ -103,12 +104,25 @@ NodeMapT<MapTypeT, TraitsT>::removeNodeIf(const KeyType& key) {
 
 template <typename MapTypeT, typename TraitsT>
 folly::dynamic NodeMapT<MapTypeT, TraitsT>::toFollyDynamic() const {
-  folly::dynamic nodesJson = folly::dynamic::array;
+  return toFollyDynamic(nullptr);
+}
+
+template <typename MapTypeT, typename TraitsT>
+folly::dynamic NodeMapT<MapTypeT, TraitsT>::toFollyDynamic(
+    folly::Executor* executor) const {
+  std::vector<std::shared_ptr<Node>> nodes;
+  nodes.reserve(size());
   for (const auto& node : *this) {
-    nodesJson.push_back(node->toFollyDynamic());
+    nodes.push_back(node);
+  }
+  auto nodesJson = parallelTransform(
+      executor, nodes, [](const auto& node) { return node->toFollyDynamic(); });
+  folly::dynamic entries = folly::dynamic::array;
+  for (auto& nodeJson : nodesJson) {
+    entries.push_back(std::move(nodeJson));
   }
   folly::dynamic json = folly::dynamic::object;
-  json[kEntries] = std::move(nodesJson);
+  json[kEntries] = std::move(entries);
   json[kExtraFields] = getExtraFields().toFollyDynamic();
   return json;
 }
@@ -116,10 +130,24 @@ folly::dynamic NodeMapT<MapTypeT, TraitsT>::toFollyDynamic() const {
 template <typename MapTypeT, typename TraitsT>
 std::shared_ptr<MapTypeT> NodeMapT<MapTypeT, TraitsT>::fromFollyDynamic(
     const folly::dynamic& nodesJson) {
+  return fromFollyDynamic(nodesJson, nullptr);
+}
+
+template <typename MapTypeT, typename TraitsT>
+std::shared_ptr<MapTypeT> NodeMapT<MapTypeT, TraitsT>::fromFollyDynamic(
+    const folly::dynamic& nodesJson,
+    folly::Executor* executor) {
   auto nodeMap = std::make_shared<MapTypeT>();
-  auto entries = nodesJson[kEntries];
-  for (const auto& entry : entries) {
-    nodeMap->addNode(Node::fromFollyDynamic(entry));
+  std::vector<const folly::dynamic*> entries;
+  for (const auto& entry : nodesJson[kEntries]) {
+    entries.push_back(&entry);
+  }
+  auto nodes =
+      parallelTransform(executor, entries, [](const folly::dynamic* entry) {
+        return Node::fromFollyDynamic(*entry);
+      });
+  for (const auto& node : nodes) {
+    nodeMap->addNode(node);
   }
   nodeMap->writableExtraFields() =
       ExtraFields::fromFollyDynamic(nodesJson[kExtraFields]);
@@ -11,9 +11,15 @@
 
 #include <boost/container/flat_map.hpp>
 
+#include <utility>
+
 #include "fboss/agent/state/NodeBase.h"
 #include "fboss/agent/state/NodeMapIterator.h"
 
+namespace folly {
+class Executor;
+} // namespace folly
+
 namespace facebook::fboss {
 
 /*
@@ -33,7 +39,8 @@ struct NodeMapFields {
 
   template <typename Fn>
   void forEachChild(Fn fn) {
-    for (const auto& nodePtr : nodes) {
+    // Iterate const, so containers with copy-on-write storage don't unshare
+    for (const auto& nodePtr : std::as_const(nodes)) {
       fn(nodePtr.second.get());
     }
     extra.forEachChild(fn);
@@ -149,6 +156,13 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
    */
   folly::dynamic toFollyDynamic() const override;
 
+  /*
+   * Serialize to folly::dynamic with the nodes serialized in parallel on
+   * executor, see parallelTransform(). The result is the same as
+   * toFollyDynamic().
+   */
+  folly::dynamic toFollyDynamic(folly::Executor* executor) const;
+
   /*
    * Serialize to json string
    */
@@ -160,6 +174,9 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
    * Deserialize to folly::dynamic
    */
   static std::shared_ptr<MapTypeT> fromFollyDynamic(const folly::dynamic& json);
+  static std::shared_ptr<MapTypeT> fromFollyDynamic(
+      const folly::dynamic& json,
+      folly::Executor* executor);
 
  private:
   // Inherit the constructor required for clone()
@@ -30,11 +30,7 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
       newMap_(newMap),
       value_(nullNode_, nullNode_) {
   // Advance to the first difference
-  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-         *oldIt_ == *newIt_) {
-    ++oldIt_;
-    ++newIt_;
-  }
+  skipUnchanged();
   updateValue();
 }
 
@@ -60,8 +56,8 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
     value_.reset(*oldIt_, nullNode_);
     return;
   }
-  auto oldKey = Traits::getKey(*oldIt_);
-  auto newKey = Traits::getKey(*newIt_);
+  const auto& oldKey = oldIt_.key();
+  const auto& newKey = newIt_.key();
   if (oldKey < newKey) {
     value_.reset(*oldIt_, nullNode_);
   } else if (newKey < oldKey) {
@@ -89,8 +85,8 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
 
   // We aren't at the end of either side.
   // Check to see which one (or both) needs to be advanced.
-  auto oldKey = Traits::getKey(*oldIt_);
-  auto newKey = Traits::getKey(*newIt_);
+  const auto& oldKey = oldIt_.key();
+  const auto& newKey = newIt_.key();
   if (oldKey < newKey) {
     ++oldIt_;
   } else if (oldKey > newKey) {
@@ -101,12 +97,22 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
   }
 
   // Advance past any unchanged nodes.
-  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-         *oldIt_ == *newIt_) {
+  skipUnchanged();
+  updateValue();
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::skipUnchanged() {
+  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end()) {
+    if (oldIt_.skipShared(newIt_)) {
+      continue;
+    }
+    if (*oldIt_ != *newIt_) {
+      break;
+    }
     ++oldIt_;
     ++newIt_;
   }
-  updateValue();
 }
 
 } // namespace facebook::fboss
@@ -11,6 +11,23 @@
 
 #include <boost/container/flat_map.hpp>
 
+#include <type_traits>
+#include <utility>
+
+/*
+ * Whether _Storage can tell that a run of entries starting at two iterators
+ * is identical without comparing them (see ChunkedNodeContainer::skipShared).
+ */
+template <typename _Storage, typename = void>
+struct NodeMapStorageSkipsShared : std::false_type {};
+template <typename _Storage>
+struct NodeMapStorageSkipsShared<
+    _Storage,
+    std::void_t<decltype(_Storage::skipShared(
+        std::declval<typename _Storage::const_iterator&>(),
+        std::declval<typename _Storage::const_iterator&>()))>>
+    : std::true_type {};
+
 /*
  * NodeMapIterator is a very small wrapper around flat_map::const_iterator.
  *
@@ -35,6 +52,25 @@ class NodeMapIterator
     return &(it_->second);
   }
 
+  /*
+   * Key the node is stored under, without dereferencing the node itself.
+   */
+  const typename NodeContainer::key_type& key() const {
+    return it_->first;
+  }
+
+  /*
+   * Advance both this and other past a run of entries that the storage knows
+   * to be identical between the two, returning whether anything was skipped.
+   */
+  bool skipShared(NodeMapIterator& other) {
+    if constexpr (NodeMapStorageSkipsShared<NodeContainer>::value) {
+      return NodeContainer::skipShared(it_, other.it_);
+    } else {
+      return false;
+    }
+  }
+
   NodeMapIterator& operator++() {
     ++it_;
     return *this;
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace facebook::fboss {
+
+// Items transformed by each task of parallelTransform
+inline constexpr size_t kParallelTransformChunkSize = 256;
+
+/*
+ * Returns fn(item) for each of items, in the order of items.
+ *
+ * With an executor, items are transformed in chunks, each chunk a task of
+ * executor, so fn must be safe to call concurrently. The calling thread waits
+ * for the tasks and must therefore not be a thread of executor. Without an
+ * executor, items are transformed inline.
+ */
+template <typename T, typename Fn>
+auto parallelTransform(
+    folly::Executor* executor,
+    const std::vector<T>& items,
+    const Fn& fn) {
+  using Result = std::invoke_result_t<const Fn&, const T&>;
+  std::vector<Result> results;
+  results.reserve(items.size());
+  if (!executor || items.size() <= kParallelTransformChunkSize) {
+    for (const auto& item : items) {
+      results.push_back(fn(item));
+    }
+    return results;
+  }
+
+  std::vector<folly::Future<std::vector<Result>>> chunks;
+  for (size_t begin = 0; begin < items.size();
+       begin += kParallelTransformChunkSize) {
+    auto end = std::min(begin + kParallelTransformChunkSize, items.size());
+    chunks.push_back(folly::via(executor, [&items, &fn, begin, end]() {
+      std::vector<Result> chunk;
+      chunk.reserve(end - begin);
+      for (auto i = begin; i < end; i++) {
+        chunk.push_back(fn(items[i]));
+      }
+      return chunk;
+    }));
+  }
+  // Wait for every chunk before looking at failures, tasks reference items
+  for (auto& chunk : folly::collectAll(std::move(chunks)).get()) {
+    // rethrows the first failure, if any
+    for (auto& result : chunk.value()) {
+      results.push_back(std::move(result));
+    }
+  }
+  return results;
+}
+
+} // namespace facebook::fboss
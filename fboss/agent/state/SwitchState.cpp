@@ -31,6 +31,9 @@
 
 #include "fboss/agent/state/NodeBase-defs.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
 using std::make_shared;
 using std::shared_ptr;
 using std::chrono::seconds;
@@ -68,6 +71,12 @@ DEFINE_uint32(
     64,
     "Max ecmp width. Also implies ucmp normalization factor");
 
+DEFINE_int32(
+    switch_state_serialization_threads,
+    8,
+    "Threads converting the large parts of the switch state to and from "
+    "folly::dynamic and thrift, 1 to convert on the calling thread");
+
 namespace facebook::fboss {
 
 SwitchStateFields::SwitchStateFields()
@@ -87,21 +96,43 @@ SwitchStateFields::SwitchStateFields()
       switchSettings(make_shared<SwitchSettings>()),
       transceivers(make_shared<TransceiverMap>()) {}
 
+folly::Executor* SwitchStateFields::serializationExecutor() {
+  if (FLAGS_switch_state_serialization_threads <= 1) {
+    return nullptr;
+  }
+  // Never destroyed, the state is serialized while exiting
+  static auto* executor = new folly::CPUThreadPoolExecutor(
+      FLAGS_switch_state_serialization_threads,
+      std::make_shared<folly::NamedThreadFactory>("StateSerialize"));
+  return executor;
+}
+
 state::SwitchState SwitchStateFields::toThrift() const {
+  return toThrift(serializationExecutor());
+}
+
+state::SwitchState SwitchStateFields::toThrift(
+    folly::Executor* executor) const {
   auto state = state::SwitchState();
-  state.portMap() = ports->toThrift();
-  state.vlanMap() = vlans->toThrift();
-  state.aclMap() = acls->toThrift();
-  state.transceiverMap() = transceivers->toThrift();
+  state.portMap() = ports->toThrift(executor);
+  state.vlanMap() = vlans->toThrift(executor);
+  state.aclMap() = acls->toThrift(executor);
+  state.transceiverMap() = transceivers->toThrift(executor);
   return state;
 }
 
 SwitchStateFields SwitchStateFields::fromThrift(
     const state::SwitchState& state) {
+  return fromThrift(state, serializationExecutor());
+}
+
+SwitchStateFields SwitchStateFields::fromThrift(
+    const state::SwitchState& state,
+    folly::Executor* executor) {
   auto fields = SwitchStateFields();
-  fields.ports = PortMap::fromThrift(state.get_portMap());
-  fields.vlans = VlanMap::fromThrift(state.get_vlanMap());
-  fields.acls = AclMap::fromThrift(state.get_aclMap());
+  fields.ports = PortMap::fromThrift(state.get_portMap(), executor);
+  fields.vlans = VlanMap::fromThrift(state.get_vlanMap(), executor);
+  fields.acls = AclMap::fromThrift(state.get_aclMap(), executor);
   return fields;
 }
 
@@ -112,11 +143,16 @@ bool SwitchStateFields::operator==(const SwitchStateFields& other) const {
 }
 
 folly::dynamic SwitchStateFields::toFollyDynamic() const {
+  return toFollyDynamic(serializationExecutor());
+}
+
+folly::dynamic SwitchStateFields::toFollyDynamic(
+    folly::Executor* executor) const {
   folly::dynamic switchState = folly::dynamic::object;
   switchState[kInterfaces] = interfaces->toFollyDynamic();
-  switchState[kPorts] = ports->toFollyDynamic();
-  switchState[kVlans] = vlans->toFollyDynamic();
-  switchState[kAcls] = acls->toFollyDynamic();
+  switchState[kPorts] = ports->toFollyDynamic(executor);
+  switchState[kVlans] = vlans->toFollyDynamic(executor);
+  switchState[kAcls] = acls->toFollyDynamic(executor);
   switchState[kSflowCollectors] = sFlowCollectors->toFollyDynamic();
   switchState[kDefaultVlan] = static_cast<uint32_t>(defaultVlan);
   switchState[kControlPlane] = controlPlane->toFollyDynamic();
@@ -136,7 +172,7 @@ folly::dynamic SwitchStateFields::toFollyDynamic() const {
         defaultDataPlaneQosPolicy->toFollyDynamic();
   }
   switchState[kQosPolicies] = qosPolicies->toFollyDynamic();
-  switchState[kFibs] = fibs->toFollyDynamic();
+  switchState[kFibs] = fibs->toFollyDynamic(executor);
   switchState[kTransceivers] = transceivers->toFollyDynamic();
   if (aclTableGroups) {
     switchState[kAclTableGroups] = aclTableGroups->toFollyDynamic();
@@ -146,11 +182,17 @@ folly::dynamic SwitchStateFields::toFollyDynamic() const {
 
 SwitchStateFields SwitchStateFields::fromFollyDynamic(
     const folly::dynamic& swJson) {
+  return fromFollyDynamic(swJson, serializationExecutor());
+}
+
+SwitchStateFields SwitchStateFields::fromFollyDynamic(
+    const folly::dynamic& swJson,
+    folly::Executor* executor) {
   SwitchStateFields switchState;
   switchState.interfaces = InterfaceMap::fromFollyDynamic(swJson[kInterfaces]);
-  switchState.ports = PortMap::fromFollyDynamic(swJson[kPorts]);
-  switchState.vlans = VlanMap::fromFollyDynamic(swJson[kVlans]);
-  switchState.acls = AclMap::fromFollyDynamic(swJson[kAcls]);
+  switchState.ports = PortMap::fromFollyDynamic(swJson[kPorts], executor);
+  switchState.vlans = VlanMap::fromFollyDynamic(swJson[kVlans], executor);
+  switchState.acls = AclMap::fromFollyDynamic(swJson[kAcls], executor);
   if (swJson.count(kSflowCollectors) > 0) {
     switchState.sFlowCollectors =
         SflowCollectorMap::fromFollyDynamic(swJson[kSflowCollectors]);
@@ -204,7 +246,7 @@ SwitchStateFields SwitchStateFields::fromFollyDynamic(
   }
   if (swJson.find(kFibs) != swJson.items().end()) {
     switchState.fibs =
-        ForwardingInformationBaseMap::fromFollyDynamic(swJson[kFibs]);
+        ForwardingInformationBaseMap::fromFollyDynamic(swJson[kFibs], executor);
   }
   // TODO(joseph5wu) Will eventually make transceivers as a mandatory field
   if (const auto& values = swJson.find(kTransceivers);
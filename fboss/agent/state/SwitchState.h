@@ -89,6 +89,25 @@ struct SwitchStateFields : public ThriftyFields {
    */
   static SwitchStateFields fromFollyDynamic(const folly::dynamic& json);
 
+  /*
+   * The conversions above split the large subtrees of the state (ports,
+   * VLANs with their neighbor tables, ACLs and FIB routes) into tasks of
+   * serializationExecutor(). These variants take the executor to use, null
+   * to convert everything on the calling thread. The result is the same
+   * either way.
+   */
+  state::SwitchState toThrift(folly::Executor* executor) const;
+  static SwitchStateFields fromThrift(
+      const state::SwitchState& state,
+      folly::Executor* executor);
+  folly::dynamic toFollyDynamic(folly::Executor* executor) const;
+  static SwitchStateFields fromFollyDynamic(
+      const folly::dynamic& json,
+      folly::Executor* executor);
+
+  // Sized by --switch_state_serialization_threads, null if it is 1 or less
+  static folly::Executor* serializationExecutor();
+
   // Static state, which can be accessed without locking.
   std::shared_ptr<PortMap> ports;
   std::shared_ptr<AggregatePortMap> aggPorts;
@@ -10,6 +10,7 @@
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/state/NodeBase.h"
 #include "fboss/agent/state/NodeMap.h"
+#include "fboss/agent/state/ParallelTransform.h"
 
 namespace facebook::fboss {
 
@@ -130,61 +131,99 @@ class ThriftyNodeMapT : public NodeMapT<NodeMap, TraitsT> {
 
   using ThriftType = typename ThriftyTraitsT::NodeContainer;
 
+  /*
+   * The executor overloads convert the nodes in parallel on executor, see
+   * parallelTransform(), and give the same result as the plain versions.
+   */
   static std::shared_ptr<NodeMap> fromThrift(
-      const typename ThriftyTraitsT::NodeContainer& map) {
+      const typename ThriftyTraitsT::NodeContainer& map,
+      folly::Executor* executor = nullptr) {
     auto mapObj = std::make_shared<NodeMap>();
 
+    std::vector<const typename ThriftyTraitsT::Node*> items;
+    items.reserve(map.size());
     for (auto& node : map) {
-      auto fieldsObj = TraitsT::Node::Fields::fromThrift(node.second);
-      mapObj->addNode(std::make_shared<typename TraitsT::Node>(fieldsObj));
+      items.push_back(&node.second);
+    }
+    auto nodes = parallelTransform(executor, items, [](const auto* item) {
+      auto fieldsObj = TraitsT::Node::Fields::fromThrift(*item);
+      return std::make_shared<typename TraitsT::Node>(fieldsObj);
+    });
+    for (auto& node : nodes) {
+      mapObj->addNode(node);
     }
 
     return mapObj;
   }
 
-  static std::shared_ptr<NodeMap> fromFollyDynamic(folly::dynamic const& dyn) {
+  static std::shared_ptr<NodeMap> fromFollyDynamic(
+      folly::dynamic const& dyn,
+      folly::Executor* executor = nullptr) {
     if (ThriftyUtils::nodeNeedsMigration(dyn)) {
-      return fromFollyDynamicImpl(NodeMap::migrateToThrifty(dyn));
+      return fromFollyDynamicImpl(NodeMap::migrateToThrifty(dyn), executor);
     } else {
       // Schema is up to date meaning there is not migration required
-      return fromFollyDynamicImpl(dyn);
+      return fromFollyDynamicImpl(dyn, executor);
     }
   }
 
   static std::shared_ptr<NodeMap> fromFollyDynamicImpl(
-      folly::dynamic const& dyn) {
-    typename ThriftyTraitsT::NodeContainer mapTh;
+      folly::dynamic const& dyn,
+      folly::Executor* executor = nullptr) {
+    std::vector<const folly::dynamic*> values;
+    std::vector<typename ThriftyTraitsT::KeyType> keys;
     for (auto& [key, val] : dyn.items()) {
       if (key == kEntries || key == kExtraFields ||
           key == ThriftyUtils::kThriftySchemaUpToDate) {
         continue;
       }
-      auto jsonStr = folly::toJson(val);
+      keys.push_back(ThriftyTraitsT::parseKey(key));
+      values.push_back(&val);
+    }
+    auto nodes = parallelTransform(executor, values, [](const auto* val) {
+      auto jsonStr = folly::toJson(*val);
       auto inBuf =
           folly::IOBuf::wrapBufferAsValue(jsonStr.data(), jsonStr.size());
-      auto node = apache::thrift::SimpleJSONSerializer::deserialize<
+      return apache::thrift::SimpleJSONSerializer::deserialize<
           typename ThriftyTraitsT::Node>(folly::io::Cursor{&inBuf});
-      mapTh[ThriftyTraitsT::parseKey(key)] = node;
+    });
+    typename ThriftyTraitsT::NodeContainer mapTh;
+    for (size_t i = 0; i < keys.size(); i++) {
+      mapTh[keys[i]] = std::move(nodes[i]);
     }
-    return fromThrift(mapTh);
+    return fromThrift(mapTh, executor);
   }
 
-  typename ThriftyTraitsT::NodeContainer toThrift() const {
+  typename ThriftyTraitsT::NodeContainer toThrift(
+      folly::Executor* executor = nullptr) const {
+    auto nodes = nodeList();
+    auto nodesTh = parallelTransform(executor, nodes, [](const auto& node) {
+      return node->getFields()->toThrift();
+    });
     typename ThriftyTraitsT::NodeContainer items;
-    for (auto& node : *this) {
-      items[getNodeThriftKey(node)] = node->getFields()->toThrift();
+    for (size_t i = 0; i < nodes.size(); i++) {
+      items[getNodeThriftKey(nodes[i])] = std::move(nodesTh[i]);
     }
 
     return items;
   }
 
   folly::dynamic toFollyDynamic() const override {
-    auto obj = this->toThrift();
-    folly::dynamic dyn = folly::dynamic::object();
-    for (auto& [key, val] : obj) {
+    return toFollyDynamic(nullptr);
+  }
+
+  folly::dynamic toFollyDynamic(folly::Executor* executor) const {
+    auto nodes = nodeList();
+    auto nodesJson = parallelTransform(executor, nodes, [](const auto& node) {
       std::string jsonStr;
-      apache::thrift::SimpleJSONSerializer::serialize(val, &jsonStr);
-      dyn[folly::to<std::string>(key)] = folly::parseJson(jsonStr);
+      apache::thrift::SimpleJSONSerializer::serialize(
+          node->getFields()->toThrift(), &jsonStr);
+      return folly::parseJson(jsonStr);
+    });
+    folly::dynamic dyn = folly::dynamic::object();
+    for (size_t i = 0; i < nodes.size(); i++) {
+      dyn[folly::to<std::string>(getNodeThriftKey(nodes[i]))] =
+          std::move(nodesJson[i]);
     }
 
     NodeMap::migrateFromThrifty(dyn);
@@ -264,6 +303,16 @@ class ThriftyNodeMapT : public NodeMapT<NodeMap, TraitsT> {
       const ThriftyNodeMapT<NodeMap, TraitsT, ThriftyTraitsT>& rhs) const {
     return !(*this == rhs);
   }
+
+ private:
+  std::vector<std::shared_ptr<typename TraitsT::Node>> nodeList() const {
+    std::vector<std::shared_ptr<typename TraitsT::Node>> nodes;
+    nodes.reserve(this->size());
+    for (auto& node : *this) {
+      nodes.push_back(node);
+    }
+    return nodes;
+  }
 };
 
 //
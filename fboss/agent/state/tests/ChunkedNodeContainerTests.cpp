@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/state/ChunkedNodeContainer.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace facebook::fboss;
+
+namespace {
+// Small chunks, so that tests exercise chunk splits and removals
+using TestContainer = ChunkedNodeContainer<int, std::shared_ptr<int>, 4>;
+
+void verifyEqual(
+    const TestContainer& container,
+    const std::map<int, int>& expected) {
+  ASSERT_EQ(container.size(), expected.size());
+  auto expectedIt = expected.begin();
+  for (const auto& [key, value] : container) {
+    EXPECT_EQ(key, expectedIt->first);
+    EXPECT_EQ(*value, expectedIt->second);
+    ++expectedIt;
+  }
+  auto expectedRit = expected.rbegin();
+  for (auto rit = container.rbegin(); rit != container.rend(); ++rit) {
+    EXPECT_EQ(rit->first, expectedRit->first);
+    ++expectedRit;
+  }
+}
+} // namespace
+
+TEST(ChunkedNodeContainerTest, matchesStdMap) {
+  TestContainer container;
+  std::map<int, int> expected;
+  std::mt19937 rng(0);
+  for (auto i = 0; i < 10000; ++i) {
+    auto key = static_cast<int>(rng() % 200);
+    switch (rng() % 3) {
+      case 0: {
+        auto [it, inserted] =
+            container.insert(std::make_pair(key, std::make_shared<int>(i)));
+        EXPECT_EQ(inserted, expected.emplace(key, i).second);
+        EXPECT_EQ(it->first, key);
+        break;
+      }
+      case 1: {
+        auto it = container.find(key);
+        ASSERT_EQ(it == container.end(), expected.find(key) == expected.end());
+        if (it != container.end()) {
+          it->second = std::make_shared<int>(-i);
+          expected[key] = -i;
+        }
+        break;
+      }
+      case 2:
+        EXPECT_EQ(container.erase(key), expected.erase(key));
+        break;
+    }
+  }
+  verifyEqual(container, expected);
+}
+
+TEST(ChunkedNodeContainerTest, copiesAreIsolated) {
+  TestContainer original;
+  std::map<int, int> expected;
+  for (auto i = 0; i < 100; ++i) {
+    original.insert(std::make_pair(i, std::make_shared<int>(i)));
+    expected.emplace(i, i);
+  }
+
+  auto copy = original;
+  copy.find(10)->second = std::make_shared<int>(1000);
+  copy.erase(20);
+  copy.insert(std::make_pair(1000, std::make_shared<int>(1000)));
+
+  verifyEqual(original, expected);
+  EXPECT_EQ(*copy.find(10)->second, 1000);
+  EXPECT_EQ(copy.count(20), 0);
+  EXPECT_EQ(copy.size(), 100);
+}
+
+TEST(ChunkedNodeContainerTest, skipSharedChunks) {
+  TestContainer original;
+  for (auto i = 0; i < 100; ++i) {
+    original.insert(std::make_pair(i, std::make_shared<int>(i)));
+  }
+  auto copy = original;
+  copy.find(50)->second = std::make_shared<int>(-50);
+
+  const auto& lhs = original;
+  const auto& rhs = copy;
+  auto lhsIt = lhs.begin();
+  auto rhsIt = rhs.begin();
+  auto skipped = 0;
+  auto compared = 0;
+  while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
+    if (TestContainer::skipShared(lhsIt, rhsIt)) {
+      ++skipped;
+      continue;
+    }
+    EXPECT_EQ(lhsIt->first, rhsIt->first);
+    ++compared;
+    ++lhsIt;
+    ++rhsIt;
+  }
+  EXPECT_TRUE(lhsIt == lhs.end());
+  EXPECT_TRUE(rhsIt == rhs.end());
+  // Entries added in order fill their chunks, and only the chunk holding the
+  // modified entry is walked entry by entry
+  EXPECT_EQ(skipped, 100 / 4 - 1);
+  EXPECT_EQ(compared, 4);
+}
@@ -10,6 +10,7 @@
 
 #include "fboss/agent/state/MacEntry.h"
 #include "fboss/agent/state/MacTable.h"
+#include "fboss/agent/state/NodeMapDelta-defs.h"
 #include "fboss/agent/test/TestUtils.h"
 
 #include <gtest/gtest.h>
@@ -34,3 +35,41 @@ TEST(MacTableTest, thriftyConversion) {
 
   validateThriftyMigration(table);
 }
+
+TEST(MacTableTest, deltaAtScale) {
+  constexpr auto kNumMacs = 100000;
+  auto table = std::make_shared<MacTable>();
+  for (auto i = 0; i < kNumMacs; ++i) {
+    table->addEntry(std::make_shared<MacEntry>(
+        folly::MacAddress::fromHBO(kTestMac1.u64HBO() + i),
+        PortDescriptor(PortID(1))));
+  }
+  table->publish();
+
+  auto newTable = table->clone();
+  auto removedMac = folly::MacAddress::fromHBO(kTestMac1.u64HBO() + 10);
+  auto changedMac = folly::MacAddress::fromHBO(kTestMac1.u64HBO() + 50000);
+  auto addedMac = folly::MacAddress::fromHBO(kTestMac1.u64HBO() + kNumMacs);
+  newTable->removeEntry(removedMac);
+  newTable->updateEntry(changedMac, PortDescriptor(PortID(2)), std::nullopt);
+  newTable->addEntry(
+      std::make_shared<MacEntry>(addedMac, PortDescriptor(PortID(1))));
+
+  EXPECT_EQ(table->size(), kNumMacs);
+  EXPECT_EQ(newTable->size(), kNumMacs);
+  EXPECT_EQ(table->getMacIf(changedMac)->getPort(), PortDescriptor(PortID(1)));
+
+  std::vector<folly::MacAddress> removed, changed, added;
+  for (const auto& delta : MacTableDelta(table.get(), newTable.get())) {
+    if (!delta.getNew()) {
+      removed.push_back(delta.getOld()->getMac());
+    } else if (!delta.getOld()) {
+      added.push_back(delta.getNew()->getMac());
+    } else {
+      changed.push_back(delta.getNew()->getMac());
+    }
+  }
+  EXPECT_EQ(removed, std::vector<folly::MacAddress>{removedMac});
+  EXPECT_EQ(changed, std::vector<folly::MacAddress>{changedMac});
+  EXPECT_EQ(added, std::vector<folly::MacAddress>{addedMac});
+}
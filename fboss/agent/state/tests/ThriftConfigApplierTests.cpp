@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/BufferPoolConfigMap.h"
+#include "fboss/agent/state/LoadBalancerMap.h"
+#include "fboss/agent/state/QosPolicyMap.h"
+#include "fboss/agent/state/SflowCollectorMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+
+namespace {
+
+cfg::AclEntry makeAcl(const std::string& name) {
+  cfg::AclEntry acl;
+  acl.name() = name;
+  acl.dscp() = 8;
+  acl.actionType() = cfg::AclActionType::DENY;
+  return acl;
+}
+
+cfg::QosPolicy makeQosPolicy(const std::string& name) {
+  cfg::QosRule rule;
+  rule.queueId() = 7;
+  *rule.dscp() = {46};
+  cfg::QosPolicy policy;
+  policy.name() = name;
+  *policy.rules() = {rule};
+  return policy;
+}
+
+cfg::SflowCollector makeSflowCollector(const std::string& ip) {
+  cfg::SflowCollector collector;
+  collector.ip() = ip;
+  collector.port() = 6343;
+  return collector;
+}
+
+cfg::LoadBalancer makeEcmpLoadBalancer() {
+  cfg::Fields fields;
+  *fields.ipv4Fields() = {
+      cfg::IPv4Field::SOURCE_ADDRESS, cfg::IPv4Field::DESTINATION_ADDRESS};
+  cfg::LoadBalancer loadBalancer;
+  loadBalancer.id() = cfg::LoadBalancerID::ECMP;
+  loadBalancer.fieldSelection() = fields;
+  loadBalancer.algorithm() = cfg::HashingAlgorithm::CRC16_CCITT;
+  return loadBalancer;
+}
+
+// A config with one entry in each section built only from config
+cfg::SwitchConfig makeConfig() {
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.acls()->push_back(makeAcl("acl1"));
+  config.qosPolicies()->push_back(makeQosPolicy("qp1"));
+  cfg::BufferPoolConfig bufferPool;
+  bufferPool.sharedBytes() = 10000;
+  bufferPool.headroomBytes() = 1000;
+  config.bufferPoolConfigs() = {{"pool1", bufferPool}};
+  config.sFlowCollectors()->push_back(makeSflowCollector("1.2.3.4"));
+  config.loadBalancers()->push_back(makeEcmpLoadBalancer());
+  return config;
+}
+
+// Sizes of the ACL, QoS policy, buffer pool, sFlow collector and load
+// balancer sections
+std::vector<size_t> getSectionSizes(const shared_ptr<SwitchState>& state) {
+  return {
+      state->getAcls()->size(),
+      state->getQosPolicies()->size(),
+      state->getBufferPoolCfgs() ? state->getBufferPoolCfgs()->size() : 0,
+      state->getSflowCollectors()->size(),
+      state->getLoadBalancers()->size()};
+}
+
+} // unnamed namespace
+
+class ThriftConfigApplierTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    platform_ = createMockPlatform();
+    config_ = makeConfig();
+    auto state = publishAndApplyConfig(
+        make_shared<SwitchState>(), &config_, platform_.get());
+    ASSERT_EQ(getSectionSizes(state), std::vector<size_t>(5, 1));
+
+    // Empty the sections in the state behind the applier's back, so that
+    // whether a section is applied again shows in the resulting state
+    state_ = state->clone();
+    state_->resetAcls(make_shared<AclMap>());
+    state_->resetQosPolicies(make_shared<QosPolicyMap>());
+    state_->resetBufferPoolCfgs(make_shared<BufferPoolCfgMap>());
+    state_->resetSflowCollectors(make_shared<SflowCollectorMap>());
+    state_->resetLoadBalancers(make_shared<LoadBalancerMap>());
+    state_->publish();
+  }
+
+  shared_ptr<SwitchState> applyConfig(
+      const cfg::SwitchConfig& config,
+      const cfg::SwitchConfig* prevConfig) {
+    return applyThriftConfig(
+        state_,
+        &config,
+        platform_.get(),
+        static_cast<RoutingInformationBase*>(nullptr),
+        prevConfig);
+  }
+
+ protected:
+  std::unique_ptr<MockPlatform> platform_;
+  cfg::SwitchConfig config_;
+  shared_ptr<SwitchState> state_;
+};
+
+TEST_F(ThriftConfigApplierTest, unchangedSectionsSkipped) {
+  // Nothing else changed either, so there is no new state at all
+  EXPECT_EQ(nullptr, applyConfig(config_, &config_));
+}
+
+TEST_F(ThriftConfigApplierTest, allSectionsAppliedWithoutPrevConfig) {
+  auto newState = applyConfig(config_, nullptr);
+  ASSERT_NE(nullptr, newState);
+  EXPECT_EQ(getSectionSizes(newState), std::vector<size_t>(5, 1));
+}
+
+TEST_F(ThriftConfigApplierTest, changedSectionReapplied) {
+  std::vector<std::function<void(cfg::SwitchConfig*)>> changeSection = {
+      [](auto* config) { config->acls()->push_back(makeAcl("acl2")); },
+      [](auto* config) {
+        config->qosPolicies()->push_back(makeQosPolicy("qp2"));
+      },
+      [](auto* config) {
+        (*config->bufferPoolConfigs())["pool2"] =
+            config->bufferPoolConfigs()->at("pool1");
+      },
+      [](auto* config) {
+        config->sFlowCollectors()->push_back(makeSflowCollector("5.6.7.8"));
+      },
+      [](auto* config) {
+        *config->loadBalancers()[0].fieldSelection()->ipv6Fields() = {
+            cfg::IPv6Field::SOURCE_ADDRESS};
+      },
+  };
+  for (size_t section = 0; section < changeSection.size(); ++section) {
+    SCOPED_TRACE(folly::to<std::string>("section ", section));
+    auto newConfig = config_;
+    changeSection[section](&newConfig);
+    auto newState = applyConfig(newConfig, &config_);
+    ASSERT_NE(nullptr, newState);
+
+    // Only the changed section is applied, the others stay empty
+    auto sizes = getSectionSizes(newState);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      if (i == section) {
+        EXPECT_GT(sizes[i], 0u);
+      } else {
+        EXPECT_EQ(sizes[i], 0u);
+      }
+    }
+  }
+}
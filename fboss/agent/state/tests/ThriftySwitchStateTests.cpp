@@ -11,10 +11,15 @@
 // #include <folly/IPAddress.h>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/state/ArpResponseTable.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/ParallelTransform.h"
 #include "fboss/agent/state/PortDescriptor.h"
+#include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 using namespace facebook::fboss;
 using folly::IPAddressV4;
 using folly::IPAddressV6;
@@ -136,3 +141,51 @@ TEST(ThriftySwitchState, TransceiverMap) {
   state.resetTransceivers(transceiverMap);
   verifySwitchStateSerialization(state);
 }
+
+TEST(ThriftySwitchState, ParallelSerialization) {
+  // Enough nodes for each subtree to be split in several tasks
+  constexpr int kNumNodes = 3 * kParallelTransformChunkSize;
+  auto vlanMap = std::make_shared<VlanMap>();
+  auto aclMap = std::make_shared<AclMap>();
+  auto fibV4 = std::make_shared<ForwardingInformationBaseV4>();
+  auto fibV6 = std::make_shared<ForwardingInformationBaseV6>();
+  RouteNextHopEntry drop(
+      RouteForwardAction::DROP, AdminDistance::MAX_ADMIN_DISTANCE);
+  for (int i = 1; i <= kNumNodes; i++) {
+    auto vlan = std::make_shared<Vlan>(VlanID(i), folly::to<std::string>(i));
+    vlan->setInterfaceID(InterfaceID(i));
+    vlanMap->addVlan(vlan);
+    aclMap->addEntry(
+        std::make_shared<AclEntry>(i, folly::to<std::string>("acl", i)));
+
+    RoutePrefixV4 prefixV4{
+        IPAddressV4::fromLongHBO(0x0a000000 + (i << 8)), 24};
+    fibV4->addNode(
+        std::make_shared<RouteV4>(prefixV4, ClientID::STATIC_ROUTE, drop));
+    RoutePrefixV6 prefixV6{
+        IPAddressV6(folly::to<std::string>("2401:db00:", i, "::")), 48};
+    fibV6->addNode(
+        std::make_shared<RouteV6>(prefixV6, ClientID::STATIC_ROUTE, drop));
+  }
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(RouterID(0));
+  fibContainer->setFib(fibV4);
+  fibContainer->setFib(fibV6);
+  auto fibs = std::make_shared<ForwardingInformationBaseMap>();
+  fibs->updateForwardingInformationBaseContainer(fibContainer);
+
+  auto state = SwitchState();
+  state.resetVlans(vlanMap);
+  state.resetAcls(aclMap);
+  state.resetForwardingInformationBases(fibs);
+
+  folly::CPUThreadPoolExecutor executor(4);
+  const auto& fields = *state.getFields();
+  auto json = fields.toFollyDynamic(nullptr);
+  EXPECT_EQ(json, fields.toFollyDynamic(&executor));
+  auto thrift = fields.toThrift(nullptr);
+  EXPECT_EQ(thrift, fields.toThrift(&executor));
+
+  EXPECT_EQ(fields, SwitchStateFields::fromFollyDynamic(json, &executor));
+  EXPECT_EQ(fields, SwitchStateFields::fromThrift(thrift, &executor));
+}
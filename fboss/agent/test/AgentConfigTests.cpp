@@ -11,9 +11,12 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/AgentConfig.h"
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/gen-cpp2/agent_config_types.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 using namespace facebook::fboss;
@@ -95,3 +98,49 @@ TEST(AgentConfigTest, AcceptsNewAndOldStyleConfigs) {
 
   EXPECT_EQ(fromOldStyle->swConfigRaw(), fromNewStyle->swConfigRaw());
 }
+
+TEST(AgentConfigTest, BinaryConfigRoundTrip) {
+  auto config = AgentConfig::fromRawConfig(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+          createAgentConfig()));
+  auto binary = config->binaryConfigRaw();
+  ASSERT_TRUE(AgentConfig::isBinaryConfig(folly::StringPiece(binary)));
+  EXPECT_FALSE(AgentConfig::isBinaryConfig(folly::StringPiece(config->raw)));
+
+  auto fromBinary = AgentConfig::fromBinaryConfig(folly::StringPiece(binary));
+  EXPECT_EQ(fromBinary->thrift, config->thrift);
+  EXPECT_TRUE(fromBinary->raw.empty());
+
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "agent.conf.bin").string();
+  folly::writeFile(binary, path.c_str());
+  EXPECT_EQ(AgentConfig::fromBinaryFile(path)->thrift, config->thrift);
+  // fromFile accepts either format
+  EXPECT_EQ(AgentConfig::fromFile(path)->thrift, config->thrift);
+
+  EXPECT_THROW(
+      AgentConfig::fromBinaryConfig(folly::StringPiece(config->raw)),
+      FbossError);
+  EXPECT_THROW(
+      AgentConfig::fromBinaryConfig(
+          folly::StringPiece(binary).subpiece(0, binary.size() / 2)),
+      FbossError);
+}
+
+TEST(AgentConfigTest, SwitchConfigHash) {
+  auto config = createSwitchConfig();
+  EXPECT_EQ(switchConfigHash(config), switchConfigHash(createSwitchConfig()));
+  *config.arpTimeoutSeconds() = 2;
+  EXPECT_NE(switchConfigHash(config), switchConfigHash(createSwitchConfig()));
+}
+
+TEST(AgentConfigTest, AgentConfigHash) {
+  cfg::AgentConfig config;
+  *config.sw() = createSwitchConfig();
+  auto hash = agentConfigHash(config);
+  // Changes outside of the switch config change the hash too
+  config.defaultCommandLineArgs()["fake_flag"] = "1";
+  EXPECT_NE(agentConfigHash(config), hash);
+  EXPECT_EQ(
+      switchConfigHash(*config.sw()), switchConfigHash(createSwitchConfig()));
+}
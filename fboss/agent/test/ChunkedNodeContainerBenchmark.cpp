@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Compares the memory and clone cost of MacTable's ChunkedNodeContainer
+ * with the flat_map of shared_ptr nodes NodeMaps use by default.
+ *
+ * Bytes are counted by replacing the global operator new/delete of this
+ * binary, including allocator slack as reported by malloc_usable_size().
+ * Entries are MacEntry nodes in both cases, so the bytes of the nodes
+ * themselves are reported separately from the bytes of the container.
+ */
+
+#include <boost/container/flat_map.hpp>
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+#include <gflags/gflags.h>
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "fboss/agent/state/MacTable.h"
+
+namespace {
+std::atomic<int64_t> liveBytes{0};
+} // namespace
+
+void* operator new(size_t size) {
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  liveBytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr) {
+    liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    std::free(ptr);
+  }
+}
+
+void operator delete(void* ptr, size_t /* size */) noexcept {
+  operator delete(ptr);
+}
+
+using namespace facebook::fboss;
+
+namespace {
+using FlatMapContainer =
+    boost::container::flat_map<folly::MacAddress, std::shared_ptr<MacEntry>>;
+using ChunkedContainer = MacTableTraits::NodeContainer;
+
+std::vector<std::shared_ptr<MacEntry>> makeEntries(size_t numEntries) {
+  std::vector<std::shared_ptr<MacEntry>> entries;
+  entries.reserve(numEntries);
+  for (size_t i = 0; i < numEntries; ++i) {
+    entries.push_back(std::make_shared<MacEntry>(
+        folly::MacAddress::fromHBO(0x020000000000 + i),
+        PortDescriptor(PortID(i % 64 + 1))));
+  }
+  return entries;
+}
+
+template <typename Container>
+Container makeContainer(const std::vector<std::shared_ptr<MacEntry>>& entries) {
+  Container container;
+  for (const auto& entry : entries) {
+    container.insert(std::make_pair(entry->getMac(), entry));
+  }
+  return container;
+}
+
+// A copy of container with one entry replaced, as cloning a NodeMap to
+// update one node does
+template <typename Container>
+Container cloneAndUpdate(
+    const Container& container,
+    const std::shared_ptr<MacEntry>& newEntry) {
+  auto copy = container;
+  copy.find(newEntry->getMac())->second = newEntry;
+  return copy;
+}
+
+template <typename Container>
+void reportBytes(const char* name, size_t numEntries) {
+  auto before = liveBytes.load();
+  auto entries = makeEntries(numEntries);
+  auto nodeBytes = liveBytes.load() - before;
+  auto container = makeContainer<Container>(entries);
+  auto containerBytes = liveBytes.load() - before - nodeBytes;
+  auto newEntry = entries[numEntries / 2]->clone();
+  auto beforeClone = liveBytes.load();
+  auto copy = cloneAndUpdate(container, newEntry);
+  auto cloneBytes = liveBytes.load() - beforeClone;
+  std::cout << name << " " << numEntries << " entries: "
+            << static_cast<double>(nodeBytes) / numEntries
+            << " node bytes/entry, "
+            << static_cast<double>(containerBytes) / numEntries
+            << " container bytes/entry, " << cloneBytes
+            << " bytes to clone and update one entry" << std::endl;
+}
+
+template <typename Container>
+void cloneAndUpdateOne(size_t iters, size_t numEntries) {
+  std::vector<std::shared_ptr<MacEntry>> entries;
+  Container container;
+  std::shared_ptr<MacEntry> newEntry;
+  BENCHMARK_SUSPEND {
+    entries = makeEntries(numEntries);
+    container = makeContainer<Container>(entries);
+    newEntry = entries[numEntries / 2]->clone();
+  }
+  for (size_t iter = 0; iter < iters; ++iter) {
+    auto copy = cloneAndUpdate(container, newEntry);
+    folly::doNotOptimizeAway(copy.size());
+    BENCHMARK_SUSPEND {
+      copy = Container();
+    }
+  }
+}
+
+void flatMapCloneAndUpdateOne(size_t iters, size_t numEntries) {
+  cloneAndUpdateOne<FlatMapContainer>(iters, numEntries);
+}
+void chunkedCloneAndUpdateOne(size_t iters, size_t numEntries) {
+  cloneAndUpdateOne<ChunkedContainer>(iters, numEntries);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(flatMapCloneAndUpdateOne, 10000);
+BENCHMARK_RELATIVE_PARAM(chunkedCloneAndUpdateOne, 10000);
+BENCHMARK_PARAM(flatMapCloneAndUpdateOne, 100000);
+BENCHMARK_RELATIVE_PARAM(chunkedCloneAndUpdateOne, 100000);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  for (auto numEntries : {10000, 100000}) {
+    reportBytes<FlatMapContainer>("flat_map", numEntries);
+    reportBytes<ChunkedContainer>("chunked", numEntries);
+  }
+  folly::runBenchmarks();
+  return 0;
+}
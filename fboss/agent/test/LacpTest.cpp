@@ -7,6 +7,8 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <memory>
@@ -24,6 +26,7 @@
 #include <folly/logging/xlog.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/system/ThreadName.h>
+#include <gflags/gflags.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -31,13 +34,19 @@
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/TxPacket.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/test/CounterCache.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
+#include "fboss/agent/test/TrunkUtils.h"
 #include "fboss/agent/types.h"
 
 using namespace facebook::fboss;
+using ::testing::_;
+using ::testing::AnyNumber;
+
+DECLARE_int32(lacp_event_base_shards);
 
 namespace {
 
@@ -203,6 +212,32 @@ class LacpServiceInterceptor : public LacpServicerIf {
   SwSwitch* sw_{nullptr};
 };
 
+/*
+ * Records the time of every LACPDU transmission, in addition to what
+ * LacpServiceInterceptor tracks.
+ */
+class TimestampingLacpServiceInterceptor : public LacpServiceInterceptor {
+ public:
+  using Timestamps = std::vector<std::chrono::steady_clock::time_point>;
+
+  explicit TimestampingLacpServiceInterceptor(folly::EventBase* lacpEvb)
+      : LacpServiceInterceptor(lacpEvb) {}
+
+  bool transmit(LACPDU lacpdu, PortID portID) override {
+    (*portToTransmissionTimes_.wlock())[portID].push_back(
+        std::chrono::steady_clock::now());
+    return LacpServiceInterceptor::transmit(lacpdu, portID);
+  }
+
+  boost::container::flat_map<PortID, Timestamps> transmissionTimes() {
+    return *portToTransmissionTimes_.rlock();
+  }
+
+ private:
+  folly::Synchronized<boost::container::flat_map<PortID, Timestamps>>
+      portToTransmissionTimes_;
+};
+
 class MockLacpServicer : public LacpServicerIf {
   void enableForwardingAndSetPartnerState(
       PortID portID,
@@ -1288,3 +1323,174 @@ TEST_F(LacpTest, lacpDownCounters) {
   // both members should timeout
   counters.checkDelta(SwitchStats::kCounterPrefix + "lacp.rx_timeout.sum", 2);
 }
+
+/*
+ * Scale scenario for a single LACP EventBase: many FAST rate members, each
+ * transmitting periodically off the EventBase's timer wheel. Logs how far
+ * behind SHORT_PERIOD the periodic transmissions actually fire. Wall clock
+ * timings depend on the load of the test host, so only a typical slippage of
+ * a whole period, i.e. timers falling behind for good, fails the test.
+ */
+TEST_F(LacpTest, periodicTransmissionTimerSlippageAtScale) {
+  constexpr auto kNumPorts = 512;
+  TimestampingLacpServiceInterceptor interceptor(lacpEvb());
+
+  std::vector<std::shared_ptr<LacpController>> controllers;
+  for (auto i = 1; i <= kNumPorts; ++i) {
+    auto controller = std::make_shared<LacpController>(
+        PortID(i),
+        lacpEvb(),
+        32768 /* port priority */,
+        cfg::LacpPortRate::FAST,
+        cfg::LacpPortActivity::ACTIVE,
+        cfg::switch_config_constants::DEFAULT_LACP_HOLD_TIMER_MULTIPLIER(),
+        AggregatePortID(i),
+        65535 /* system priority */,
+        MacAddress("02:90:fb:5e:1e:8d"),
+        1 /* minimum-link count */,
+        &interceptor);
+    interceptor.addController(controller);
+    controllers.push_back(controller);
+  }
+
+  // A partner requesting SHORT_TIMEOUT puts the periodic transmission
+  // machines on the fast period
+  ParticipantInfo partnerActorInfo;
+  partnerActorInfo.systemPriority = 32768;
+  partnerActorInfo.systemID = {{0x00, 0x1c, 0x73, 0x5b, 0xa8, 0x47}};
+  partnerActorInfo.portPriority = 32768;
+  partnerActorInfo.state =
+      LacpState::ACTIVE | LacpState::AGGREGATABLE | LacpState::SHORT_TIMEOUT;
+  for (const auto& controller : controllers) {
+    controller->startMachines();
+    controller->portUp();
+    partnerActorInfo.key = static_cast<uint16_t>(controller->portID());
+    partnerActorInfo.port = static_cast<uint16_t>(controller->portID());
+    controller->received(LACPDU(
+        partnerActorInfo, ParticipantInfo::defaultParticipantInfo()));
+  }
+
+  std::this_thread::sleep_for(PeriodicTransmissionMachine::SHORT_PERIOD * 3);
+
+  for (const auto& controller : controllers) {
+    controller->stopMachines();
+  }
+
+  // Transmissions triggered by state changes rather than the periodic timer
+  // come in much closer together than SHORT_PERIOD, skip those
+  const auto kMinPeriodicInterval =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          PeriodicTransmissionMachine::SHORT_PERIOD) /
+      2;
+  std::vector<std::chrono::milliseconds> slippages;
+  for (const auto& [port, times] : interceptor.transmissionTimes()) {
+    for (size_t i = 1; i < times.size(); ++i) {
+      auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(
+          times[i] - times[i - 1]);
+      if (interval < kMinPeriodicInterval) {
+        continue;
+      }
+      slippages.push_back(std::max(
+          std::chrono::milliseconds(0),
+          interval - PeriodicTransmissionMachine::SHORT_PERIOD));
+    }
+  }
+  ASSERT_FALSE(slippages.empty());
+  std::sort(slippages.begin(), slippages.end());
+
+  auto p50 = slippages[slippages.size() / 2];
+  auto p99 = slippages[slippages.size() * 99 / 100];
+  auto max = slippages.back();
+  XLOG(INFO) << "Periodic transmission timer slippage over " << kNumPorts
+             << " ports, " << slippages.size() << " periods: p50 "
+             << p50.count() << "ms, p99 " << p99.count() << "ms, max "
+             << max.count() << "ms";
+  EXPECT_LT(p50, PeriodicTransmissionMachine::SHORT_PERIOD);
+}
+
+/*
+ * SwSwitch with LACP sharded across two event bases, aggregate port 1 (port
+ * 1) and aggregate port 2 (port 2) landing on different shards. Port 3 is
+ * not part of any aggregate port.
+ */
+class LacpShardTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_lacp_event_base_shards = 2;
+    cfg::SwitchConfig config;
+    config.ports()->resize(3);
+    config.vlanPorts()->resize(3);
+    for (auto i = 0; i < 3; ++i) {
+      preparedMockPortConfig(config.ports()[i], i + 1);
+      *config.vlanPorts()[i].logicalPort() = i + 1;
+      *config.vlanPorts()[i].vlanID() = 1;
+      *config.vlanPorts()[i].emitTags() = false;
+    }
+    config.vlans()->resize(1);
+    *config.vlans()[0].id() = 1;
+    *config.vlans()[0].name() = "vlan1";
+    utility::addAggPort(1, {1}, &config);
+    utility::addAggPort(2, {2}, &config);
+
+    handle_ = createTestHandle(&config, SwitchFlags::ENABLE_LACP);
+    sw_ = handle_->getSw();
+    waitForStateUpdates(sw_);
+  }
+
+  // Restores the flags once the SwSwitch is gone
+  gflags::FlagSaver flagSaver_;
+  std::unique_ptr<HwTestHandle> handle_;
+  SwSwitch* sw_{nullptr};
+};
+
+TEST_F(LacpShardTest, aggregatePortMembersRunOnTheirShard) {
+  auto evbs = sw_->getLacpEvbs();
+  ASSERT_EQ(evbs.size(), 2);
+  EXPECT_EQ(sw_->getLacpEvb(AggregatePortID(1)), evbs[1]);
+  EXPECT_EQ(sw_->getLacpEvb(AggregatePortID(2)), evbs[0]);
+
+  for (auto [aggPortID, portID] :
+       {std::make_pair(AggregatePortID(1), PortID(1)),
+        std::make_pair(AggregatePortID(2), PortID(2))}) {
+    auto* evb = sw_->getLacpEvb(aggPortID);
+    evb->runInEventBaseThreadAndWait([&]() {
+      std::vector<PortID> ports{portID};
+      auto controllers = sw_->getLagManager()->getControllersFor(
+          folly::range(ports.cbegin(), ports.cend()));
+      ASSERT_EQ(controllers.size(), 1);
+      ASSERT_NE(controllers[0], nullptr);
+      EXPECT_EQ(controllers[0]->evb(), evb);
+    });
+  }
+}
+
+TEST_F(LacpShardTest, lacpdusTransmittedAtEndOfLoopPerShard) {
+  constexpr auto kNumLacpdus = 8;
+  auto evbs = sw_->getLacpEvbs();
+  std::atomic<int> numSent{0};
+  // Members of the aggregate ports may transmit on their own
+  EXPECT_HW_CALL(sw_, sendPacketOutOfPortAsync_(_, _, _)).Times(AnyNumber());
+  EXPECT_HW_CALL(sw_, sendPacketOutOfPortAsync_(_, PortID(3), _))
+      .Times(kNumLacpdus * static_cast<int>(evbs.size()))
+      .WillRepeatedly(::testing::Invoke(
+          [&numSent](TxPacket*, PortID, std::optional<uint8_t>) {
+            numSent++;
+            return true;
+          }));
+
+  for (auto* evb : evbs) {
+    numSent = 0;
+    folly::Baton<> lacpdusSent;
+    evb->runInEventBaseThreadAndWait([&]() {
+      for (auto i = 0; i < kNumLacpdus; ++i) {
+        EXPECT_TRUE(sw_->getLagManager()->transmit(LACPDU(), PortID(3)));
+      }
+      // Nothing goes out until the end of the loop
+      EXPECT_EQ(numSent.load(), 0);
+      // Runs after the deferred tx, loop callbacks run in the order scheduled
+      evb->runInLoop([&lacpdusSent]() { lacpdusSent.post(); });
+    });
+    lacpdusSent.wait();
+    EXPECT_EQ(numSent.load(), kNumLacpdus);
+  }
+}
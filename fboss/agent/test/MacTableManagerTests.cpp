@@ -11,6 +11,8 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/state/MacEntry.h"
+#include "fboss/agent/state/MacTable.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
@@ -19,6 +21,8 @@
 
 #include <folly/MacAddress.h>
 
+#include <vector>
+
 namespace facebook::fboss {
 
 class MacTableManagerTest : public ::testing::Test {
@@ -77,6 +81,79 @@ class MacTableManagerTest : public ::testing::Test {
     });
   }
 
+  folly::MacAddress macAddress(int index) const {
+    return MacAddress::fromHBO(kMacAddress().u64HBO() + index);
+  }
+
+  /*
+   * Trigger callbacks for a burst of MACs back to back, without waiting for
+   * each of them to be applied, to exercise coalescing in MacTableManager.
+   */
+  void triggerMacCbBurst(
+      int numMacs,
+      const std::vector<L2EntryUpdateType>& l2EntryUpdateTypes) {
+    for (auto l2EntryUpdateType : l2EntryUpdateTypes) {
+      for (auto i = 0; i < numMacs; ++i) {
+        auto l2Entry = L2Entry(
+            macAddress(i),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+        sw_->l2LearningUpdateReceived(l2Entry, l2EntryUpdateType);
+      }
+    }
+
+    waitForBackgroundThread(sw_);
+    waitForStateUpdates(sw_);
+  }
+
+  void verifyMacTableSize(size_t expectedSize) {
+    verifyStateUpdate([=]() {
+      auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
+      EXPECT_EQ(expectedSize, vlan->getMacTable()->size());
+    });
+  }
+
+  /*
+   * Trigger callbacks for kMacAddress back to back, so that they may be
+   * applied in the same state update.
+   */
+  void triggerMacCbSequence(
+      const std::vector<std::pair<L2Entry, L2EntryUpdateType>>& updates) {
+    for (const auto& [l2Entry, l2EntryUpdateType] : updates) {
+      sw_->l2LearningUpdateReceived(l2Entry, l2EntryUpdateType);
+    }
+
+    waitForBackgroundThread(sw_);
+    waitForStateUpdates(sw_);
+  }
+
+  void addMacWithClassID(PortID portID, cfg::AclLookupClass classID) {
+    updateState(
+        "add MAC with classID",
+        [=](const std::shared_ptr<SwitchState>& state) {
+          auto newState = state->clone();
+          auto vlan = newState->getVlans()->getVlan(kVlan()).get();
+          auto* macTable = vlan->getMacTable()->modify(&vlan, &newState);
+          macTable->addEntry(std::make_shared<MacEntry>(
+              kMacAddress(), PortDescriptor(portID), classID));
+          return newState;
+        });
+  }
+
+  void verifyMacEntry(
+      PortID portID,
+      std::optional<cfg::AclLookupClass> classID) {
+    verifyStateUpdate([=]() {
+      auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
+      auto node = vlan->getMacTable()->getNodeIf(kMacAddress());
+
+      ASSERT_NE(nullptr, node);
+      EXPECT_EQ(portID, node->getPort().phyPortID());
+      EXPECT_EQ(classID, node->getClassID());
+    });
+  }
+
   void verifyMacIsDeleted() {
     verifyStateUpdate([=]() {
       auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
@@ -142,4 +219,106 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, MacLearnedCbScale) {
+  auto constexpr kNumMacs = 10000;
+  triggerMacCbBurst(kNumMacs, {L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD});
+
+  verifyMacTableSize(kNumMacs);
+}
+
+TEST_F(MacTableManagerTest, MacLearnedAndAgedCbScale) {
+  auto constexpr kNumMacs = 10000;
+  triggerMacCbBurst(
+      kNumMacs,
+      {L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD,
+       L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE});
+
+  verifyMacTableSize(0);
+}
+
+TEST_F(MacTableManagerTest, MacAgedAndLearnedCbScale) {
+  auto constexpr kNumMacs = 10000;
+  triggerMacCbBurst(kNumMacs, {L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD});
+  triggerMacCbBurst(
+      kNumMacs,
+      {L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE,
+       L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD});
+
+  verifyMacTableSize(kNumMacs);
+}
+
+TEST_F(MacTableManagerTest, MacAgedAndRelearnedOnSamePortCb) {
+  auto constexpr kClassID = cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1;
+  addMacWithClassID(kPortID(), kClassID);
+  verifyMacEntry(kPortID(), kClassID);
+
+  // The age of the entry with classID must not be coalesced away, else the
+  // relearn is a no-op and the stale classID survives.
+  triggerMacCbSequence(
+      {{L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED,
+            kClassID),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE},
+       {L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD}});
+
+  verifyMacEntry(kPortID(), std::nullopt);
+}
+
+TEST_F(MacTableManagerTest, MacAgedAndRelearnedOnOtherPortCb) {
+  auto constexpr kClassID = cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1;
+  auto const kOtherPortID = PortID(2);
+  addMacWithClassID(kPortID(), kClassID);
+
+  triggerMacCbSequence(
+      {{L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED,
+            kClassID),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE},
+       {L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kOtherPortID),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD}});
+
+  verifyMacEntry(kOtherPortID, std::nullopt);
+}
+
+TEST_F(MacTableManagerTest, MacLearnedAgedAndRelearnedCb) {
+  auto const kOtherPortID = PortID(2);
+  // A fresh learn which ages out and is relearned elsewhere, in one burst
+  triggerMacCbSequence(
+      {{L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD},
+       {L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kPortID()),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE},
+       {L2Entry(
+            kMacAddress(),
+            kVlan(),
+            PortDescriptor(kOtherPortID),
+            L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD}});
+
+  verifyMacEntry(kOtherPortID, std::nullopt);
+}
+
 } // namespace facebook::fboss
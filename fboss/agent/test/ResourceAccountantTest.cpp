@@ -0,0 +1,216 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/FbossHwUpdateError.h"
+#include "fboss/agent/Platform.h"
+#include "fboss/agent/ResourceAccountant.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/switch_asics/MockAsic.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/CounterCache.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteGeneratorTestUtils.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using ::testing::_;
+
+namespace {
+auto constexpr kChunkSize = 1000;
+} // namespace
+
+namespace facebook::fboss {
+
+class ResourceAccountantTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto cfg = getTestConfig();
+    handle_ = createTestHandle(&cfg);
+  }
+
+  SwSwitch* sw() const {
+    return handle_->getSw();
+  }
+
+  void resolveNextHops(const utility::RouteDistributionGenerator& generator) {
+    sw()->updateStateBlocking(
+        "resolve next hops", [&generator](const auto& state) {
+          return generator.resolveNextHops(state);
+        });
+  }
+
+  // Programs the routes of generator, returns the state after each chunk
+  std::vector<std::shared_ptr<SwitchState>> programRoutes(
+      const utility::RouteDistributionGenerator& generator) {
+    std::vector<std::shared_ptr<SwitchState>> states;
+    for (const auto& chunk : generator.getThriftRoutes()) {
+      auto updater = sw()->getRouteUpdater();
+      for (const auto& route : chunk) {
+        updater.addRoute(RouterID(0), ClientID::BGPD, route);
+      }
+      updater.program();
+      states.push_back(sw()->getState());
+    }
+    return states;
+  }
+
+  ResourceAccountant::Usage getUsage(
+      const std::shared_ptr<SwitchState>& state) const {
+    ResourceAccountant accountant(&unlimitedAsic_);
+    accountant.stateChanged(
+        StateDelta(std::make_shared<SwitchState>(), state));
+    return accountant.getUsage();
+  }
+
+ protected:
+  std::unique_ptr<HwTestHandle> handle_;
+  MockAsic asic_;
+  MockAsic unlimitedAsic_;
+};
+
+TEST_F(ResourceAccountantTest, routeTableOverflow) {
+  utility::RSWRouteScaleGenerator generator(sw()->getState(), kChunkSize);
+  resolveNextHops(generator);
+  auto initialState = sw()->getState();
+  auto states = programRoutes(generator);
+  ASSERT_GT(states.size(), 2);
+
+  // Room for every route but the last chunk
+  asic_.setMaxRouteTableSize(
+      getUsage(states[states.size() - 2]).routeEntries + 1);
+  ResourceAccountant accountant(&asic_);
+  accountant.stateChanged(
+      StateDelta(std::make_shared<SwitchState>(), initialState));
+  auto oldState = initialState;
+  for (size_t i = 0; i < states.size() - 1; i++) {
+    EXPECT_TRUE(accountant.isValidUpdate(StateDelta(oldState, states[i])));
+    accountant.stateChanged(StateDelta(oldState, states[i]));
+    oldState = states[i];
+  }
+  EXPECT_FALSE(accountant.isValidUpdate(StateDelta(oldState, states.back())));
+  // Rejecting doesn't change the accounted usage
+  EXPECT_EQ(
+      accountant.getUsage().routeEntries, getUsage(oldState).routeEntries);
+  // Going back is always fine
+  EXPECT_TRUE(accountant.isValidUpdate(StateDelta(oldState, initialState)));
+}
+
+TEST_F(ResourceAccountantTest, ecmpGroupsShared) {
+  utility::RSWRouteScaleGenerator generator(sw()->getState(), kChunkSize, 2);
+  resolveNextHops(generator);
+  auto initialState = sw()->getState();
+  auto states = programRoutes(generator);
+
+  ResourceAccountant accountant(&asic_);
+  accountant.stateChanged(
+      StateDelta(std::make_shared<SwitchState>(), initialState));
+  auto oldState = initialState;
+  for (const auto& state : states) {
+    accountant.stateChanged(StateDelta(oldState, state));
+    oldState = state;
+  }
+  // All v4 routes share one group, all v6 routes another
+  EXPECT_EQ(accountant.getUsage().ecmpGroups, 2);
+  EXPECT_EQ(accountant.getUsage().ecmpMembers, 4);
+
+  // Removing the routes frees the groups
+  accountant.stateChanged(StateDelta(oldState, initialState));
+  EXPECT_EQ(accountant.getUsage().ecmpGroups, 0);
+  EXPECT_EQ(accountant.getUsage().ecmpMembers, 0);
+}
+
+TEST_F(ResourceAccountantTest, ecmpOverflow) {
+  utility::RSWRouteScaleGenerator generator(sw()->getState(), kChunkSize, 2);
+  resolveNextHops(generator);
+  programRoutes(generator);
+  auto state = sw()->getState();
+  // Wider, so routes of a v4 and a v6 group of 4 members each
+  utility::RSWRouteScaleGenerator widerGenerator(state, kChunkSize, 4);
+  resolveNextHops(widerGenerator);
+  auto widerState = programRoutes(widerGenerator).back();
+
+  auto isValidUpdate = [&]() {
+    ResourceAccountant accountant(&asic_);
+    accountant.stateChanged(
+        StateDelta(std::make_shared<SwitchState>(), state));
+    return accountant.isValidUpdate(StateDelta(state, widerState));
+  };
+  EXPECT_TRUE(isValidUpdate());
+  asic_.setMaxEcmpGroups(3);
+  EXPECT_FALSE(isValidUpdate());
+  asic_.setMaxEcmpGroups(4);
+  EXPECT_TRUE(isValidUpdate());
+  asic_.setMaxEcmpMembers(11);
+  EXPECT_FALSE(isValidUpdate());
+  asic_.setMaxEcmpMembers(12);
+  EXPECT_TRUE(isValidUpdate());
+}
+
+TEST_F(ResourceAccountantTest, hostTableOverflow) {
+  utility::RSWRouteScaleGenerator generator(sw()->getState(), kChunkSize, 2);
+  auto state = sw()->getState();
+  auto resolvedState = generator.resolveNextHops(state);
+  resolvedState->publish();
+  // 2 ARP entries and 2 NDP entries, twice as wide
+  EXPECT_EQ(
+      getUsage(resolvedState).hostEntries - getUsage(state).hostEntries, 6);
+
+  asic_.setMaxHostTableSize(getUsage(state).hostEntries + 5);
+  ResourceAccountant accountant(&asic_);
+  accountant.stateChanged(StateDelta(std::make_shared<SwitchState>(), state));
+  EXPECT_FALSE(accountant.isValidUpdate(StateDelta(state, resolvedState)));
+  asic_.setMaxHostTableSize(getUsage(state).hostEntries + 6);
+  EXPECT_TRUE(accountant.isValidUpdate(StateDelta(state, resolvedState)));
+}
+
+TEST_F(ResourceAccountantTest, swSwitchRejectsOverflowingUpdate) {
+  utility::RSWRouteScaleGenerator generator(sw()->getState(), kChunkSize);
+  resolveNextHops(generator);
+  waitForStateUpdates(sw());
+  auto chunks = generator.getThriftRoutes();
+  ASSERT_FALSE(chunks.empty());
+  auto programChunk = [this, &chunk = chunks.front()]() {
+    auto updater = sw()->getRouteUpdater();
+    for (const auto& route : chunk) {
+      updater.addRoute(RouterID(0), ClientID::BGPD, route);
+    }
+    updater.program();
+  };
+
+  // No room for a single route more on the ASIC of the switch
+  auto* asic = static_cast<MockAsic*>(sw()->getPlatform()->getAsic());
+  auto oldState = sw()->getState();
+  asic->setMaxRouteTableSize(getUsage(oldState).routeEntries);
+  CounterCache counters(sw());
+  // The rejected update never reaches the hardware
+  EXPECT_HW_CALL(sw(), stateChanged(_)).Times(0);
+  EXPECT_HW_CALL(sw(), stateChangedTransaction(_)).Times(0);
+  EXPECT_THROW(programChunk(), FbossHwUpdateError);
+  counters.update();
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "hw_resource_rejected_updates", 1);
+  EXPECT_EQ(sw()->getState(), oldState);
+  ::testing::Mock::VerifyAndClearExpectations(getMockHw(sw()));
+
+  // The same update goes through once it fits
+  asic->setMaxRouteTableSize(std::nullopt);
+  EXPECT_MANY_HW_CALLS(sw(), stateChanged(_));
+  programChunk();
+  counters.update();
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "hw_resource_rejected_updates", 0);
+  EXPECT_GT(
+      getUsage(sw()->getState()).routeEntries,
+      getUsage(oldState).routeEntries);
+}
+
+} // namespace facebook::fboss
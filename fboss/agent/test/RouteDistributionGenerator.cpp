@@ -128,7 +128,9 @@ RouteDistributionGenerator::allThriftRoutes() const {
 template <typename AddrT>
 const std::vector<UnresolvedNextHop>& RouteDistributionGenerator::getNhops()
     const {
-  static std::vector<UnresolvedNextHop> nhops;
+  // Cached per generator, generators may have different ECMP widths
+  auto& nhops =
+      std::is_same_v<AddrT, folly::IPAddressV6> ? v6Nhops_ : v4Nhops_;
   if (nhops.size()) {
     return nhops;
   }
@@ -126,6 +126,8 @@ class RouteDistributionGenerator {
    */
   mutable std::optional<RouteChunks> generatedRouteChunks_;
   mutable std::optional<ThriftRouteChunks> generatedThriftRoutes_;
+  mutable std::vector<UnresolvedNextHop> v4Nhops_;
+  mutable std::vector<UnresolvedNextHop> v6Nhops_;
 };
 
 } // namespace facebook::fboss::utility
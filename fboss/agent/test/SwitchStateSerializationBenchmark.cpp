@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/NdpTable.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+using namespace facebook::fboss;
+using folly::IPAddressV4;
+using folly::IPAddressV6;
+
+namespace {
+static constexpr int kNumVlans = 64;
+static constexpr int kNumNeighborsPerVlan = 64;
+static constexpr int kNumAcls = 1000;
+static constexpr int kNumRoutes = 50000;
+static constexpr int kNumThreads = 8;
+
+std::shared_ptr<SwitchState> buildState() {
+  auto vlans = std::make_shared<VlanMap>();
+  for (int vlanIdx = 1; vlanIdx <= kNumVlans; ++vlanIdx) {
+    auto vlan = std::make_shared<Vlan>(VlanID(vlanIdx), "vlan");
+    vlan->setInterfaceID(InterfaceID(vlanIdx));
+    auto arpTable = std::make_shared<ArpTable>();
+    auto ndpTable = std::make_shared<NdpTable>();
+    for (int nbrIdx = 1; nbrIdx <= kNumNeighborsPerVlan; ++nbrIdx) {
+      auto mac = folly::MacAddress::fromHBO(0x020000000000 + nbrIdx);
+      auto port = PortDescriptor(PortID(nbrIdx));
+      arpTable->addEntry(
+          IPAddressV4::fromLongHBO(0x0a000000 + (vlanIdx << 8) + nbrIdx),
+          mac,
+          port,
+          InterfaceID(vlanIdx));
+      ndpTable->addEntry(
+          IPAddressV6(fmt::format("2401:db00:{:x}::{:x}", vlanIdx, nbrIdx)),
+          mac,
+          port,
+          InterfaceID(vlanIdx));
+    }
+    vlan->setArpTable(arpTable);
+    vlan->setNdpTable(ndpTable);
+    vlans->addVlan(vlan);
+  }
+
+  auto acls = std::make_shared<AclMap>();
+  for (int aclIdx = 1; aclIdx <= kNumAcls; ++aclIdx) {
+    acls->addEntry(
+        std::make_shared<AclEntry>(aclIdx, fmt::format("acl{}", aclIdx)));
+  }
+
+  auto fibV4 = std::make_shared<ForwardingInformationBaseV4>();
+  auto fibV6 = std::make_shared<ForwardingInformationBaseV6>();
+  RouteNextHopEntry nhop(
+      ResolvedNextHop(IPAddressV6("2401:db00:1::1"), InterfaceID(1), 1),
+      AdminDistance::EBGP);
+  for (int routeIdx = 0; routeIdx < kNumRoutes; ++routeIdx) {
+    RoutePrefixV4 prefixV4{IPAddressV4::fromLongHBO(routeIdx << 8), 24};
+    fibV4->addNode(std::make_shared<RouteV4>(prefixV4, ClientID::BGPD, nhop));
+    RoutePrefixV6 prefixV6{
+        IPAddressV6(fmt::format("2401:{:x}:{:x}::", routeIdx >> 8, routeIdx)),
+        64};
+    fibV6->addNode(std::make_shared<RouteV6>(prefixV6, ClientID::BGPD, nhop));
+  }
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(RouterID(0));
+  fibContainer->setFib(fibV4);
+  fibContainer->setFib(fibV6);
+  auto fibs = std::make_shared<ForwardingInformationBaseMap>();
+  fibs->updateForwardingInformationBaseContainer(fibContainer);
+
+  auto state = std::make_shared<SwitchState>();
+  state->resetVlans(vlans);
+  state->resetAcls(acls);
+  state->resetForwardingInformationBases(fibs);
+  state->publish();
+  return state;
+}
+
+folly::Executor* getExecutor(bool parallel) {
+  static auto* executor = new folly::CPUThreadPoolExecutor(kNumThreads);
+  return parallel ? executor : nullptr;
+}
+} // namespace
+
+void SwitchStateToFollyDynamic(uint32_t /* iters */, bool parallel) {
+  std::shared_ptr<SwitchState> state;
+  BENCHMARK_SUSPEND {
+    state = buildState();
+  }
+  folly::doNotOptimizeAway(
+      state->getFields()->toFollyDynamic(getExecutor(parallel)));
+}
+
+void SwitchStateFromFollyDynamic(uint32_t /* iters */, bool parallel) {
+  folly::dynamic json;
+  BENCHMARK_SUSPEND {
+    json = buildState()->toFollyDynamic();
+  }
+  folly::doNotOptimizeAway(
+      SwitchStateFields::fromFollyDynamic(json, getExecutor(parallel)));
+}
+
+void SwitchStateToThrift(uint32_t /* iters */, bool parallel) {
+  std::shared_ptr<SwitchState> state;
+  BENCHMARK_SUSPEND {
+    state = buildState();
+  }
+  folly::doNotOptimizeAway(state->getFields()->toThrift(getExecutor(parallel)));
+}
+
+void SwitchStateFromThrift(uint32_t /* iters */, bool parallel) {
+  state::SwitchState thrift;
+  BENCHMARK_SUSPEND {
+    thrift = buildState()->toThrift();
+  }
+  folly::doNotOptimizeAway(
+      SwitchStateFields::fromThrift(thrift, getExecutor(parallel)));
+}
+
+BENCHMARK_PARAM(SwitchStateToFollyDynamic, false);
+BENCHMARK_PARAM(SwitchStateToFollyDynamic, true);
+BENCHMARK_PARAM(SwitchStateFromFollyDynamic, false);
+BENCHMARK_PARAM(SwitchStateFromFollyDynamic, true);
+BENCHMARK_PARAM(SwitchStateToThrift, false);
+BENCHMARK_PARAM(SwitchStateToThrift, true);
+BENCHMARK_PARAM(SwitchStateFromThrift, false);
+BENCHMARK_PARAM(SwitchStateFromThrift, true);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -24,8 +24,12 @@
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
 #include "fboss/agent/test/TestUtils.h"
+#include "fboss/lib/CommonUtils.h"
 
 #include <folly/IPAddress.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/BlockingWait.h>
+#endif
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
@@ -46,6 +50,8 @@ using ::testing::_;
 using ::testing::Return;
 using testing::UnorderedElementsAreArray;
 
+DECLARE_int32(route_table_stream_chunk_size);
+
 namespace {
 
 IpPrefix ipPrefix(StringPiece ip, int length) {
@@ -61,6 +67,36 @@ IpPrefix ipPrefix(const folly::CIDRNetwork& nw) {
   result.prefixLength() = nw.second;
   return result;
 }
+
+template <typename RouteT>
+std::vector<IpPrefix> routeDests(const std::vector<RouteT>& routes) {
+  std::vector<IpPrefix> result;
+  for (const auto& route : routes) {
+    result.push_back(*route.dest());
+  }
+  return result;
+}
+
+#if FOLLY_HAS_COROUTINES
+// Read up to maxEntries entries from stream as a client would, the stream is
+// cancelled if it has more
+template <typename T>
+std::vector<T> readStream(
+    apache::thrift::ServerStream<T>&& stream,
+    size_t maxEntries = std::numeric_limits<size_t>::max()) {
+  auto gen =
+      std::move(stream).toClientStreamUnsafeDoNotUse().toAsyncGenerator();
+  std::vector<T> entries;
+  while (entries.size() < maxEntries) {
+    auto next = folly::coro::blockingWait(gen.next());
+    if (!next) {
+      break;
+    }
+    entries.push_back(std::move(*next));
+  }
+  return entries;
+}
+#endif
 } // unnamed namespace
 
 class ThriftTest : public ::testing::Test {
@@ -132,6 +168,26 @@ TEST_F(ThriftTest, getHwDebugDump) {
   EXPECT_THROW(handler.getHwDebugDump(out), FbossError);
 }
 
+TEST_F(ThriftTest, startPktCaptureSnaplen) {
+  ThriftHandler handler(sw_);
+  auto captureInfo = [](std::optional<int32_t> snaplen) {
+    auto info = std::make_unique<CaptureInfo>();
+    info->name() = "snaplen";
+    info->maxPackets() = 10;
+    if (snaplen) {
+      info->snaplen() = *snaplen;
+    }
+    return info;
+  };
+  EXPECT_THROW(handler.startPktCapture(captureInfo(0)), FbossError);
+  EXPECT_THROW(handler.startPktCapture(captureInfo(-1)), FbossError);
+
+  handler.startPktCapture(captureInfo(64));
+  handler.stopPktCapture(std::make_unique<std::string>("snaplen"));
+  handler.startPktCapture(captureInfo(std::nullopt));
+  handler.stopPktCapture(std::make_unique<std::string>("snaplen"));
+}
+
 TEST(ThriftEnum, assertPortSpeeds) {
   // We rely on the exact value of the port speeds for some
   // logic, so we want to ensure that these values don't change.
@@ -1140,6 +1196,122 @@ TEST_F(ThriftTest, getRouteDetails) {
   EXPECT_EQ(10, routeDetails.size());
 }
 
+TEST_F(ThriftTest, getRouteDetailsPaginated) {
+  ThriftHandler handler(sw_);
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+
+  auto getAllPages = [&](const RouteTableFilter& filter) {
+    std::vector<RouteDetails> paged;
+    auto request = std::make_unique<RouteTablePageRequest>();
+    request->filter() = filter;
+    request->limit() = 3;
+    while (true) {
+      RouteDetailsPage page;
+      handler.getRouteTableDetailsPage(
+          page, std::make_unique<RouteTablePageRequest>(*request));
+      EXPECT_LE(page.routes()->size(), 3);
+      paged.insert(paged.end(), page.routes()->begin(), page.routes()->end());
+      if (!page.nextCursor()) {
+        break;
+      }
+      request->cursor() = *page.nextCursor();
+    }
+    return paged;
+  };
+  // Pages stitch back into the full table, in order
+  EXPECT_EQ(
+      routeDests(routeDetails), routeDests(getAllPages(RouteTableFilter())));
+
+  // Prefix filter only returns routes within the prefix
+  RouteTableFilter filter;
+  filter.vrf() = 0;
+  filter.prefix() = ipPrefix("10.0.0.0", 8);
+  std::vector<IpPrefix> expected;
+  for (const auto& dest : routeDests(routeDetails)) {
+    auto addr = facebook::network::toIPAddress(*dest.ip());
+    if (addr.isV4() && *dest.prefixLength() >= 8 &&
+        addr.inSubnet(IPAddress("10.0.0.0"), 8)) {
+      expected.push_back(dest);
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_THAT(
+      routeDests(getAllPages(filter)), UnorderedElementsAreArray(expected));
+
+  RouteTablePageRequest badRequest;
+  badRequest.limit() = 0;
+  RouteDetailsPage page;
+  EXPECT_THROW(
+      handler.getRouteTableDetailsPage(
+          page, std::make_unique<RouteTablePageRequest>(badRequest)),
+      FbossError);
+}
+
+#if FOLLY_HAS_COROUTINES
+TEST_F(ThriftTest, getRouteTableStreamChunkBoundaries) {
+  gflags::FlagSaver flagSaver;
+  ThriftHandler handler(sw_);
+  std::vector<UnicastRoute> routeTable;
+  handler.getRouteTable(routeTable);
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+  ASSERT_EQ(routeDetails.size(), 10u);
+
+  // Chunks of a single entry, ending just before, on and just after the
+  // last route, and larger than the whole table
+  for (auto chunkSize : {1, 2, 3, 9, 10, 11, 1000}) {
+    SCOPED_TRACE(folly::to<std::string>("chunk size ", chunkSize));
+    FLAGS_route_table_stream_chunk_size = chunkSize;
+    EXPECT_EQ(
+        routeDests(routeTable),
+        routeDests(readStream(handler.getRouteTableStream(
+            std::make_unique<RouteTableFilter>()))));
+    EXPECT_EQ(
+        routeDests(routeDetails),
+        routeDests(readStream(handler.getRouteTableDetailsStream(
+            std::make_unique<RouteTableFilter>()))));
+  }
+}
+
+TEST_F(ThriftTest, getRouteTableStreamClientCancels) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_route_table_stream_chunk_size = 2;
+  ThriftHandler handler(sw_);
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+
+  auto stream =
+      handler.getRouteTableDetailsStream(std::make_unique<RouteTableFilter>());
+  std::weak_ptr<SwitchState> pinnedState = sw_->getState();
+  // Move the switch on, so that only the stream holds the state it serves
+  sw_->updateStateBlocking(
+      "unpin stream state",
+      [](const std::shared_ptr<SwitchState>& state) { return state->clone(); });
+  EXPECT_NE(pinnedState.lock(), sw_->getState());
+
+  // Cancel midway through the second chunk
+  auto partial = readStream(std::move(stream), 3);
+  ASSERT_EQ(partial.size(), 3u);
+  auto allDests = routeDests(routeDetails);
+  EXPECT_EQ(
+      routeDests(partial),
+      std::vector<IpPrefix>(allDests.begin(), allDests.begin() + 3));
+
+  // The cancelled stream releases its state
+  WITH_RETRIES_N_TIMED(
+      { EXPECT_EVENTUALLY_TRUE(pinnedState.expired()); },
+      50,
+      std::chrono::milliseconds(10));
+
+  // and doesn't get in the way of later streams
+  EXPECT_EQ(
+      allDests,
+      routeDests(readStream(handler.getRouteTableDetailsStream(
+          std::make_unique<RouteTableFilter>()))));
+}
+#endif
+
 TEST_F(ThriftTest, getRouteTableByClient) {
   ThriftHandler handler(sw_);
   std::vector<UnicastRoute> routeTable;
@@ -44,6 +44,18 @@ void CmdGlobalOptions::init(CLI::App& app) {
       ->check(CLI::PositiveNumber);
   app.add_option(
       "--color", color_, "color (no, yes => yes for tty and no for pipe)");
+  app.add_option(
+         "--max-concurrency",
+         maxConcurrency_,
+         "Maximum number of hosts queried concurrently")
+      ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--host-timeout",
+         hostTimeoutMs_,
+         "Per host timeout in milliseconds, 0 to only rely on thrift timeouts. "
+         "A host that does not answer in time is reported as failed, and "
+         "the thrift connect, send and receive timeouts are capped to it")
+      ->check(CLI::NonNegativeNumber);
   app.add_option(
       "--filter",
       filters_,
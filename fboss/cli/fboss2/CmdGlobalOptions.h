@@ -122,6 +122,14 @@ class CmdGlobalOptions {
     return color_;
   }
 
+  int getMaxConcurrency() const {
+    return maxConcurrency_;
+  }
+
+  int getHostTimeoutMs() const {
+    return hostTimeoutMs_;
+  }
+
   // Setters for testing purposes
   void setAgentThriftPort(int port) {
     agentThriftPort_ = port;
@@ -153,6 +161,8 @@ class CmdGlobalOptions {
   int sensorServiceThriftPort_{5970};
   int dataCorralServiceThriftPort_{5971};
   std::string color_{"yes"};
+  int maxConcurrency_{128};
+  int hostTimeoutMs_{0};
   std::vector<std::string> filters_{};
 };
 
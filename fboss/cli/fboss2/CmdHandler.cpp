@@ -37,25 +37,36 @@
 #include "fboss/cli/fboss2/commands/show/transceiver/CmdShowTransceiver.h"
 #include "fboss/cli/fboss2/utils/CmdClientUtils.h"
 #include "fboss/cli/fboss2/utils/CmdUtils.h"
+#include "fboss/cli/fboss2/utils/HostQuery.h"
 #include "folly/futures/Future.h"
 #include "thrift/lib/cpp2/protocol/Serializer.h"
 
 #include <folly/Singleton.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/logging/xlog.h>
-#include <future>
+#include <chrono>
 #include <iostream>
 
 template <typename CmdTypeT>
-void printTabular(
+using HostResultQueue =
+    facebook::fboss::utils::HostResultQueue<typename CmdTypeT::RetType>;
+
+/*
+ * Print results as they arrive, so that output for a large number of hosts
+ * is not held back by the slowest one. Returns false if any host failed.
+ */
+template <typename CmdTypeT>
+bool printTabular(
     CmdTypeT& cmd,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
+    size_t numHosts,
+    HostResultQueue<CmdTypeT>& results,
     std::ostream& out,
     std::ostream& err) {
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
+  bool success = true;
+  for (size_t i = 0; i < numHosts; ++i) {
+    auto [host, data, errStr] = results.dequeue();
+    if (numHosts != 1) {
       out << host << "::" << std::endl << std::string(80, '=') << std::endl;
     }
 
@@ -63,32 +74,37 @@ void printTabular(
       cmd.printOutput(data);
     } else {
       err << errStr << std::endl << std::endl;
+      success = false;
     }
+    out.flush();
   }
+  return success;
 }
 
 template <typename CmdTypeT>
-void printJson(
+bool printJson(
     const CmdTypeT& /* cmd */,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
+    size_t numHosts,
+    HostResultQueue<CmdTypeT>& results,
     std::ostream& out,
     std::ostream& err) {
+  bool success = true;
   std::map<std::string, typename CmdTypeT::RetType> hostResults;
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
+  for (size_t i = 0; i < numHosts; ++i) {
+    auto [host, data, errStr] = results.dequeue();
     if (errStr.empty()) {
-      hostResults[host] = data;
+      hostResults[host] = std::move(data);
     } else {
       err << host << "::" << std::endl << std::string(80, '=') << std::endl;
       err << errStr << std::endl << std::endl;
+      success = false;
     }
   }
 
   out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
              hostResults)
       << std::endl;
+  return success;
 }
 
 namespace facebook::fboss {
@@ -169,29 +185,36 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::run() {
     hosts = {"localhost"};
   }
 
-  std::vector<std::shared_future<std::tuple<std::string, RetType, std::string>>>
-      futureList;
-  for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-                             std::launch::async,
-                             &CmdHandler::asyncHandler,
-                             this,
-                             host /*, inArgs*/)
-                             .share());
-  }
-
+  // queryClient() blocks on its thrift client, so the number of threads is
+  // what bounds the number of hosts queried at once. Each thread reuses its
+  // EventBase across all the hosts it queries.
+  // The executor is leaked: destroying it would join the threads of queries
+  // that timed out, holding up the output until the slowest host answers.
+  auto numThreads = std::min<size_t>(
+      hosts.size(), CmdGlobalOptions::getInstance()->getMaxConcurrency());
+  auto* executor = new folly::CPUThreadPoolExecutor(
+      numThreads, std::make_shared<folly::NamedThreadFactory>("fboss2Query"));
+  auto hostTimeout = std::chrono::milliseconds(
+      CmdGlobalOptions::getInstance()->getHostTimeoutMs());
+
+  HostResultQueue<CmdTypeT> results;
+  auto queries = utils::queryHosts<RetType>(
+      hosts,
+      executor,
+      hostTimeout,
+      [this](const std::string& host) { return asyncHandler(host); },
+      results);
+
+  bool success;
   if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
-    printJson(impl(), futureList, std::cout, std::cerr);
+    success = printJson(impl(), hosts.size(), results, std::cout, std::cerr);
   } else {
-    printTabular(impl(), futureList, std::cout, std::cerr);
+    success = printTabular(impl(), hosts.size(), results, std::cout, std::cerr);
   }
 
-  for (auto& fut : futureList) {
-    auto [host, data, errStr] = fut.get();
-    // exit with failure if any of the calls failed
-    if (!errStr.empty()) {
-      exit(1);
-    }
+  // exit with failure if any of the calls failed
+  if (!success) {
+    exit(1);
   }
 }
 
@@ -112,12 +112,12 @@ class CmdHandler {
 
   std::tuple<std::string, RetType, std::string> asyncHandler(
       const std::string& host) {
-    auto hostInfo = HostInfo(host);
-    XLOG(DBG2) << "host: " << host << " ip: " << hostInfo.getIpStr();
-
     std::string errStr;
     RetType result;
     try {
+      // Resolving the host can throw too
+      auto hostInfo = HostInfo(host);
+      XLOG(DBG2) << "host: " << host << " ip: " << hostInfo.getIpStr();
       result = queryClientHelper(hostInfo);
     } catch (std::exception const& err) {
       errStr = folly::to<std::string>("Thrift call failed: '", err.what(), "'");
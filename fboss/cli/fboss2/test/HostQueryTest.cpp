@@ -0,0 +1,82 @@
+// (c) Facebook, Inc. and its affiliates. Confidential and proprietary.
+
+#include <gtest/gtest.h>
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/synchronization/Baton.h>
+#include <map>
+#include <stdexcept>
+
+#include "fboss/cli/fboss2/utils/HostQuery.h"
+
+using namespace ::testing;
+
+namespace facebook::fboss {
+
+class HostQueryTestFixture : public ::testing::Test {
+ public:
+  std::map<std::string, utils::HostResult<int>> dequeueAll(size_t numHosts) {
+    std::map<std::string, utils::HostResult<int>> hostResults;
+    for (size_t i = 0; i < numHosts; ++i) {
+      auto result = results_.dequeue();
+      hostResults[std::get<0>(result)] = std::move(result);
+    }
+    return hostResults;
+  }
+
+  folly::CPUThreadPoolExecutor executor_{2};
+  utils::HostResultQueue<int> results_;
+};
+
+TEST_F(HostQueryTestFixture, oneResultPerHostWhenQueryThrows) {
+  std::vector<std::string> hosts = {"host1", "bad.host", "host2"};
+  auto queries = utils::queryHosts<int>(
+      hosts,
+      &executor_,
+      std::chrono::milliseconds(0),
+      [](const std::string& host) -> utils::HostResult<int> {
+        if (host == "bad.host") {
+          // e.g. failing to resolve the host
+          throw std::runtime_error("no such host");
+        }
+        return std::make_tuple(host, 42, std::string());
+      },
+      results_);
+
+  auto hostResults = dequeueAll(hosts.size());
+  ASSERT_EQ(hostResults.size(), hosts.size());
+  EXPECT_EQ(std::get<1>(hostResults["host1"]), 42);
+  EXPECT_EQ(std::get<2>(hostResults["host1"]), "");
+  EXPECT_EQ(std::get<1>(hostResults["host2"]), 42);
+  EXPECT_EQ(std::get<2>(hostResults["host2"]), "");
+  EXPECT_EQ(std::get<1>(hostResults["bad.host"]), 0);
+  EXPECT_EQ(std::get<2>(hostResults["bad.host"]), "no such host");
+  EXPECT_TRUE(results_.empty());
+}
+
+TEST_F(HostQueryTestFixture, timedOutHostDoesNotHoldUpOthers) {
+  std::vector<std::string> hosts = {"slow.host", "host1"};
+  folly::Baton<> unblock;
+  auto queries = utils::queryHosts<int>(
+      hosts,
+      &executor_,
+      std::chrono::milliseconds(50),
+      [&unblock](const std::string& host) {
+        if (host == "slow.host") {
+          unblock.wait();
+        }
+        return std::make_tuple(host, 42, std::string());
+      },
+      results_);
+
+  auto hostResults = dequeueAll(hosts.size());
+  EXPECT_EQ(std::get<2>(hostResults["host1"]), "");
+  EXPECT_EQ(std::get<2>(hostResults["slow.host"]), "Timed out after 50ms");
+
+  // The late answer is not enqueued as a second result
+  unblock.post();
+  executor_.join();
+  EXPECT_TRUE(results_.empty());
+}
+
+} // namespace facebook::fboss
@@ -15,6 +15,7 @@
 #include "fboss/cli/fboss2/utils/HostInfo.h"
 #include "fboss/qsfp_service/if/gen-cpp2/QsfpService.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -35,13 +36,20 @@ template <typename Client>
 std::unique_ptr<Client> createPlaintextClient(
     const HostInfo& hostInfo,
     const int port) {
+  // Once the per host timeout reports the host as failed, the query
+  // should not keep running for long in the background
+  auto hostTimeoutMs = CmdGlobalOptions::getInstance()->getHostTimeoutMs();
+  auto capTimeout = [hostTimeoutMs](int timeoutMs) {
+    return hostTimeoutMs > 0 ? std::min(timeoutMs, hostTimeoutMs) : timeoutMs;
+  };
   auto eb = folly::EventBaseManager::get()->getEventBase();
   auto addr = folly::SocketAddress(hostInfo.getIp(), port);
-  auto sock = folly::AsyncSocket::newSocket(eb, addr, kConnTimeout);
-  sock->setSendTimeout(kSendTimeout);
+  auto sock =
+      folly::AsyncSocket::newSocket(eb, addr, capTimeout(kConnTimeout));
+  sock->setSendTimeout(capTimeout(kSendTimeout));
   auto channel =
       apache::thrift::HeaderClientChannel::newChannel(std::move(sock));
-  channel->setTimeout(kRecvTimeout);
+  channel->setTimeout(capTimeout(kRecvTimeout));
   return std::make_unique<Client>(std::move(channel));
 }
 
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/concurrency/UnboundedQueue.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
+#include <chrono>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace facebook::fboss::utils {
+
+// Host, result and error string, the error string is empty on success
+template <typename RetType>
+using HostResult = std::tuple<std::string, RetType, std::string>;
+
+// Results are enqueued by the query threads as hosts complete
+template <typename RetType>
+using HostResultQueue =
+    folly::UMPSCQueue<HostResult<RetType>, true /* MayBlock */>;
+
+/*
+ * Runs query(host) for every host on executor. Exactly one result is
+ * enqueued to results per host, whether the query returns, throws or does
+ * not complete within hostTimeout (if non zero). Once timed out, a query
+ * keeps running on its executor thread, its result is just not waited for.
+ */
+template <typename RetType, typename QueryFn>
+std::vector<folly::Future<folly::Unit>> queryHosts(
+    const std::vector<std::string>& hosts,
+    folly::Executor* executor,
+    std::chrono::milliseconds hostTimeout,
+    QueryFn query,
+    HostResultQueue<RetType>& results) {
+  std::vector<folly::Future<folly::Unit>> queries;
+  for (const auto& host : hosts) {
+    // Run continuations inline, so that timeouts are reported even while
+    // every executor thread is blocked on a query.
+    auto future = folly::via(executor, [query, host]() { return query(host); })
+                      .via(&folly::InlineExecutor::instance());
+    if (hostTimeout.count() > 0) {
+      future = std::move(future).within(hostTimeout);
+    }
+    queries.push_back(
+        std::move(future)
+            .thenTry([host, hostTimeout](
+                         folly::Try<HostResult<RetType>>&& result) {
+              if (result.hasValue()) {
+                return std::move(*result);
+              }
+              std::string errStr;
+              if (result.template hasException<folly::FutureTimeout>()) {
+                errStr = folly::to<std::string>(
+                    "Timed out after ", hostTimeout.count(), "ms");
+              } else {
+                errStr = result.exception().what().toStdString();
+              }
+              return std::make_tuple(host, RetType(), errStr);
+            })
+            .thenValue([&results](HostResult<RetType>&& result) {
+              results.enqueue(std::move(result));
+            }));
+  }
+  return queries;
+}
+
+} // namespace facebook::fboss::utils
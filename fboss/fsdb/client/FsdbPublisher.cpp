@@ -6,10 +6,98 @@
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
 #include <folly/logging/xlog.h>
+#include <glog/logging.h>
 #include <chrono>
+#include <map>
 
 namespace facebook::fboss::fsdb {
 
+template <>
+OperDelta FsdbPublisher<OperDelta>::coalesce(
+    std::vector<OperDelta>&& pubUnits) {
+  CHECK(!pubUnits.empty());
+  if (pubUnits.size() == 1) {
+    return std::move(pubUnits.front());
+  }
+  std::vector<std::optional<OperDeltaUnit>> changes;
+  // Path to the index of its latest change
+  std::map<std::vector<std::string>, size_t> pathToChange;
+  // Path to the index of the latest change to it or to a path below it
+  std::map<std::vector<std::string>, size_t> subtreeToChange;
+  // Changes to a path can only be folded together if no change to an
+  // overlapping path, i.e. an ancestor or a descendant, came in between,
+  // subscribers apply changes in order.
+  auto canFold = [&](size_t idx, const std::vector<std::string>& path) {
+    if (subtreeToChange.at(path) > idx) {
+      return false;
+    }
+    std::vector<std::string> ancestor;
+    for (const auto& elem : path) {
+      auto it = pathToChange.find(ancestor);
+      if (it != pathToChange.end() && it->second > idx) {
+        return false;
+      }
+      ancestor.push_back(elem);
+    }
+    return true;
+  };
+  auto addChange = [&](OperDeltaUnit&& unit) {
+    const auto& path = *unit.path()->raw();
+    auto idx = changes.size();
+    pathToChange[path] = idx;
+    std::vector<std::string> ancestor;
+    subtreeToChange[ancestor] = idx;
+    for (const auto& elem : path) {
+      ancestor.push_back(elem);
+      subtreeToChange[ancestor] = idx;
+    }
+    changes.emplace_back(std::move(unit));
+  };
+  for (auto& pubUnit : pubUnits) {
+    CHECK(*pubUnit.protocol() == *pubUnits.front().protocol());
+    for (auto& unit : *pubUnit.changes()) {
+      const auto& path = *unit.path()->raw();
+      auto it = pathToChange.find(path);
+      if (it == pathToChange.end() || !canFold(it->second, path)) {
+        addChange(std::move(unit));
+        continue;
+      }
+      auto& change = changes[it->second];
+      if (unit.newState()) {
+        change->newState() = std::move(*unit.newState());
+      } else {
+        change->newState().reset();
+      }
+      if (!change->oldState() && !change->newState()) {
+        // Added and then removed again
+        change.reset();
+        pathToChange.erase(it);
+      }
+    }
+  }
+
+  OperDelta coalesced;
+  coalesced.protocol() = *pubUnits.back().protocol();
+  if (pubUnits.back().metadata()) {
+    coalesced.metadata() = std::move(*pubUnits.back().metadata());
+  }
+  coalesced.changes()->reserve(changes.size());
+  for (auto& change : changes) {
+    if (change) {
+      coalesced.changes()->push_back(std::move(*change));
+    }
+  }
+  return coalesced;
+}
+
+template <>
+OperState FsdbPublisher<OperState>::coalesce(
+    std::vector<OperState>&& pubUnits) {
+  CHECK(!pubUnits.empty());
+  // Each state is a full snapshot of the publish path
+  return std::move(pubUnits.back());
+}
+
 template <typename PubUnit>
 OperPubRequest FsdbPublisher<PubUnit>::createRequest() const {
   OperPath operPath;
@@ -65,15 +153,37 @@ bool FsdbPublisher<PubUnit>::write(PubUnit pubUnit) {
 template <typename PubUnit>
 folly::coro::AsyncGenerator<std::optional<PubUnit>>
 FsdbPublisher<PubUnit>::createGenerator() {
+  // Pub unit dequeued for but not fitting in the previous batch
+  std::optional<PubUnit> nextPubUnit;
   while (true) {
     {
       auto toPublishQueueRPtr = toPublishQueue_.rlock();
       if (*toPublishQueueRPtr) {
         PubUnit pubUnit;
-        co_yield(*toPublishQueueRPtr)
-                ->try_dequeue_for(pubUnit, std::chrono::milliseconds(10))
-            ? std::optional<PubUnit>(pubUnit)
-            : std::nullopt;
+        if (nextPubUnit) {
+          pubUnit = std::move(*nextPubUnit);
+          nextPubUnit.reset();
+        } else if (!(*toPublishQueueRPtr)
+                        ->try_dequeue_for(
+                            pubUnit, std::chrono::milliseconds(10))) {
+          co_yield std::nullopt;
+          continue;
+        }
+        // Fold whatever else queued up meanwhile into the same pub unit
+        std::vector<PubUnit> pubUnits;
+        pubUnits.push_back(std::move(pubUnit));
+        while (pubUnits.size() < kMaxCoalescedPubUnits &&
+               (*toPublishQueueRPtr)->try_dequeue(pubUnit)) {
+          if (*pubUnit.protocol() != *pubUnits.front().protocol()) {
+            nextPubUnit = std::move(pubUnit);
+            break;
+          }
+          pubUnits.push_back(std::move(pubUnit));
+        }
+        if (pubUnits.size() > 1) {
+          XLOG(DBG5) << "Coalesced " << pubUnits.size() << " pub units";
+        }
+        co_yield std::optional<PubUnit>(coalesce(std::move(pubUnits)));
       } else {
         XLOG(ERR) << "Publish queue is null, unable to dequeue";
         FsdbException ex;
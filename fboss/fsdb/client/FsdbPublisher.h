@@ -11,12 +11,15 @@
 
 #include <atomic>
 #include <shared_mutex>
+#include <vector>
 
 namespace facebook::fboss::fsdb {
 template <typename PubUnit>
 class FsdbPublisher : public FsdbStreamClient {
   using QueueT = folly::DMPSCQueue<PubUnit, true /*may block*/>;
   static constexpr auto kPubQueueCapacity{2000};
+  // Max number of queued pub units merged into a single stream frame
+  static constexpr auto kMaxCoalescedPubUnits{256};
   static std::unique_ptr<QueueT> makeQueue() {
     return std::make_unique<QueueT>(kPubQueueCapacity);
   }
@@ -81,6 +84,13 @@ class FsdbPublisher : public FsdbStreamClient {
     return publishStats_;
   }
 
+  // Merge pub units that queued up while the stream was busy into a single
+  // one, so that bursts of updates go out as fewer, larger stream frames.
+  // For deltas, changes to the same path are folded into one and a path
+  // added then removed drops out. States are full snapshots, so the latest
+  // one wins. All pub units must have the same protocol.
+  static PubUnit coalesce(std::vector<PubUnit>&& pubUnits);
+
  protected:
 #if FOLLY_HAS_COROUTINES
   folly::coro::AsyncGenerator<std::optional<PubUnit>> createGenerator();
@@ -96,4 +106,11 @@ class FsdbPublisher : public FsdbStreamClient {
   const bool publishStats_;
   fb303::ThreadCachedServiceData::TLTimeseries writeErrors_;
 };
+
+template <>
+OperDelta FsdbPublisher<OperDelta>::coalesce(
+    std::vector<OperDelta>&& pubUnits);
+template <>
+OperState FsdbPublisher<OperState>::coalesce(
+    std::vector<OperState>&& pubUnits);
 } // namespace facebook::fboss::fsdb
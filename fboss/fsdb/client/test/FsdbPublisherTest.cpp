@@ -4,13 +4,17 @@
 #include "fboss/fsdb/client/FsdbDeltaPublisher.h"
 #include "fboss/lib/CommonUtils.h"
 
+#include <folly/Conv.h>
 #include <folly/experimental/coro/AsyncGenerator.h>
 #include <folly/experimental/coro/AsyncPipe.h>
+#include <folly/experimental/coro/Sleep.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
 #include <folly/logging/xlog.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <map>
 
 namespace facebook::fboss::fsdb::test {
 
@@ -43,6 +47,12 @@ class TestFsdbStreamPublisher : public FsdbPublisher<OperDelta> {
         XLOG(DBG2) << " Detected cancellation";
         break;
       }
+      if (*pubUnit) {
+        received_.wlock()->push_back(std::move(**pubUnit));
+        if (consumeDelay_.count()) {
+          co_await folly::coro::sleep(consumeDelay_);
+        }
+      }
     }
     co_return;
   }
@@ -53,11 +63,38 @@ class TestFsdbStreamPublisher : public FsdbPublisher<OperDelta> {
   void startGenerator() {
     generatorStart_.post();
   }
+  // Simulate a slow stream by sleeping after consuming each pub unit
+  void setConsumeDelay(std::chrono::milliseconds delay) {
+    consumeDelay_ = delay;
+  }
+  std::vector<OperDelta> received() const {
+    return *received_.rlock();
+  }
 
  private:
   folly::Baton<> generatorStart_;
+  std::chrono::milliseconds consumeDelay_{0};
+  folly::Synchronized<std::vector<OperDelta>> received_;
 };
 
+OperDelta makeDelta(
+    const std::vector<std::string>& path,
+    std::optional<std::string> oldState,
+    std::optional<std::string> newState) {
+  OperDeltaUnit unit;
+  unit.path()->raw() = path;
+  if (oldState) {
+    unit.oldState() = folly::fbstring(*oldState);
+  }
+  if (newState) {
+    unit.newState() = folly::fbstring(*newState);
+  }
+  OperDelta delta;
+  delta.changes() = {unit};
+  delta.protocol() = OperProtocol::BINARY;
+  return delta;
+}
+
 } // namespace
 class StreamPublisherTest : public ::testing::Test {
  public:
@@ -125,4 +162,112 @@ TEST_F(StreamPublisherTest, overflowQueue) {
 #endif
 }
 
+TEST(FsdbPublisherCoalesceTest, foldChangesToSamePath) {
+  std::vector<OperDelta> deltas;
+  deltas.push_back(makeDelta({"agent", "a"}, "a0", "a1"));
+  deltas.push_back(makeDelta({"agent", "b"}, std::nullopt, "b1"));
+  deltas.push_back(makeDelta({"agent", "a"}, "a1", "a2"));
+  deltas.push_back(makeDelta({"agent", "b"}, "b1", std::nullopt));
+  deltas.back().metadata() = OperMetadata{};
+  deltas.back().metadata()->lastConfirmedAt() = 10;
+
+  auto coalesced = FsdbPublisher<OperDelta>::coalesce(std::move(deltas));
+  // b was added and removed again, a went from a0 to a2
+  ASSERT_EQ(coalesced.changes()->size(), 1);
+  const auto& change = coalesced.changes()->front();
+  EXPECT_EQ(
+      *change.path()->raw(), std::vector<std::string>({"agent", "a"}));
+  EXPECT_EQ(*change.oldState(), "a0");
+  EXPECT_EQ(*change.newState(), "a2");
+  EXPECT_EQ(*coalesced.protocol(), OperProtocol::BINARY);
+  EXPECT_EQ(*coalesced.metadata()->lastConfirmedAt(), 10);
+}
+
+TEST(FsdbPublisherCoalesceTest, keepOrderOfOverlappingChanges) {
+  std::vector<OperDelta> deltas;
+  deltas.push_back(makeDelta({"agent", "a", "x"}, std::nullopt, "x1"));
+  deltas.push_back(makeDelta({"agent", "a"}, "a1", "a2"));
+  deltas.push_back(makeDelta({"agent", "a", "x"}, "x1", std::nullopt));
+
+  // The change to the parent path sits between the two changes to x, so
+  // they can't be folded (or cancelled)
+  auto coalesced = FsdbPublisher<OperDelta>::coalesce(std::move(deltas));
+  ASSERT_EQ(coalesced.changes()->size(), 3);
+  EXPECT_EQ(
+      *coalesced.changes()->at(1).path()->raw(),
+      std::vector<std::string>({"agent", "a"}));
+  EXPECT_FALSE(coalesced.changes()->at(2).newState().has_value());
+}
+
+TEST(FsdbPublisherCoalesceTest, foldAroundNonOverlappingChanges) {
+  std::vector<OperDelta> deltas;
+  deltas.push_back(makeDelta({"agent", "a"}, "a0", "a1"));
+  deltas.push_back(makeDelta({"agent", "b", "x"}, "x0", "x1"));
+  deltas.push_back(makeDelta({"agent", "ab"}, "ab0", "ab1"));
+  deltas.push_back(makeDelta({"agent", "a"}, "a1", "a2"));
+  deltas.push_back(makeDelta({"agent", "a", "y"}, "y0", "y1"));
+  deltas.push_back(makeDelta({"agent", "a"}, "a2", "a3"));
+
+  // Siblings don't prevent folding, a change to a child of a in between the
+  // last two changes of a does
+  auto coalesced = FsdbPublisher<OperDelta>::coalesce(std::move(deltas));
+  ASSERT_EQ(coalesced.changes()->size(), 5);
+  EXPECT_EQ(*coalesced.changes()->at(0).newState(), "a2");
+  EXPECT_EQ(
+      *coalesced.changes()->at(3).path()->raw(),
+      std::vector<std::string>({"agent", "a", "y"}));
+  EXPECT_EQ(*coalesced.changes()->at(4).oldState(), "a2");
+  EXPECT_EQ(*coalesced.changes()->at(4).newState(), "a3");
+}
+
+TEST_F(StreamPublisherTest, coalesceForSlowConsumer) {
+  streamPublisher_->markConnected();
+  streamPublisher_->setConsumeDelay(std::chrono::milliseconds(10));
+  streamPublisher_->startGenerator();
+
+  constexpr auto kNumPaths = 10;
+  constexpr auto kNumBursts = 5;
+  constexpr auto kBurstSize = 1000;
+  std::map<std::string, std::string> expected;
+  for (auto burst = 0; burst < kNumBursts; ++burst) {
+    for (auto i = 0; i < kBurstSize; ++i) {
+      auto key = folly::to<std::string>(i % kNumPaths);
+      auto value = folly::to<std::string>(burst * kBurstSize + i);
+      std::optional<std::string> oldState;
+      if (auto it = expected.find(key); it != expected.end()) {
+        oldState = it->second;
+      }
+      EXPECT_TRUE(
+          streamPublisher_->write(makeDelta({"agent", key}, oldState, value)));
+      expected[key] = value;
+    }
+    // Draining a burst one delta at a time would take 10s, coalesced it is
+    // a handful of stream frames
+    WITH_RETRIES_N_TIMED(
+        { EXPECT_EVENTUALLY_EQ(streamPublisher_->queueSize(), 0); },
+        50,
+        std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(streamPublisher_->isConnectedToServer());
+
+  std::map<std::string, std::string> published;
+  WITH_RETRIES_N_TIMED(
+      {
+        published.clear();
+        for (const auto& delta : streamPublisher_->received()) {
+          EXPECT_LE(delta.changes()->size(), kNumPaths);
+          for (const auto& change : *delta.changes()) {
+            published[change.path()->raw()->back()] =
+                change.newState()->toStdString();
+          }
+        }
+        EXPECT_EVENTUALLY_EQ(published, expected);
+      },
+      50,
+      std::chrono::milliseconds(10));
+  EXPECT_LT(
+      streamPublisher_->received().size(),
+      kNumBursts * kBurstSize / kNumPaths);
+}
+
 } // namespace facebook::fboss::fsdb::test
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Builds a boost::container::flat_map out of entries added in any order.
+ *
+ * Inserting n unsorted entries into a flat_map one at a time shifts the
+ * entries after each insertion point, i.e. O(n^2) moves overall. Entries are
+ * instead appended here, then sorted once and handed to the flat_map as an
+ * ordered range, which is O(n log n).
+ */
+template <typename FlatMapT>
+class FlatMapBuilder {
+ public:
+  using key_type = typename FlatMapT::key_type;
+  using mapped_type = typename FlatMapT::mapped_type;
+  using Entry = std::pair<key_type, mapped_type>;
+
+  void reserve(size_t size) {
+    entries_.reserve(size);
+  }
+  size_t size() const {
+    return entries_.size();
+  }
+  bool empty() const {
+    return entries_.empty();
+  }
+
+  void add(key_type key, mapped_type value) {
+    entries_.emplace_back(std::move(key), std::move(value));
+  }
+
+  /*
+   * Returns a map of the entries added so far and resets the builder. For a
+   * key added more than once the value added last wins, as with
+   * operator[]; onDuplicate is called with each entry that lost.
+   */
+  template <typename OnDuplicate>
+  FlatMapT build(OnDuplicate&& onDuplicate) {
+    auto compare = typename FlatMapT::key_compare();
+    std::stable_sort(
+        entries_.begin(),
+        entries_.end(),
+        [&compare](const Entry& lhs, const Entry& rhs) {
+          return compare(lhs.first, rhs.first);
+        });
+    auto last = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      auto next = std::next(it);
+      if (next != entries_.end() && !compare(it->first, next->first)) {
+        onDuplicate(std::as_const(*it));
+        continue;
+      }
+      if (last != it) {
+        *last = std::move(*it);
+      }
+      ++last;
+    }
+    entries_.erase(last, entries_.end());
+    FlatMapT map(
+        boost::container::ordered_unique_range,
+        std::make_move_iterator(entries_.begin()),
+        std::make_move_iterator(entries_.end()));
+    entries_.clear();
+    return map;
+  }
+  FlatMapT build() {
+    return build([](const Entry& /*duplicate*/) {});
+  }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+} // namespace facebook::fboss
@@ -37,6 +37,7 @@ FunctionCallTimeReporter::getInstance() {
 
 namespace facebook::fboss {
 
+std::atomic<bool> FunctionCallTimeReporter::isOn_{false};
 thread_local FunctionCallTimeReporter::CallTimeTracker
     FunctionCallTimeReporter::tracker_;
 
@@ -15,6 +15,7 @@
 #include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
+#include <atomic>
 #include <chrono>
 
 namespace facebook::fboss {
@@ -28,13 +29,14 @@ class FunctionCallTimeReporter {
   ~FunctionCallTimeReporter() = default;
   void start();
   void end();
-  void callStart() {
-    if (UNLIKELY(isOn_)) {
+  // Static, so that the (usual) off case does not need to fetch the singleton
+  static void callStart() {
+    if (UNLIKELY(isOn_.load(std::memory_order_relaxed))) {
       tracker_.callStart();
     }
   }
-  void callEnd() {
-    if (UNLIKELY(isOn_)) {
+  static void callEnd() {
+    if (UNLIKELY(isOn_.load(std::memory_order_relaxed))) {
       tracker_.callEnd();
     }
   }
@@ -62,14 +64,14 @@ class FunctionCallTimeReporter {
    * turned on or not. However that would preclude use of std::atomic
    * and would need heavier means of synchronization
    */
-  std::atomic<bool> isOn_{false};
+  static std::atomic<bool> isOn_;
   static thread_local CallTimeTracker tracker_;
 };
 
-#define TIME_CALL                                       \
-  FunctionCallTimeReporter::getInstance()->callStart(); \
-  SCOPE_EXIT {                                          \
-    FunctionCallTimeReporter::getInstance()->callEnd(); \
+#define TIME_CALL                        \
+  FunctionCallTimeReporter::callStart(); \
+  SCOPE_EXIT {                           \
+    FunctionCallTimeReporter::callEnd(); \
   };
 
 class ScopedCallTimer {
@@ -65,6 +65,10 @@ class RefMap {
     return map_.size();
   }
 
+  void reserve(std::size_t size) {
+    map_.reserve(size);
+  }
+
   std::shared_ptr<V> ref(const K& k) const {
     auto itr = map_.find(k);
     if (itr == map_.end()) {
@@ -17,6 +17,21 @@
 namespace {
 constexpr uint32_t kFacebookFpgaRTCWriteBlock = 0x2000;
 constexpr uint32_t kFacebookFpgaRTCReadBlock = 0x3000;
+
+// A transaction times out after kTimeoutPerByte * len + kTimeout.
+constexpr auto kTimeoutPerByte = std::chrono::microseconds(100);
+constexpr auto kTimeout = std::chrono::milliseconds(20);
+// Sleeps shorter than this mostly measure timer slack, spin instead.
+constexpr auto kMinSleep = std::chrono::microseconds(50);
+// Status polls made back to back before backing off.
+constexpr int kNumSpinPolls = 8;
+constexpr auto kMinBackoff = std::chrono::microseconds(10);
+constexpr auto kMaxBackoff = std::chrono::milliseconds(1);
+// Weight of each completed transaction in the expected time.
+constexpr double kTimeSampleWeight = 1.0 / 8;
+// Spread of the transaction lengths (variance, in bytes^2) below which the
+// overhead and the per byte cost can't be told apart.
+constexpr double kMinLenVariance = 1.0;
 } // unnamed namespace
 
 namespace facebook::fboss {
@@ -49,15 +64,33 @@ FbFpgaI2c::FbFpgaI2c(
 
 bool FbFpgaI2c::waitForResponse(size_t len) {
   I2cRtcStatus rtcStatus(version_);
-  uint32_t retries = 20;
-
-  // Make the initial wait according to the length of read/write.
-  usleep(100 * len);
+  int64_t numBytes = std::max<size_t>(len, 1);
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + kTimeoutPerByte * numBytes + kTimeout;
+
+  // Sleep through most of the expected bus time, then poll the status
+  // register back to back for a few times before backing off exponentially.
+  // This keeps the latency close to the actual transaction time without
+  // spinning for long on slow devices.
+  auto initialWait =
+      (expectedOverhead_ + expectedTimePerByte_ * numBytes) * 3 / 4;
+  if (initialWait >= kMinSleep) {
+    std::this_thread::sleep_for(initialWait);
+  }
 
   readReg(rtcStatus);
 
-  while (!rtcStatus.dataUnion.desc0done && --retries) {
-    usleep(1000);
+  std::chrono::nanoseconds backoff = kMinBackoff;
+  for (int polls = 0; !rtcStatus.dataUnion.desc0done; polls++) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      break;
+    }
+    if (polls >= kNumSpinPolls) {
+      std::this_thread::sleep_for(
+          std::min<std::chrono::nanoseconds>(backoff, deadline - now));
+      backoff = std::min<std::chrono::nanoseconds>(backoff * 2, kMaxBackoff);
+    }
     readReg(rtcStatus);
   }
 
@@ -67,9 +100,49 @@ bool FbFpgaI2c::waitForResponse(size_t len) {
     return false;
   }
 
+  if (rtcStatus.dataUnion.desc0done) {
+    updateExpectedTime(
+        numBytes,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start));
+  }
+
   return rtcStatus.dataUnion.desc0done;
 }
 
+void FbFpgaI2c::updateExpectedTime(
+    size_t len,
+    std::chrono::nanoseconds elapsed) {
+  double x = len;
+  double y = elapsed.count();
+  auto average = [this](double& mean, double sample) {
+    mean = hasTimedTransactions_
+        ? mean + (sample - mean) * kTimeSampleWeight
+        : sample;
+  };
+  average(meanLen_, x);
+  average(meanTime_, y);
+  average(meanLenSq_, x * x);
+  average(meanLenTime_, x * y);
+  hasTimedTransactions_ = true;
+
+  // Least squares fit of time = overhead + timePerByte * len over the moving
+  // averages. Until transactions of different lengths were seen, the cost
+  // per byte is only lowered as far as needed to match the observed time,
+  // the rest being the overhead.
+  double timePerByte = expectedTimePerByte_.count();
+  double lenVariance = meanLenSq_ - meanLen_ * meanLen_;
+  if (lenVariance >= kMinLenVariance) {
+    timePerByte = (meanLenTime_ - meanLen_ * meanTime_) / lenVariance;
+  } else if (meanLen_ > 0) {
+    timePerByte = std::min(timePerByte, meanTime_ / meanLen_);
+  }
+  timePerByte = std::max(timePerByte, 0.0);
+  double overhead = std::max(meanTime_ - timePerByte * meanLen_, 0.0);
+  expectedTimePerByte_ = std::chrono::nanoseconds(int64_t(timePerByte));
+  expectedOverhead_ = std::chrono::nanoseconds(int64_t(overhead));
+}
+
 uint8_t
 FbFpgaI2c::readByte(uint8_t channel, uint8_t offset, uint8_t i2cAddress) {
   uint8_t byte = 0;
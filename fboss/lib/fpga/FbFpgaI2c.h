@@ -11,6 +11,7 @@
 #include <folly/io/async/EventBase.h>
 
 #include <stdint.h>
+#include <chrono>
 #include <thread>
 
 namespace facebook::fboss {
@@ -57,8 +58,18 @@ class FbFpgaI2c : public I2cController {
       folly::ByteRange buf,
       uint8_t i2cAddress = 0x50);
 
+  // Expected bus time of a transaction, as a fixed overhead plus a cost per
+  // byte, learned from the transactions completed so far on this controller.
+  std::chrono::nanoseconds getExpectedOverhead() const {
+    return expectedOverhead_;
+  }
+  std::chrono::nanoseconds getExpectedTimePerByte() const {
+    return expectedTimePerByte_;
+  }
+
  private:
   bool waitForResponse(size_t len);
+  void updateExpectedTime(size_t len, std::chrono::nanoseconds elapsed);
   uint32_t getRegAddr(uint32_t regBase, uint32_t regIncr);
   uint32_t getRTCIOBlockSize();
 
@@ -74,6 +85,16 @@ class FbFpgaI2c : public I2cController {
 
   int rtcId_{-1};
   int version_{0};
+  // Moving averages of the length (bytes), time (ns) and their products over
+  // the completed transactions, which the expected time is fit to.
+  bool hasTimedTransactions_{false};
+  double meanLen_{0};
+  double meanTime_{0};
+  double meanLenSq_{0};
+  double meanLenTime_{0};
+  // The initial values match the fixed wait used before this was measured.
+  std::chrono::nanoseconds expectedOverhead_{0};
+  std::chrono::nanoseconds expectedTimePerByte_{std::chrono::microseconds(100)};
 };
 
 class FbFpgaI2cController {
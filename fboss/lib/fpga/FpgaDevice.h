@@ -81,6 +81,10 @@ class FpgaDevice {
     return phyMem_->getSize();
   }
 
+ protected:
+  // For fakes overriding read() and write(), without physical memory
+  FpgaDevice() {}
+
  private:
   std::unique_ptr<PhyMem> phyMem_;
 }; // namespace facebook::fboss
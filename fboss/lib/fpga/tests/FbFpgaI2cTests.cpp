@@ -0,0 +1,162 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+
+#include "fboss/lib/fpga/FbFpgaI2c.h"
+
+#include <array>
+#include <chrono>
+#include <unordered_map>
+
+namespace {
+// RTC 0 register layout of FPGA version 0
+constexpr uint32_t kDescLower = 0x500;
+constexpr uint32_t kDescUpper = 0x504;
+constexpr uint32_t kRtcStatus = 0x600;
+constexpr uint32_t kWriteBlock = 0x2000;
+constexpr uint32_t kReadBlock = 0x3000;
+constexpr uint32_t kRegionSize = 0x4000;
+
+constexpr uint32_t kDescValid = 1u << 31;
+constexpr uint32_t kStatusDone = 0x1;
+constexpr uint32_t kStatusError = 0x2;
+} // namespace
+
+namespace facebook::fboss {
+
+/*
+ * Register memory of an RTC, completing each transaction once the given
+ * fixed overhead plus bus time per byte has elapsed since it was issued.
+ */
+class SimulatedI2cFpga : public FpgaDevice {
+ public:
+  SimulatedI2cFpga(
+      std::chrono::microseconds timePerByte,
+      std::chrono::microseconds overhead)
+      : timePerByte_(timePerByte), overhead_(overhead) {}
+
+  uint32_t read(uint32_t offset) const override {
+    if (offset == kRtcStatus) {
+      if (!pending_ || neverComplete_) {
+        return 0;
+      }
+      if (std::chrono::steady_clock::now() < completionTime_) {
+        return 0;
+      }
+      return failTransactions_ ? kStatusDone | kStatusError : kStatusDone;
+    }
+    auto it = memory_.find(offset);
+    return it == memory_.end() ? 0 : it->second;
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    memory_[offset] = value;
+    if (offset == kDescUpper && (value & kDescValid)) {
+      auto len = memory_[kDescLower] & 0xff;
+      pending_ = true;
+      completionTime_ =
+          std::chrono::steady_clock::now() + overhead_ + timePerByte_ * len;
+      // Reads return the byte offsets as data
+      for (uint32_t i = 0; i < len; i += 4) {
+        memory_[kReadBlock + i] =
+            i | (i + 1) << 8 | (i + 2) << 16 | (i + 3) << 24;
+      }
+    }
+  }
+
+  void setFailTransactions(bool fail) {
+    failTransactions_ = fail;
+  }
+  void setNeverComplete(bool neverComplete) {
+    neverComplete_ = neverComplete;
+  }
+
+ private:
+  std::chrono::microseconds timePerByte_;
+  std::chrono::microseconds overhead_;
+  std::unordered_map<uint32_t, uint32_t> memory_;
+  bool pending_{false};
+  bool failTransactions_{false};
+  bool neverComplete_{false};
+  std::chrono::steady_clock::time_point completionTime_;
+};
+
+class FbFpgaI2cTests : public ::testing::Test {
+ protected:
+  void makeI2c(
+      std::chrono::microseconds timePerByte,
+      std::chrono::microseconds overhead = std::chrono::microseconds(0)) {
+    fpga_ = std::make_unique<SimulatedI2cFpga>(timePerByte, overhead);
+    i2c_ = std::make_unique<FbFpgaI2c>(
+        std::make_unique<FpgaMemoryRegion>("pim", fpga_.get(), 0, kRegionSize),
+        0 /* rtcId */,
+        2 /* pim */,
+        0 /* version */);
+  }
+
+  std::unique_ptr<SimulatedI2cFpga> fpga_;
+  std::unique_ptr<FbFpgaI2c> i2c_;
+};
+
+TEST_F(FbFpgaI2cTests, read) {
+  makeI2c(std::chrono::microseconds(20));
+  std::array<uint8_t, 10> buf;
+  i2c_->read(1, 0, folly::MutableByteRange(buf.data(), buf.size()));
+  for (uint8_t i = 0; i < buf.size(); i++) {
+    EXPECT_EQ(buf[i], i);
+  }
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readBytes_(), buf.size());
+}
+
+TEST_F(FbFpgaI2cTests, write) {
+  makeI2c(std::chrono::microseconds(20));
+  std::array<uint8_t, 5> buf{1, 2, 3, 4, 5};
+  i2c_->write(1, 0x80, folly::ByteRange(buf.data(), buf.size()));
+  EXPECT_EQ(fpga_->read(kWriteBlock), 0x04030201);
+  EXPECT_EQ(fpga_->read(kWriteBlock + 4) & 0xff, 0x05);
+}
+
+TEST_F(FbFpgaI2cTests, expectedTimeTracksBusTime) {
+  makeI2c(std::chrono::microseconds(5));
+  EXPECT_EQ(i2c_->getExpectedTimePerByte(), std::chrono::microseconds(100));
+  std::array<uint8_t, 128> buf;
+  for (int i = 0; i < 50; i++) {
+    i2c_->read(1, 0, folly::MutableByteRange(buf.data(), buf.size()));
+  }
+  EXPECT_GE(i2c_->getExpectedTimePerByte(), std::chrono::microseconds(5));
+  EXPECT_LT(i2c_->getExpectedTimePerByte(), std::chrono::microseconds(50));
+}
+
+TEST_F(FbFpgaI2cTests, expectedTimeSeparatesOverhead) {
+  makeI2c(std::chrono::microseconds(5), std::chrono::microseconds(400));
+  EXPECT_EQ(i2c_->getExpectedOverhead(), std::chrono::microseconds(0));
+  // Mix short and long transactions, as done when reading a transceiver
+  std::array<uint8_t, 128> buf;
+  for (int i = 0; i < 50; i++) {
+    i2c_->read(1, 0, folly::MutableByteRange(buf.data(), 1));
+    i2c_->read(1, 0, folly::MutableByteRange(buf.data(), buf.size()));
+  }
+  // The overhead dominates single byte transactions, so it can't be folded
+  // into the cost per byte
+  EXPECT_GE(i2c_->getExpectedOverhead(), std::chrono::microseconds(200));
+  EXPECT_LT(i2c_->getExpectedOverhead(), std::chrono::milliseconds(2));
+  EXPECT_LT(i2c_->getExpectedTimePerByte(), std::chrono::microseconds(20));
+}
+
+TEST_F(FbFpgaI2cTests, transactionError) {
+  makeI2c(std::chrono::microseconds(20));
+  fpga_->setFailTransactions(true);
+  EXPECT_THROW(i2c_->readByte(1, 0), FbFpgaI2cError);
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().readFailed_(), 1);
+}
+
+TEST_F(FbFpgaI2cTests, transactionTimeout) {
+  makeI2c(std::chrono::microseconds(20));
+  fpga_->setNeverComplete(true);
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_THROW(i2c_->writeByte(1, 0, 0xff), FbFpgaI2cError);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  EXPECT_EQ(*i2c_->getI2cControllerPlatformStats().writeFailed_(), 1);
+}
+
+} // namespace facebook::fboss
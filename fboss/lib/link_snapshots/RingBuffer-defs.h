@@ -16,10 +16,15 @@ namespace facebook::fboss {
 
 template <typename T, size_t length>
 void RingBuffer<T, length>::write(T val) {
-  if (buf.size() == length) {
-    buf.pop_front();
+  if (buf.size() < length) {
+    if (buf.empty()) {
+      buf.reserve(length);
+    }
+    buf.push_back(std::move(val));
+    return;
   }
-  buf.push_back(val);
+  buf[head] = std::move(val);
+  head = (head + 1) % length;
 }
 
 template <typename T, size_t length>
@@ -27,7 +32,7 @@ const T RingBuffer<T, length>::last() const {
   if (buf.empty()) {
     throw FbossError("Attempted to read from empty RingBuffer");
   }
-  return buf.back();
+  return at(buf.size() - 1);
 }
 
 template <typename T, size_t length>
@@ -37,24 +42,24 @@ bool RingBuffer<T, length>::empty() const {
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::begin() {
-  return buf.begin();
+  return iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::iterator RingBuffer<T, length>::end() {
-  return buf.end();
+  return iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::begin()
     const {
-  return buf.begin();
+  return const_iterator(this, 0);
 }
 
 template <typename T, size_t length>
 typename RingBuffer<T, length>::const_iterator RingBuffer<T, length>::end()
     const {
-  return buf.end();
+  return const_iterator(this, buf.size());
 }
 
 template <typename T, size_t length>
@@ -67,4 +72,14 @@ size_t RingBuffer<T, length>::maxSize() const {
   return length;
 }
 
+template <typename T, size_t length>
+T& RingBuffer<T, length>::at(size_t pos) {
+  return buf[(head + pos) % length];
+}
+
+template <typename T, size_t length>
+const T& RingBuffer<T, length>::at(size_t pos) const {
+  return buf[(head + pos) % length];
+}
+
 } // namespace facebook::fboss
@@ -10,14 +10,63 @@
 #pragma once
 
 #include <stddef.h>
-#include <list>
+#include <iterator>
+#include <vector>
 
 namespace facebook::fboss {
+
+/*
+ * Fixed capacity ring of the last `length` values written.
+ *
+ * Values live in a single contiguous buffer allocated on the first write;
+ * once the ring is full every write overwrites the oldest value in place,
+ * so steady state writes do not allocate. Iteration goes from the oldest to
+ * the newest value.
+ */
 template <typename T, size_t length>
 class RingBuffer {
  public:
-  using iterator = typename std::list<T>::iterator;
-  using const_iterator = typename std::list<T>::const_iterator;
+  template <typename Ring, typename Value>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    Iterator(Ring* ring, size_t pos) : ring_(ring), pos_(pos) {}
+
+    reference operator*() const {
+      return ring_->at(pos_);
+    }
+    pointer operator->() const {
+      return &ring_->at(pos_);
+    }
+    Iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      auto it = *this;
+      ++pos_;
+      return it;
+    }
+    bool operator==(const Iterator& other) const {
+      return ring_ == other.ring_ && pos_ == other.pos_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    Ring* ring_;
+    // Position relative to the oldest value
+    size_t pos_;
+  };
+
+  using iterator = Iterator<RingBuffer, T>;
+  using const_iterator = Iterator<const RingBuffer, const T>;
 
   void write(T val);
   const T last() const;
@@ -30,7 +79,12 @@ class RingBuffer {
   size_t maxSize() const;
 
  private:
-  std::list<T> buf;
+  T& at(size_t pos);
+  const T& at(size_t pos) const;
+
+  std::vector<T> buf;
+  // Index of the oldest value, only moves once the ring is full
+  size_t head{0};
 };
 
 } // namespace facebook::fboss
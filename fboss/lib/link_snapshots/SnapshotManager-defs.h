@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/lib/link_snapshots/SnapshotManager.h"
+#include "fboss/lib/link_snapshots/SnapshotRecorder.h"
 
 namespace facebook::fboss {
 
@@ -23,15 +24,16 @@ SnapshotManager<intervalSeconds, timespanSeconds>::SnapshotManager(
 template <size_t intervalSeconds, size_t timespanSeconds>
 void SnapshotManager<intervalSeconds, timespanSeconds>::addSnapshot(
     LinkSnapshot val) {
-  auto snapshot = SnapshotWrapper(val);
-  buf_.write(snapshot);
+  if (auto* recorder = SnapshotRecorder::get()) {
+    recorder->record(SnapshotRecorder::snapshotKey(portNames_, val), val);
+  }
 
+  auto snapshot = SnapshotWrapper(std::move(val));
   if (numSnapshotsToPublish_ > 0) {
     snapshot.publish(portNames_);
-  }
-  if (numSnapshotsToPublish_ > 0) {
     numSnapshotsToPublish_--;
   }
+  buf_.write(std::move(snapshot));
 }
 
 template <size_t intervalSeconds, size_t timespanSeconds>
@@ -0,0 +1,388 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/SnapshotRecorder.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+#include "fboss/agent/FbossError.h"
+
+DEFINE_string(
+    link_snapshot_recorder_file,
+    "",
+    "File to keep the most recent link snapshots in, survives crashes and "
+    "can be dumped with link_snapshot_recorder_dump. Disabled if empty");
+DEFINE_int32(
+    link_snapshot_recorder_size_mb,
+    16,
+    "Size of the link snapshot recorder file in MB");
+
+namespace {
+constexpr uint32_t kFileMagic = 0x4c4e4b52; // "LNKR"
+constexpr uint32_t kFileVersion = 1;
+constexpr uint32_t kRecordMagic = 0x534e4150; // "SNAP"
+constexpr uint32_t kWrapMagic = 0x57524150; // "WRAP"
+
+/*
+ * Header of a record in the ring, followed by the key and the snapshot
+ * bytes. For a delta (baseSeq != 0) the bytes replace everything but the
+ * first prefixLen and last suffixLen bytes of the base snapshot.
+ */
+struct RecordHeader {
+  uint32_t magic;
+  uint32_t keyLen;
+  uint64_t dataLen;
+  uint64_t seq;
+  int64_t timestamp;
+  uint64_t baseSeq;
+  uint32_t prefixLen;
+  uint32_t suffixLen;
+};
+
+uint64_t recordSize(uint64_t keyLen, uint64_t dataLen) {
+  // Keep records 8 byte aligned
+  return (sizeof(RecordHeader) + keyLen + dataLen + 7) & ~uint64_t(7);
+}
+
+RecordHeader readRecordHeader(const uint8_t* ring, uint64_t offset) {
+  RecordHeader rec;
+  std::memcpy(&rec, ring + offset, sizeof(rec));
+  return rec;
+}
+} // namespace
+
+namespace facebook::fboss {
+
+/*
+ * Header at the start of the recorder file. The ring holds numRecords
+ * records starting at offset head, a record that would not fit before the
+ * end of the ring is written at offset 0 after a wrap marker.
+ */
+struct SnapshotRecorder::FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t ringSize;
+  uint64_t head;
+  uint64_t tail;
+  uint64_t numRecords;
+  uint64_t nextSeq;
+
+  bool valid(uint64_t expectedRingSize) const {
+    return magic == kFileMagic && version == kFileVersion &&
+        ringSize == expectedRingSize && head < ringSize && tail <= ringSize &&
+        nextSeq > 0;
+  }
+};
+
+SnapshotRecorder::SnapshotRecorder(const std::string& path, size_t size)
+    : file_(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644),
+      mappedSize_(sizeof(FileHeader) + size) {
+  if (size < 2 * recordSize(0, 0)) {
+    throw FbossError("Snapshot recorder size ", size, " is too small");
+  }
+  struct stat st;
+  folly::checkUnixError(fstat(file_.fd(), &st), "Unable to stat ", path);
+  if (static_cast<size_t>(st.st_size) != mappedSize_) {
+    folly::checkUnixError(
+        ftruncate(file_.fd(), mappedSize_), "Unable to resize ", path);
+  }
+  auto addr = ::mmap(
+      nullptr,
+      mappedSize_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED,
+      file_.fd(),
+      0);
+  if (addr == MAP_FAILED) {
+    folly::throwSystemError("Unable to mmap ", path);
+  }
+  mapped_ = static_cast<uint8_t*>(addr);
+
+  auto* hdr = header();
+  if (hdr->valid(size)) {
+    XLOG(INFO) << "Appending to snapshot recorder " << path << " with "
+               << hdr->numRecords << " records";
+  } else {
+    XLOG(INFO) << "Initializing snapshot recorder " << path;
+    *hdr = FileHeader{kFileMagic, kFileVersion, size, 0, 0, 0, 1};
+  }
+}
+
+SnapshotRecorder::~SnapshotRecorder() {
+  ::munmap(mapped_, mappedSize_);
+}
+
+SnapshotRecorder* SnapshotRecorder::get() {
+  // Leaked so snapshots can still be recorded during shutdown
+  static SnapshotRecorder* recorder = []() -> SnapshotRecorder* {
+    if (FLAGS_link_snapshot_recorder_file.empty()) {
+      return nullptr;
+    }
+    try {
+      return new SnapshotRecorder(
+          FLAGS_link_snapshot_recorder_file,
+          static_cast<size_t>(FLAGS_link_snapshot_recorder_size_mb) << 20);
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Not recording link snapshots: " << ex.what();
+      return nullptr;
+    }
+  }();
+  return recorder;
+}
+
+std::string SnapshotRecorder::snapshotKey(
+    const std::set<std::string>& portNames,
+    const phy::LinkSnapshot& snapshot) {
+  auto key = folly::join(",", portNames);
+  if (snapshot.getType() == phy::LinkSnapshot::Type::phyInfo) {
+    key += ":";
+    key += apache::thrift::util::enumNameSafe(
+        *snapshot.get_phyInfo().phyChip()->type());
+  } else {
+    key += ":TRANSCEIVER";
+  }
+  return key;
+}
+
+SnapshotRecorder::FileHeader* SnapshotRecorder::header() const {
+  return reinterpret_cast<FileHeader*>(mapped_);
+}
+
+uint8_t* SnapshotRecorder::ring() const {
+  return mapped_ + sizeof(FileHeader);
+}
+
+void SnapshotRecorder::record(
+    const std::string& key,
+    const phy::LinkSnapshot& snapshot) {
+  auto data = apache::thrift::CompactSerializer::serialize<std::string>(
+      snapshot);
+  auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+
+  std::lock_guard<std::mutex> guard(lock_);
+  auto* hdr = header();
+  if (recordSize(key.size(), data.size()) > hdr->ringSize / 2) {
+    XLOG_EVERY_MS(WARN, 60000)
+        << "Link snapshot for " << key << " too large to record";
+    return;
+  }
+  auto& state = keys_[key];
+
+  // Bytes of data that differ from the previous snapshot of the key
+  uint64_t prefixLen = 0;
+  uint64_t suffixLen = 0;
+  const auto& prev = state.lastSnapshot;
+  if (!prev.empty()) {
+    auto maxLen = std::min(prev.size(), data.size());
+    prefixLen = std::mismatch(data.begin(), data.begin() + maxLen, prev.begin())
+                    .first -
+        data.begin();
+    suffixLen = std::mismatch(
+                    data.rbegin(),
+                    data.rbegin() + (maxLen - prefixLen),
+                    prev.rbegin())
+                    .first -
+        data.rbegin();
+  }
+
+  auto seq = hdr->nextSeq;
+  bool keyframe = prev.empty() || state.sinceKeyframe >= kKeyframeInterval;
+  uint64_t offset = 0;
+  if (!keyframe) {
+    offset = reserve(
+        recordSize(key.size(), data.size() - prefixLen - suffixLen));
+    // Making room may have overwritten the snapshot the delta builds on
+    keyframe = state.keyframeSeq < oldestSeq();
+  }
+  if (keyframe) {
+    prefixLen = suffixLen = 0;
+    offset = reserve(recordSize(key.size(), data.size()));
+  }
+
+  auto dataLen = data.size() - prefixLen - suffixLen;
+  RecordHeader rec{
+      kRecordMagic,
+      static_cast<uint32_t>(key.size()),
+      dataLen,
+      seq,
+      timestamp,
+      keyframe ? 0 : state.lastSeq,
+      static_cast<uint32_t>(prefixLen),
+      static_cast<uint32_t>(suffixLen)};
+  auto* dst = ring() + offset;
+  std::memcpy(dst, &rec, sizeof(rec));
+  std::memcpy(dst + sizeof(rec), key.data(), key.size());
+  std::memcpy(
+      dst + sizeof(rec) + key.size(), data.data() + prefixLen, dataLen);
+  // Publish the record only once its bytes are in place
+  std::atomic_thread_fence(std::memory_order_release);
+  hdr->tail = offset + recordSize(key.size(), dataLen);
+  hdr->numRecords++;
+  hdr->nextSeq++;
+
+  state.lastSeq = seq;
+  if (keyframe) {
+    state.keyframeSeq = seq;
+    state.sinceKeyframe = 0;
+  } else {
+    state.sinceKeyframe++;
+  }
+  state.lastSnapshot = std::move(data);
+}
+
+uint64_t SnapshotRecorder::reserve(uint64_t size) {
+  auto* hdr = header();
+  if (hdr->tail + size > hdr->ringSize) {
+    // Records past the tail are the oldest ones, drop them and wrap around
+    while (hdr->numRecords > 0 && hdr->head >= hdr->tail) {
+      evictOldest();
+    }
+    if (hdr->tail + sizeof(RecordHeader) <= hdr->ringSize) {
+      RecordHeader wrap{};
+      wrap.magic = kWrapMagic;
+      std::memcpy(ring() + hdr->tail, &wrap, sizeof(wrap));
+    }
+    hdr->tail = 0;
+    if (hdr->numRecords == 0) {
+      hdr->head = 0;
+    }
+  }
+  while (hdr->numRecords > 0 && hdr->head >= hdr->tail &&
+         hdr->head < hdr->tail + size) {
+    evictOldest();
+  }
+  return hdr->tail;
+}
+
+void SnapshotRecorder::evictOldest() {
+  auto* hdr = header();
+  if (hdr->head + sizeof(RecordHeader) > hdr->ringSize) {
+    hdr->head = 0;
+    return;
+  }
+  auto rec = readRecordHeader(ring(), hdr->head);
+  if (rec.magic == kWrapMagic) {
+    hdr->head = 0;
+    return;
+  }
+  hdr->head += recordSize(rec.keyLen, rec.dataLen);
+  if (--hdr->numRecords == 0) {
+    hdr->head = hdr->tail;
+  }
+}
+
+uint64_t SnapshotRecorder::oldestSeq() const {
+  auto* hdr = header();
+  if (hdr->numRecords == 0) {
+    return hdr->nextSeq;
+  }
+  auto head = hdr->head;
+  if (head + sizeof(RecordHeader) > hdr->ringSize ||
+      readRecordHeader(ring(), head).magic == kWrapMagic) {
+    head = 0;
+  }
+  return readRecordHeader(ring(), head).seq;
+}
+
+std::vector<SnapshotRecorder::Record> SnapshotRecorder::read(
+    const std::string& path) {
+  std::string contents;
+  if (!folly::readFile(path.c_str(), contents)) {
+    throw FbossError("Unable to read ", path);
+  }
+  FileHeader hdr;
+  if (contents.size() < sizeof(hdr)) {
+    throw FbossError(path, " is not a snapshot recorder file");
+  }
+  std::memcpy(&hdr, contents.data(), sizeof(hdr));
+  if (!hdr.valid(contents.size() - sizeof(hdr))) {
+    throw FbossError(path, " is not a snapshot recorder file");
+  }
+  auto* ring = reinterpret_cast<const uint8_t*>(contents.data()) + sizeof(hdr);
+
+  // Last snapshot of every key, to apply deltas to
+  std::unordered_map<std::string, std::pair<uint64_t, std::string>> last;
+  std::vector<Record> records;
+  auto offset = hdr.head;
+  bool wrapped = false;
+  int numUnresolved = 0;
+  for (uint64_t i = 0; i < hdr.numRecords; ++i) {
+    if (offset + sizeof(RecordHeader) > hdr.ringSize ||
+        readRecordHeader(ring, offset).magic == kWrapMagic) {
+      if (wrapped) {
+        XLOG(ERR) << "Snapshot recorder wrapped twice, stopping";
+        break;
+      }
+      wrapped = true;
+      offset = 0;
+    }
+    auto rec = readRecordHeader(ring, offset);
+    auto size = recordSize(rec.keyLen, rec.dataLen);
+    if (rec.magic != kRecordMagic || offset + size > hdr.ringSize) {
+      XLOG(ERR) << "Corrupt snapshot record at offset " << offset
+                << ", stopping";
+      break;
+    }
+    auto* payload = reinterpret_cast<const char*>(ring + offset) + sizeof(rec);
+    offset += size;
+
+    std::string key(payload, rec.keyLen);
+    folly::StringPiece data(payload + rec.keyLen, rec.dataLen);
+    std::string snapshotBytes;
+    if (rec.baseSeq == 0) {
+      snapshotBytes = data.str();
+    } else {
+      auto it = last.find(key);
+      if (it == last.end() || it->second.first != rec.baseSeq ||
+          rec.prefixLen + rec.suffixLen > it->second.second.size()) {
+        // Full snapshot of the key was overwritten
+        numUnresolved++;
+        continue;
+      }
+      const auto& base = it->second.second;
+      snapshotBytes = base.substr(0, rec.prefixLen);
+      snapshotBytes.append(data.data(), data.size());
+      snapshotBytes.append(base, base.size() - rec.suffixLen, rec.suffixLen);
+    }
+
+    Record record{rec.seq, rec.timestamp, key, {}};
+    try {
+      apache::thrift::CompactSerializer::deserialize(
+          snapshotBytes, record.snapshot);
+    } catch (const std::exception& ex) {
+      XLOG(WARN) << "Unable to deserialize snapshot " << rec.seq << " for "
+                 << key << ": " << ex.what();
+      continue;
+    }
+    last[key] = std::make_pair(rec.seq, std::move(snapshotBytes));
+    records.push_back(std::move(record));
+  }
+  if (numUnresolved) {
+    XLOG(INFO) << "Skipped " << numUnresolved
+               << " snapshots whose full snapshot was overwritten";
+  }
+  return records;
+}
+
+} // namespace facebook::fboss
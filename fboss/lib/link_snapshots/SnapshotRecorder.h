@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/File.h>
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fboss/lib/phy/gen-cpp2/phy_types.h"
+
+namespace facebook::fboss {
+
+/*
+ * Flight recorder for link snapshots.
+ *
+ * Snapshots are compact serialized into a fixed size ring kept in a memory
+ * mapped file, so the most recent ones survive a crash of the process that
+ * collected them and can be dumped offline with link_snapshot_recorder_dump.
+ * When the ring is full the oldest records are overwritten.
+ *
+ * A snapshot is stored as a delta against the previous snapshot with the same
+ * key (ports and source of the snapshot): only the bytes between the common
+ * prefix and the common suffix of the two serialized snapshots are written.
+ * The full snapshot is written every kKeyframeInterval snapshots of a key,
+ * and whenever the last full snapshot of the key was overwritten. Deltas at
+ * the start of the ring whose full snapshot got overwritten are skipped when
+ * reading, so up to kKeyframeInterval snapshots of a key may be lost on top
+ * of the ones overwritten.
+ */
+class SnapshotRecorder {
+ public:
+  struct Record {
+    uint64_t seq;
+    int64_t timestamp;
+    std::string key;
+    phy::LinkSnapshot snapshot;
+  };
+
+  static constexpr int kKeyframeInterval = 16;
+
+  SnapshotRecorder(const std::string& path, size_t size);
+  ~SnapshotRecorder();
+
+  // Recorder set up from --link_snapshot_recorder_file, null if not enabled
+  static SnapshotRecorder* get();
+
+  // Key identifying the stream of snapshots of the given ports
+  static std::string snapshotKey(
+      const std::set<std::string>& portNames,
+      const phy::LinkSnapshot& snapshot);
+
+  void record(const std::string& key, const phy::LinkSnapshot& snapshot);
+
+  // Returns the snapshots in a recorder file, oldest first
+  static std::vector<Record> read(const std::string& path);
+
+ private:
+  struct KeyState {
+    std::string lastSnapshot;
+    uint64_t lastSeq{0};
+    uint64_t keyframeSeq{0};
+    int sinceKeyframe{0};
+  };
+
+  struct FileHeader;
+
+  FileHeader* header() const;
+  uint8_t* ring() const;
+  // Makes room for a record of the given size, returns its offset in the ring
+  uint64_t reserve(uint64_t size);
+  void evictOldest();
+  uint64_t oldestSeq() const;
+
+  std::mutex lock_;
+  folly::File file_;
+  size_t mappedSize_{0};
+  uint8_t* mapped_{nullptr};
+  std::unordered_map<std::string, KeyState> keys_;
+};
+
+} // namespace facebook::fboss
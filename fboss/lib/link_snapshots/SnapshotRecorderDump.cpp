@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <iostream>
+
+#include "fboss/lib/link_snapshots/SnapshotRecorder.h"
+
+DEFINE_string(key, "", "Only dump the snapshots of this key");
+
+using namespace facebook::fboss;
+
+/*
+ * Dumps the snapshots kept by a link snapshot recorder, oldest first, as one
+ * JSON object per line:
+ *
+ *   link_snapshot_recorder_dump /var/facebook/fboss/link_snapshots.bin
+ */
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " [--key <key>] <recorder file>"
+              << std::endl;
+    return 1;
+  }
+
+  for (const auto& record : SnapshotRecorder::read(argv[1])) {
+    if (!FLAGS_key.empty() && record.key != FLAGS_key) {
+      continue;
+    }
+    folly::dynamic entry = folly::dynamic::object("seq", record.seq)(
+        "timestamp", record.timestamp)("key", record.key)(
+        "snapshot",
+        folly::parseJson(
+            apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+                record.snapshot)));
+    std::cout << folly::toJson(entry) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/link_snapshots/SnapshotRecorder.h"
+#include "fboss/lib/link_snapshots/RingBuffer-defs.h"
+
+#include <folly/experimental/TestUtil.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+phy::LinkSnapshot makeSnapshot(const std::string& port, int timeCollected) {
+  phy::PhyInfo info;
+  *info.name() = port;
+  *info.phyChip()->type() = phy::DataPlanePhyChipType::IPHY;
+  *info.timeCollected() = timeCollected;
+  info.linkState() = timeCollected % 2;
+  phy::LinkSnapshot snapshot;
+  snapshot.set_phyInfo(info);
+  return snapshot;
+}
+
+} // namespace
+
+TEST(RingBufferTest, overwritesOldest) {
+  RingBuffer<int, 3> buf;
+  EXPECT_THROW(buf.last(), FbossError);
+  for (int i = 0; i < 5; i++) {
+    buf.write(i);
+  }
+  EXPECT_EQ(buf.size(), 3u);
+  EXPECT_EQ(buf.last(), 4);
+  std::vector<int> values(buf.begin(), buf.end());
+  EXPECT_EQ(values, std::vector<int>({2, 3, 4}));
+}
+
+TEST(SnapshotRecorderTest, roundTrip) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "recorder").string();
+  SnapshotRecorder recorder(path, 1 << 20);
+  for (int i = 0; i < 3 * SnapshotRecorder::kKeyframeInterval; i++) {
+    recorder.record("eth1/1/1:IPHY", makeSnapshot("eth1/1/1", i));
+    recorder.record("eth1/2/1:IPHY", makeSnapshot("eth1/2/1", i));
+  }
+
+  auto records = SnapshotRecorder::read(path);
+  ASSERT_EQ(records.size(), 6u * SnapshotRecorder::kKeyframeInterval);
+  for (size_t i = 0; i < records.size(); i++) {
+    const auto& record = records[i];
+    EXPECT_EQ(record.seq, i + 1);
+    EXPECT_EQ(
+        record.snapshot,
+        makeSnapshot(i % 2 ? "eth1/2/1" : "eth1/1/1", i / 2));
+  }
+}
+
+TEST(SnapshotRecorderTest, overwritesOldest) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "recorder").string();
+  constexpr uint64_t kNumSnapshots = 10000;
+  {
+    SnapshotRecorder recorder(path, 16 << 10);
+    for (uint64_t i = 0; i < kNumSnapshots; i++) {
+      recorder.record("eth1/1/1:IPHY", makeSnapshot("eth1/1/1", i));
+    }
+  }
+
+  // Records left are the most recent ones, in order
+  auto records = SnapshotRecorder::read(path);
+  ASSERT_FALSE(records.empty());
+  EXPECT_EQ(records.back().seq, kNumSnapshots);
+  for (size_t i = 0; i < records.size(); i++) {
+    auto seq = kNumSnapshots - records.size() + i + 1;
+    EXPECT_EQ(records[i].seq, seq);
+    EXPECT_EQ(records[i].snapshot, makeSnapshot("eth1/1/1", seq - 1));
+  }
+
+  // A new recorder on the same file keeps appending to it
+  SnapshotRecorder recorder(path, 16 << 10);
+  recorder.record("eth1/1/1:IPHY", makeSnapshot("eth1/1/1", kNumSnapshots));
+  records = SnapshotRecorder::read(path);
+  EXPECT_EQ(records.back().seq, kNumSnapshots + 1);
+  EXPECT_EQ(records.back().snapshot, makeSnapshot("eth1/1/1", kNumSnapshots));
+}
@@ -11,9 +11,11 @@
 #include "fboss/lib/phy/ExternalPhy.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
@@ -23,6 +25,12 @@ DEFINE_bool(
     true,
     "Initialize pim xphys after creating xphy map");
 
+DEFINE_int32(
+    xphy_stats_collection_deadline_ms,
+    30000,
+    "Deadline (in milliseconds) for collecting the port stats of one xphy, "
+    "ports not collected by then are collected first in the next round");
+
 namespace {
 // Key of the portToCacheInfo map in warmboot state cache
 constexpr auto kPortToCacheInfoKey = "portToCacheInfo";
@@ -30,6 +38,8 @@ constexpr auto kSystemLanesKey = "systemLanes";
 constexpr auto kLineLanesKey = "lineLanes";
 constexpr auto kPortProfileStrKey = "profile";
 constexpr auto kPortSpeedStrKey = "speed";
+// Histogram of the time to collect the port stats of all ports of one xphy
+constexpr auto kXphyStatsCollectionLatency = "xphy.stats_collection.ms";
 } // namespace
 
 namespace facebook::fboss {
@@ -72,7 +82,11 @@ PhyManager::PhyManager(const PlatformMapping* platformMapping)
       portToStatsInfo_(setupPortToStatsInfo(platformMapping)),
       xphySnapshotManager_(
           std::make_unique<
-              PhySnapshotManager<kXphySnapshotIntervalSeconds>>()) {}
+              PhySnapshotManager<kXphySnapshotIntervalSeconds>>()) {
+  fb303::fbData->addHistogram(kXphyStatsCollectionLatency, 100, 0, 10000);
+  fb303::fbData->exportHistogramPercentile(
+      kXphyStatsCollectionLatency, 50, 95, 99);
+}
 PhyManager::~PhyManager() {}
 
 PhyManager::PortToCacheInfo PhyManager::setupPortToCacheInfo(
@@ -529,9 +543,20 @@ void PhyManager::setPortToExternalPhyPortStats(
   wLockedStats->stats = std::move(stats);
 }
 
+using namespace std::chrono;
 void PhyManager::updateAllXphyPortsStats() {
+  // Ports whose xphy port stats need collecting, batched by xphy so that each
+  // xphy gets a single collection job on its pim event base
+  struct XphyPortsBatch {
+    ExternalPhy* xphy;
+    folly::EventBase* evb;
+    std::vector<PortID> portIDs;
+  };
+  std::map<GlobalXphyID, XphyPortsBatch> xphyToPortsBatch;
+  auto now = steady_clock::now();
   for (const auto& portStatsInfo : portToStatsInfo_) {
     bool supportPortStats = false, supportPrbsStats = false;
+    GlobalXphyID xphyID;
     PimID pimID;
     ExternalPhy* xphy;
     {
@@ -548,7 +573,7 @@ void PhyManager::updateAllXphyPortsStats() {
       supportPrbsStats =
           xphy->isSupported(phy::ExternalPhy::Feature::PRBS_STATS);
 
-      auto xphyID = getGlobalXphyIDbyPortIDLocked(rLockedCache);
+      xphyID = getGlobalXphyIDbyPortIDLocked(rLockedCache);
       pimID = getPhyIDInfo(xphyID).pimID;
     }
 
@@ -560,66 +585,126 @@ void PhyManager::updateAllXphyPortsStats() {
     const auto& wLockedStats = getWLockedStats(portStatsInfo.first);
     auto evb = getPimEventBase(pimID);
     if (supportPortStats) {
-      updatePortStats(portStatsInfo.first, xphy, wLockedStats, evb);
+      if (wLockedStats->lastStatCollection) {
+        fb303::fbData->setCounter(
+            folly::to<std::string>(
+                getPortName(portStatsInfo.first), ".xphy.stats_age.ms"),
+            duration_cast<milliseconds>(
+                now - *wLockedStats->lastStatCollection)
+                .count());
+      }
+      if (wLockedStats->ongoingStatCollection.has_value() &&
+          !wLockedStats->ongoingStatCollection->isReady()) {
+        XLOG(DBG4) << "XPHY Port Stat collection for Port:"
+                   << portStatsInfo.first << " still underway...";
+      } else {
+        auto& batch = xphyToPortsBatch[xphyID];
+        batch.xphy = xphy;
+        batch.evb = evb;
+        batch.portIDs.push_back(portStatsInfo.first);
+      }
     }
     if (supportPrbsStats) {
       updatePrbsStats(portStatsInfo.first, xphy, wLockedStats, evb);
     }
   }
+
+  for (auto& [xphyID, batch] : xphyToPortsBatch) {
+    updateXphyPortsStats(
+        xphyID, batch.xphy, std::move(batch.portIDs), batch.evb);
+  }
 }
 
-using namespace std::chrono;
-void PhyManager::updatePortStats(
-    PortID portID,
+void PhyManager::updateXphyPortsStats(
+    GlobalXphyID xphyID,
     phy::ExternalPhy* xphy,
-    const PhyManager::PortStatsWLockedPtr& wLockedStats,
+    std::vector<PortID> portIDs,
     folly::EventBase* pimEvb) {
-  if (wLockedStats->ongoingStatCollection.has_value() &&
-      !wLockedStats->ongoingStatCollection->isReady()) {
-    XLOG(DBG4) << "XPHY Port Stat collection for Port:" << portID
-               << " still underway...";
-    return;
-  }
-
-  // Collect xphy port stats
-  wLockedStats->ongoingStatCollection =
-      folly::via(pimEvb).thenValue([this, portID, xphy](auto&&) {
-        // Since this is future job, we need to fetch the cache with lock
-        std::vector<LaneID> systemLanes, lineLanes;
-        cfg::PortSpeed programmedSpeed;
-        {
-          const auto& wCache = getWLockedCache(portID);
-          if (!wCache->speed || wCache->systemLanes.empty() ||
-              wCache->lineLanes.empty()) {
-            XLOG(WARN) << "Port:" << portID
-                       << " doesn't have programmed speed and lanes";
-            return;
-          }
-          programmedSpeed = *wCache->speed;
-          systemLanes = wCache->systemLanes;
-          lineLanes = wCache->lineLanes;
-        }
-
+  // Ports that have never been collected or were collected the longest time
+  // ago go first, so that a deadline cut off doesn't starve the same ports
+  std::vector<std::pair<steady_clock::time_point, PortID>> lastCollections;
+  lastCollections.reserve(portIDs.size());
+  for (auto portID : portIDs) {
+    const auto& rLockedStats = getRLockedStats(portID);
+    lastCollections.emplace_back(
+        rLockedStats->lastStatCollection.value_or(steady_clock::time_point()),
+        portID);
+  }
+  std::sort(lastCollections.begin(), lastCollections.end());
+  for (size_t i = 0; i < lastCollections.size(); ++i) {
+    portIDs[i] = lastCollections[i].second;
+  }
+
+  // All the ports of the batch share the completion of the collection job
+  auto done = std::make_shared<folly::SharedPromise<folly::Unit>>();
+  for (auto portID : portIDs) {
+    getWLockedStats(portID)->ongoingStatCollection = done->getFuture();
+  }
+
+  auto deadline = steady_clock::now() +
+      milliseconds(FLAGS_xphy_stats_collection_deadline_ms);
+  folly::via(pimEvb)
+      .thenValue([this, xphyID, xphy, portIDs = std::move(portIDs), deadline](
+                     auto&&) {
         steady_clock::time_point begin = steady_clock::now();
-        std::optional<ExternalPhyPortStats> stats;
-        // if PORT_INFO feature is supported, use getPortInfo instead
-        if (xphy->isSupported(phy::ExternalPhy::Feature::PORT_INFO)) {
-          auto xphyPortInfo = xphy->getPortInfo(systemLanes, lineLanes);
-          xphyPortInfo.name() = getPortName(portID);
-          xphyPortInfo.speed() = programmedSpeed;
-          updateXphyInfo(portID, xphyPortInfo);
-          stats = ExternalPhyPortStats::fromPhyInfo(xphyPortInfo);
-        } else {
-          stats = xphy->getPortStats(systemLanes, lineLanes);
+        size_t numCollected = 0;
+        for (auto portID : portIDs) {
+          if (steady_clock::now() > deadline) {
+            XLOG(WARN) << "Xphy " << xphyID
+                       << ": port stat collection deadline passed, skipped "
+                       << portIDs.size() - numCollected << " ports";
+            break;
+          }
+          try {
+            collectPortStats(portID, xphy);
+          } catch (const std::exception& ex) {
+            XLOG(ERR) << "Port " << portID
+                      << ": xphy port stat collection failed: "
+                      << ex.what();
+          }
+          ++numCollected;
         }
+        auto took =
+            duration_cast<milliseconds>(steady_clock::now() - begin).count();
+        fb303::fbData->addHistogramValue(kXphyStatsCollectionLatency, took);
+        XLOG(DBG3) << "Xphy " << xphyID << ": port stat collection of "
+                   << numCollected << " ports took " << took << "ms";
+      })
+      .thenTry([done](auto&&) { done->setValue(); });
+}
+
+void PhyManager::collectPortStats(PortID portID, phy::ExternalPhy* xphy) {
+  // Since this is future job, we need to fetch the cache with lock
+  std::vector<LaneID> systemLanes, lineLanes;
+  cfg::PortSpeed programmedSpeed;
+  {
+    const auto& wCache = getWLockedCache(portID);
+    if (!wCache->speed || wCache->systemLanes.empty() ||
+        wCache->lineLanes.empty()) {
+      XLOG(WARN) << "Port:" << portID
+                 << " doesn't have programmed speed and lanes";
+      return;
+    }
+    programmedSpeed = *wCache->speed;
+    systemLanes = wCache->systemLanes;
+    lineLanes = wCache->lineLanes;
+  }
+
+  std::optional<ExternalPhyPortStats> stats;
+  // if PORT_INFO feature is supported, use getPortInfo instead
+  if (xphy->isSupported(phy::ExternalPhy::Feature::PORT_INFO)) {
+    auto xphyPortInfo = xphy->getPortInfo(systemLanes, lineLanes);
+    xphyPortInfo.name() = getPortName(portID);
+    xphyPortInfo.speed() = programmedSpeed;
+    updateXphyInfo(portID, xphyPortInfo);
+    stats = ExternalPhyPortStats::fromPhyInfo(xphyPortInfo);
+  } else {
+    stats = xphy->getPortStats(systemLanes, lineLanes);
+  }
 
-        const auto& wLockedStats = getWLockedStats(portID);
-        wLockedStats->stats->updateXphyStats(*stats);
-        XLOG(DBG3)
-            << "Port " << portID << ": xphy port stat collection took "
-            << duration_cast<milliseconds>(steady_clock::now() - begin).count()
-            << "ms";
-      });
+  const auto& wLockedStats = getWLockedStats(portID);
+  wLockedStats->stats->updateXphyStats(*stats);
+  wLockedStats->lastStatCollection = steady_clock::now();
 }
 
 void PhyManager::updatePrbsStats(
@@ -14,6 +14,8 @@
 
 #include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <chrono>
 #include <map>
 #include <optional>
 #include <vector>
@@ -332,6 +334,8 @@ class PhyManager {
     std::unique_ptr<ExternalPhyPortStatsUtils> stats;
     std::optional<folly::Future<folly::Unit>> ongoingStatCollection;
     std::optional<folly::Future<folly::Unit>> ongoingPrbsStatCollection;
+    // When the xphy port stats were last collected successfully
+    std::optional<std::chrono::steady_clock::time_point> lastStatCollection;
   };
   using PortToStatsInfo = std::unordered_map<
       PortID,
@@ -343,12 +347,15 @@ class PhyManager {
   PortStatsRLockedPtr getRLockedStats(PortID portID) const;
   PortStatsWLockedPtr getWLockedStats(PortID portID) const;
 
-  // Update PortStatsInfo::stats
-  void updatePortStats(
-      PortID portID,
+  // Update PortStatsInfo::stats of all the given ports of one xphy in a single
+  // job on the pim event base. Ports are collected stalest first, and the ones
+  // left once the collection deadline passes wait for the next round.
+  void updateXphyPortsStats(
+      GlobalXphyID xphyID,
       phy::ExternalPhy* xphy,
-      const PortStatsWLockedPtr& wLockedStats,
+      std::vector<PortID> portIDs,
       folly::EventBase* pimEvb);
+  void collectPortStats(PortID portID, phy::ExternalPhy* xphy);
   void updatePrbsStats(
       PortID portID,
       phy::ExternalPhy* xphy,
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/platforms/common/fake_test/FakeTestPlatformMapping.h"
+#include "fboss/lib/phy/NullPortStats.h"
+#include "fboss/lib/phy/PhyManager.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DECLARE_int32(xphy_stats_collection_deadline_ms);
+
+namespace facebook::fboss {
+
+namespace {
+const PimID kPimID(1);
+const GlobalXphyID kXphyID(0);
+// Ports of the first group of FakeTestPlatformMapping, all on XPHY0
+const std::vector<PortID> kPorts = {PortID(0), PortID(1), PortID(2), PortID(3)};
+
+/*
+ * Xphy that only supports port stats, and records which ports they were
+ * collected for. The system lane of each port is its port id.
+ */
+class FakeXphy : public phy::ExternalPhy {
+ public:
+  phy::PhyFwVersion fwVersion() override {
+    return phy::PhyFwVersion();
+  }
+  void programOnePort(phy::PhyPortConfig /* config */) override {}
+  bool isSupported(Feature feature) const override {
+    return feature == Feature::PORT_STATS;
+  }
+  phy::PhyPortConfig getConfigOnePort(
+      const std::vector<LaneID>& /* sysLanes */,
+      const std::vector<LaneID>& /* lineLanes */) override {
+    return phy::PhyPortConfig();
+  }
+  phy::Loopback getLoopback(phy::Side /* side */) override {
+    return phy::Loopback::OFF;
+  }
+  void setLoopback(phy::Side /* side */, phy::Loopback /* loopback */)
+      override {}
+  void setPortPrbs(
+      phy::Side /* side */,
+      const std::vector<LaneID>& /* lanes */,
+      const phy::PortPrbsState& /* prbs */) override {}
+  phy::PortPrbsState getPortPrbs(
+      phy::Side /* side */,
+      const std::vector<LaneID>& /* lanes */) override {
+    return phy::PortPrbsState();
+  }
+  phy::ExternalPhyPortStats getPortStats(
+      const std::vector<LaneID>& sysLanes,
+      const std::vector<LaneID>& /* lineLanes */) override {
+    auto stall = stall_.exchange(std::chrono::milliseconds(0));
+    std::this_thread::sleep_for(stall);
+    collected_.wlock()->push_back(PortID(sysLanes.front()));
+    return phy::ExternalPhyPortStats();
+  }
+  phy::ExternalPhyPortStats getPortPrbsStats(
+      const std::vector<LaneID>& /* sysLanes */,
+      const std::vector<LaneID>& /* lineLanes */) override {
+    return phy::ExternalPhyPortStats();
+  }
+  void reset() override {}
+
+  // The next port stats collection blocks for this long
+  void stallNextCollection(std::chrono::milliseconds stall) {
+    stall_ = stall;
+  }
+  // Ports collected since the last call, in order
+  std::vector<PortID> takeCollected() {
+    return std::exchange(*collected_.wlock(), {});
+  }
+
+ private:
+  std::atomic<std::chrono::milliseconds> stall_{std::chrono::milliseconds(0)};
+  folly::Synchronized<std::vector<PortID>> collected_;
+};
+
+class FakePhyManager : public PhyManager {
+ public:
+  explicit FakePhyManager(const PlatformMapping* platformMapping)
+      : PhyManager(platformMapping) {
+    numOfSlot_ = 1;
+    auto xphy = std::make_unique<FakeXphy>();
+    xphy_ = xphy.get();
+    xphyMap_[kPimID].emplace(kXphyID, std::move(xphy));
+    setupPimEventMultiThreading(kPimID);
+    for (auto portID : kPorts) {
+      setPortToExternalPhyPortStats(portID, createExternalPhyPortStats(portID));
+    }
+  }
+
+  phy::PhyIDInfo getPhyIDInfo(GlobalXphyID xphyID) const override {
+    return phy::PhyIDInfo{kPimID, MdioControllerID(0), PhyAddr(xphyID)};
+  }
+  GlobalXphyID getGlobalXphyID(const phy::PhyIDInfo& phyIDInfo) const override {
+    return GlobalXphyID(phyIDInfo.phyAddr);
+  }
+  bool initExternalPhyMap() override {
+    return true;
+  }
+  void initializeSlotPhys(PimID /* pimID */, bool /* warmboot */) override {}
+  MultiPimPlatformSystemContainer* getSystemContainer() override {
+    return nullptr;
+  }
+
+  // Mark the port as programmed, which is all stats collection looks at
+  void setPortProgrammed(PortID portID) {
+    const auto& wLockedCache = getWLockedCache(portID);
+    wLockedCache->speed = cfg::PortSpeed::XXVG;
+    wLockedCache->systemLanes = {LaneID(portID)};
+    wLockedCache->lineLanes = {LaneID(portID)};
+  }
+
+  FakeXphy* getFakeXphy() {
+    return xphy_;
+  }
+
+ private:
+  void createExternalPhy(
+      const phy::PhyIDInfo& /* phyIDInfo */,
+      MultiPimPlatformPimContainer* /* pimContainer */) override {}
+  std::unique_ptr<ExternalPhyPortStatsUtils> createExternalPhyPortStats(
+      PortID portID) override {
+    return std::make_unique<NullPortStats>(getPortName(portID));
+  }
+
+  FakeXphy* xphy_;
+};
+} // namespace
+
+class PhyManagerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_xphy_stats_collection_deadline_ms = 50;
+    phyManager_ = std::make_unique<FakePhyManager>(&platformMapping_);
+    for (auto portID : kPorts) {
+      phyManager_->setPortProgrammed(portID);
+    }
+  }
+
+  // Run one round of xphy stats collection, returns the collected ports
+  std::vector<PortID> collectXphyStats() {
+    phyManager_->updateAllXphyPortsStats();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (auto portID : kPorts) {
+      while (!phyManager_->isXphyStatsCollectionDone(portID)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          ADD_FAILURE() << "Xphy stats collection of port " << portID
+                        << " didn't complete";
+          return {};
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return phyManager_->getFakeXphy()->takeCollected();
+  }
+
+  int64_t getStatsAgeMs(PortID portID) {
+    return fb303::fbData->getCounter(folly::to<std::string>(
+        phyManager_->getPortName(portID), ".xphy.stats_age.ms"));
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  FakeTestPlatformMapping platformMapping_{std::vector<int>{0}};
+  std::unique_ptr<FakePhyManager> phyManager_;
+};
+
+TEST_F(PhyManagerTest, collectsAllPortsOfXphy) {
+  EXPECT_EQ(collectXphyStats(), kPorts);
+  EXPECT_EQ(collectXphyStats(), kPorts);
+}
+
+TEST_F(PhyManagerTest, deadlineSkipsRemainingPorts) {
+  // Stalling on the first port passes the deadline of the whole xphy
+  phyManager_->getFakeXphy()->stallNextCollection(
+      std::chrono::milliseconds(FLAGS_xphy_stats_collection_deadline_ms * 2));
+  EXPECT_EQ(collectXphyStats(), std::vector<PortID>{PortID(0)});
+
+  // The skipped ports are the stalest, so they go first in the next round
+  EXPECT_EQ(
+      collectXphyStats(),
+      std::vector<PortID>({PortID(1), PortID(2), PortID(3), PortID(0)}));
+}
+
+TEST_F(PhyManagerTest, statsAgeCounter) {
+  auto msSince = [](std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+  auto beforeFirstRound = std::chrono::steady_clock::now();
+  phyManager_->getFakeXphy()->stallNextCollection(
+      std::chrono::milliseconds(FLAGS_xphy_stats_collection_deadline_ms * 2));
+  collectXphyStats();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  // The age of port 0, the only one collected, is exported as of the start
+  // of the next round
+  auto beforeSecondRound = std::chrono::steady_clock::now();
+  collectXphyStats();
+  EXPECT_GE(getStatsAgeMs(PortID(0)), 20);
+  EXPECT_LE(getStatsAgeMs(PortID(0)), msSince(beforeFirstRound));
+
+  // Every port was collected in the second round
+  collectXphyStats();
+  for (auto portID : kPorts) {
+    EXPECT_LE(getStatsAgeMs(portID), msSince(beforeSecondRound));
+  }
+}
+
+} // namespace facebook::fboss
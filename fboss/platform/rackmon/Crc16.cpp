@@ -0,0 +1,60 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include "Crc16.h"
+#include <array>
+
+namespace rackmon {
+
+namespace {
+constexpr uint16_t kPolynomial = 0xA001;
+constexpr size_t kNumSlices = 8;
+
+using Crc16Tables = std::array<std::array<uint16_t, 256>, kNumSlices>;
+
+// tables[0] is the classic bytewise table. tables[k][b] is the CRC
+// of byte b followed by k zero bytes.
+constexpr Crc16Tables makeTables() {
+  Crc16Tables tables{};
+  for (uint16_t b = 0; b < 256; b++) {
+    uint16_t crc = b;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ kPolynomial : crc >> 1;
+    }
+    tables[0][b] = crc;
+  }
+  for (size_t k = 1; k < kNumSlices; k++) {
+    for (uint16_t b = 0; b < 256; b++) {
+      uint16_t prev = tables[k - 1][b];
+      tables[k][b] = (prev >> 8) ^ tables[0][prev & 0xff];
+    }
+  }
+  return tables;
+}
+
+constexpr Crc16Tables kTables = makeTables();
+
+inline uint16_t crc16Update(uint16_t crc, const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    crc = (crc >> 8) ^ kTables[0][(crc ^ data[i]) & 0xff];
+  }
+  return crc;
+}
+} // namespace
+
+uint16_t crc16Bytewise(const uint8_t* data, size_t len) {
+  return crc16Update(0xFFFF, data, len);
+}
+
+uint16_t crc16(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len >= kNumSlices) {
+    crc = kTables[7][data[0] ^ (crc & 0xff)] ^
+        kTables[6][data[1] ^ (crc >> 8)] ^ kTables[5][data[2]] ^
+        kTables[4][data[3]] ^ kTables[3][data[4]] ^ kTables[2][data[5]] ^
+        kTables[1][data[6]] ^ kTables[0][data[7]];
+    data += kNumSlices;
+    len -= kNumSlices;
+  }
+  return crc16Update(crc, data, len);
+}
+
+} // namespace rackmon
@@ -0,0 +1,18 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace rackmon {
+
+// CRC-16/MODBUS (reflected polynomial 0xA001, initial value 0xFFFF).
+// The CRC is transmitted low byte first.
+
+// Table driven, one byte at a time.
+uint16_t crc16Bytewise(const uint8_t* data, size_t len);
+
+// Slice-by-8: folds 8 bytes per iteration through 8 tables, which
+// breaks the byte to byte dependency of the bytewise loop.
+uint16_t crc16(const uint8_t* data, size_t len);
+
+} // namespace rackmon
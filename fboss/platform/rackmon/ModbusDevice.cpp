@@ -34,6 +34,7 @@ ModbusDevice::ModbusDevice(
     hdl.SpecialHandlerInfo::operator=(sp);
     specialHandlers_.push_back(hdl);
   }
+  planRegisterReads();
 }
 
 void ModbusDevice::handleCommandFailure(std::exception& baseException) {
@@ -126,6 +127,44 @@ void ModbusDevice::readFileRecord(
   command(req, resp, timeout);
 }
 
+void ModbusDevice::planRegisterReads() {
+  readPlan_.clear();
+  for (size_t i = 0; i < info_.registerList.size(); i++) {
+    auto& registerStore = info_.registerList[i];
+    if (!registerStore.isEnabled()) {
+      continue;
+    }
+    uint16_t begin = registerStore.regAddr();
+    uint16_t length = registerStore.length();
+    if (!readPlan_.empty()) {
+      // registerList is sorted by address, so only the last
+      // range can be extended.
+      auto& last = readPlan_.back();
+      uint32_t lastEnd = uint32_t(last.begin) + last.length;
+      uint32_t end = std::max(lastEnd, uint32_t(begin) + length);
+      if (begin <= lastEnd + kMaxCoalesceGap &&
+          end - last.begin <= kMaxRegistersPerRead) {
+        last.length = end - last.begin;
+        last.registers.push_back(i);
+        continue;
+      }
+    }
+    readPlan_.push_back({begin, length, {i}});
+  }
+}
+
+void ModbusDevice::monitorRange(
+    const RegisterReadRange& range,
+    uint32_t timestamp) {
+  std::vector<uint16_t> regs(range.length);
+  readHoldingRegisters(range.begin, regs);
+  for (size_t idx : range.registers) {
+    auto& registerStore = info_.registerList[idx];
+    registerStore.store(
+        &regs[registerStore.regAddr() - range.begin], timestamp);
+  }
+}
+
 void ModbusDevice::monitor() {
   // If the number of consecutive failures has exceeded
   // a threshold, mark the device as dormant.
@@ -134,24 +173,45 @@ void ModbusDevice::monitor() {
     specialHandler.handle(*this);
   }
   std::unique_lock lk(registerListMutex_);
-  for (auto& registerStore : info_.registerList) {
-    uint16_t registerOffset = registerStore.regAddr();
-    auto& nextRegister = registerStore.front();
-    if (!registerStore.isEnabled()) {
+  for (size_t i = 0; i < readPlan_.size(); i++) {
+    const auto& range = readPlan_[i];
+    if (std::none_of(
+            range.registers.begin(), range.registers.end(), [this](size_t r) {
+              return info_.registerList[r].isEnabled();
+            })) {
       continue;
     }
+    auto& registerStore = info_.registerList[range.registers.front()];
     try {
-      readHoldingRegisters(registerOffset, nextRegister.value);
-      nextRegister.timestamp = timestamp;
-      // If we dont care about changes or if we do
-      // and we notice that the value is different
-      // from the previous, increment store to
-      // point to the next.
-      if (!nextRegister.desc.storeChangesOnly ||
-          nextRegister != registerStore.back()) {
-        ++registerStore;
-      }
+      monitorRange(range, timestamp);
     } catch (ModbusError& e) {
+      if (range.registers.size() > 1 &&
+          (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS ||
+           e.errorCode == ModbusErrorCode::ILLEGAL_DATA_VALUE)) {
+        // The device rejected the merged read, most likely
+        // since a register (or gap) in the range is not
+        // implemented. Fall back to reading the registers in
+        // this range one at a time, starting with this cycle,
+        // so that unsupported ones get disabled as before.
+        // Other errors (busy, device failure) are transient,
+        // the merged read is retried on the next cycle.
+        logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+                << " ReadRange 0x" << std::hex << range.begin << " len "
+                << std::dec << range.length << " caught: " << e.what()
+                << ". Splitting to single register reads" << std::endl;
+        std::vector<RegisterReadRange> split;
+        for (size_t idx : range.registers) {
+          auto& store = info_.registerList[idx];
+          split.push_back(
+              {store.regAddr(), store.length(), {idx}});
+        }
+        readPlan_.erase(readPlan_.begin() + i);
+        readPlan_.insert(readPlan_.begin() + i, split.begin(), split.end());
+        // Retry from the first of the split ranges.
+        i--;
+        continue;
+      }
+      uint16_t registerOffset = registerStore.regAddr();
       logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
               << " ReadReg 0x" << std::hex << registerOffset << ' '
               << registerStore.name() << " caught: " << e.what() << std::endl;
@@ -169,7 +229,7 @@ void ModbusDevice::monitor() {
       continue;
     } catch (std::exception& e) {
       logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
-              << " ReadReg 0x" << std::hex << registerOffset << ' '
+              << " ReadRange 0x" << std::hex << range.begin << ' '
               << registerStore.name() << " caught: " << e.what() << std::endl;
       continue;
     }
@@ -185,6 +245,7 @@ void ModbusDevice::setActive() {
   for (auto& registerStore : info_.registerList) {
     registerStore.enable();
   }
+  planRegisterReads();
   // Clear the num failures so we consider it active.
   info_.numConsecutiveFailures = 0;
   info_.mode = ModbusDeviceMode::ACTIVE;
@@ -196,6 +257,12 @@ ModbusDeviceRawData ModbusDevice::getRawData() {
   return info_;
 }
 
+void ModbusDevice::visitRawData(
+    const std::function<void(const ModbusDeviceRawData&)>& fn) {
+  std::unique_lock lk(registerListMutex_);
+  fn(info_);
+}
+
 ModbusDeviceInfo ModbusDevice::getInfo() {
   std::unique_lock lk(registerListMutex_);
   return info_;
@@ -211,6 +278,11 @@ ModbusDeviceValueData ModbusDevice::getValueData() {
   return data;
 }
 
+std::vector<RegisterReadRange> ModbusDevice::getReadPlan() {
+  std::unique_lock lk(registerListMutex_);
+  return readPlan_;
+}
+
 static std::string commandOutput(const std::string& shell) {
   std::array<char, 128> buffer;
   std::string result;
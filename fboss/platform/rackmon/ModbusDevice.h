@@ -1,7 +1,9 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #pragma once
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <ctime>
+#include <functional>
 #include <iostream>
 #include "Modbus.h"
 #include "ModbusCmds.h"
@@ -73,16 +75,44 @@ struct ModbusDeviceValueData : public ModbusDeviceInfo {
 };
 void to_json(nlohmann::json& j, const ModbusDeviceValueData& m);
 
+// A single read-holding-registers transaction covering one or
+// more monitored registers of a device.
+struct RegisterReadRange {
+  uint16_t begin = 0;
+  uint16_t length = 0;
+  // Indexes of the covered registers in ModbusDeviceRawData::registerList
+  std::vector<size_t> registers{};
+};
+
 class ModbusDevice {
   Modbus& interface_;
   int numCommandRetries_;
   ModbusDeviceRawData info_;
   std::mutex registerListMutex_{};
   std::vector<ModbusSpecialHandler> specialHandlers_{};
+  // Read plan of the enabled registers in info_.registerList,
+  // protected by registerListMutex_.
+  std::vector<RegisterReadRange> readPlan_{};
 
   void handleCommandFailure(std::exception& baseException);
 
+  // Merges the enabled registers into as few range reads as
+  // possible. Registers are merged when at most
+  // kMaxCoalesceGap registers apart, as long as the range
+  // stays within kMaxRegistersPerRead.
+  void planRegisterReads();
+
+  // Reads a single range from the plan and stores the values
+  // of the registers it covers.
+  void monitorRange(const RegisterReadRange& range, uint32_t timestamp);
+
  public:
+  // Modbus caps a read at 125 registers; also respect our max
+  // message length: addr(1), func(1), bytes(1), <2 * regs>, crc(2).
+  static constexpr uint16_t kMaxRegistersPerRead =
+      std::min<size_t>(125, (Msg::kMaxModbusLength - 5) / 2);
+  static constexpr uint16_t kMaxCoalesceGap = 4;
+
   ModbusDevice(
       Modbus& interface,
       uint8_t deviceAddress,
@@ -133,8 +163,15 @@ class ModbusDevice {
   // Returns raw monitor register data monitored for this device.
   ModbusDeviceRawData getRawData();
 
+  // Calls fn with the raw monitor data under the register list lock,
+  // letting callers convert the register history without a deep copy.
+  void visitRawData(const std::function<void(const ModbusDeviceRawData&)>& fn);
+
   // Returns value formatted register data monitored for this device.
   ModbusDeviceValueData getValueData();
+
+  // Returns the current read plan of the monitored registers.
+  std::vector<RegisterReadRange> getReadPlan();
 };
 
 } // namespace rackmon
@@ -31,6 +31,8 @@ struct Msg {
   Msg& operator<<(uint8_t d);
   Msg& operator<<(uint16_t d);
   Msg& operator<<(uint32_t d);
+  // Registers are copied in bulk.
+  Msg& operator<<(std::vector<uint16_t>& d);
   template <typename T>
   Msg& operator<<(std::vector<T>& d) {
     for (T v : d) {
@@ -43,6 +45,7 @@ struct Msg {
   Msg& operator>>(uint8_t& d);
   Msg& operator>>(uint16_t& d);
   Msg& operator>>(uint32_t& d);
+  Msg& operator>>(std::vector<uint16_t>& d);
   template <typename T>
   Msg& operator>>(std::vector<T>& d) {
     for (auto it = d.rbegin(); it != d.rend(); it++) {
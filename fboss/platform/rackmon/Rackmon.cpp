@@ -312,6 +312,14 @@ void Rackmon::getRawData(std::vector<ModbusDeviceRawData>& data) const {
       });
 }
 
+void Rackmon::visitRawData(
+    const std::function<void(const ModbusDeviceRawData&)>& fn) const {
+  std::shared_lock lock(devicesMutex_);
+  for (const auto& [addr, dev] : devices_) {
+    dev->visitRawData(fn);
+  }
+}
+
 void Rackmon::getValueData(std::vector<ModbusDeviceValueData>& data) const {
   data.clear();
   std::shared_lock lock(devicesMutex_);
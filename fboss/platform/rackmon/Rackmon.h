@@ -157,6 +157,10 @@ class Rackmon {
   // Get monitored data
   void getRawData(std::vector<ModbusDeviceRawData>& data) const;
 
+  // Visit monitored data of each device without copying it
+  void visitRawData(
+      const std::function<void(const ModbusDeviceRawData&)>& fn) const;
+
   // Get value data
   void getValueData(std::vector<ModbusDeviceValueData>& data) const;
 
@@ -73,24 +73,27 @@ ModbusRegisterValue ThriftHandler::transformRegisterValue(
   return target;
 }
 
-ModbusRegisterStore ThriftHandler::transformRegisterStoreValue(
-    const rackmon::RegisterStoreValue& source) {
+ModbusRegisterStore ThriftHandler::transformRegisterStore(
+    const rackmon::RegisterStore& source) {
   ModbusRegisterStore target;
 
-  target.regAddress() = source.regAddr;
-  target.name() = source.name;
-  for (const auto& reg : source.history) {
-    target.history()->emplace_back(transformRegisterValue(reg));
-  }
+  target.regAddress() = source.regAddr();
+  target.name() = source.name();
+  target.history()->reserve(source.size());
+  source.forEachReading(
+      [&](uint32_t timestamp, const std::vector<uint16_t>& words) {
+        target.history()->emplace_back(transformRegisterValue(
+            rackmon::RegisterValue(words, source.descriptor(), timestamp)));
+      });
   return target;
 }
 
-RackmonMonitorData ThriftHandler::transformModbusDeviceValueData(
-    const rackmon::ModbusDeviceValueData& source) {
+RackmonMonitorData ThriftHandler::transformModbusDeviceRawData(
+    const rackmon::ModbusDeviceRawData& source) {
   RackmonMonitorData data;
   data.devInfo() = transformModbusDeviceInfo(source);
   for (const auto& reg : source.registerList) {
-    data.regList()->emplace_back(transformRegisterStoreValue(reg));
+    data.regList()->emplace_back(transformRegisterStore(reg));
   }
   return data;
 }
@@ -112,11 +115,11 @@ void ThriftHandler::listModbusDevices(std::vector<ModbusDeviceInfo>& devices) {
 }
 
 void ThriftHandler::getMonitorData(std::vector<RackmonMonitorData>& data) {
-  std::vector<rackmon::ModbusDeviceValueData> indata;
-  rackmond_.getValueData(indata);
-  for (auto& dev : indata) {
-    data.emplace_back(transformModbusDeviceValueData(dev));
-  }
+  // Build the response straight from the register history instead of
+  // going through an intermediate copy of every decoded value.
+  rackmond_.visitRawData([&](const rackmon::ModbusDeviceRawData& dev) {
+    data.emplace_back(transformModbusDeviceRawData(dev));
+  });
 }
 
 void ThriftHandler::readHoldingRegisters(
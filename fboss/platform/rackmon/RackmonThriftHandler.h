@@ -24,10 +24,10 @@ class ThriftHandler : virtual public RackmonCtrlSvIf {
 
   ModbusDeviceInfo transformModbusDeviceInfo(
       const rackmon::ModbusDeviceInfo& source);
-  ModbusRegisterStore transformRegisterStoreValue(
-      const rackmon::RegisterStoreValue& source);
-  RackmonMonitorData transformModbusDeviceValueData(
-      const rackmon::ModbusDeviceValueData& source);
+  ModbusRegisterStore transformRegisterStore(
+      const rackmon::RegisterStore& source);
+  RackmonMonitorData transformModbusDeviceRawData(
+      const rackmon::ModbusDeviceRawData& source);
   ModbusRegisterValue transformRegisterValue(
       const rackmon::RegisterValue& value);
 
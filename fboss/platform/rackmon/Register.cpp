@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "Register.h"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <numeric>
@@ -187,13 +188,71 @@ Register::operator RegisterValue() const {
   return RegisterValue(value, desc, timestamp);
 }
 
-RegisterStore::operator RegisterStoreValue() const {
-  RegisterStoreValue ret(regAddr_, desc_.name);
-  for (const auto& reg : history_) {
-    if (reg) {
-      ret.history.emplace_back(reg);
+uint32_t RegisterStore::farTimestamp(uint16_t slot) const {
+  auto it = std::find_if(
+      farTimestamps_.begin(), farTimestamps_.end(), [slot](const auto& far) {
+        return far.first == slot;
+      });
+  return it == farTimestamps_.end() ? 0 : it->second;
+}
+
+void RegisterStore::store(const uint16_t* words, uint32_t timestamp) {
+  size_t length = desc_.length;
+  if (desc_.storeChangesOnly && numReadings_ > 0) {
+    auto latest = words_.begin() + size_t(slot(numReadings_ - 1)) * length;
+    if (std::equal(words, words + length, latest)) {
+      return;
     }
   }
+  bool wasEmpty = numReadings_ == 0;
+  if (numReadings_ == desc_.keep) {
+    // Overwriting the oldest reading, the next one becomes the oldest.
+    oldestTimestamp_ =
+        nextTimestamp((idx_ + 1) % desc_.keep, oldestTimestamp_);
+    farTimestamps_.erase(
+        std::remove_if(
+            farTimestamps_.begin(),
+            farTimestamps_.end(),
+            [this](const auto& far) { return far.first == idx_; }),
+        farTimestamps_.end());
+  } else {
+    numReadings_++;
+  }
+
+  uint32_t delta = timestamp - latestTimestamp_;
+  if (wasEmpty) {
+    timeDeltas_[idx_] = 0;
+  } else if (timestamp < latestTimestamp_ || delta >= kFarTimestamp) {
+    timeDeltas_[idx_] = kFarTimestamp;
+    farTimestamps_.emplace_back(idx_, timestamp);
+  } else {
+    timeDeltas_[idx_] = delta;
+  }
+  if (wasEmpty || desc_.keep == 1) {
+    oldestTimestamp_ = timestamp;
+  }
+  latestTimestamp_ = timestamp;
+  std::copy(words, words + length, words_.begin() + size_t(idx_) * length);
+  idx_ = (idx_ + 1) % desc_.keep;
+}
+
+Register RegisterStore::back() const {
+  Register reg(desc_);
+  if (numReadings_ > 0) {
+    auto latest = words_.begin() +
+        size_t(slot(numReadings_ - 1)) * desc_.length;
+    std::copy(latest, latest + desc_.length, reg.value.begin());
+    reg.timestamp = latestTimestamp_;
+  }
+  return reg;
+}
+
+RegisterStore::operator RegisterStoreValue() const {
+  RegisterStoreValue ret(regAddr_, desc_.name);
+  ret.history.reserve(numReadings_);
+  forEachReading([&](uint32_t timestamp, const std::vector<uint16_t>& words) {
+    ret.history.emplace_back(words, desc_, timestamp);
+  });
   return ret;
 }
 
@@ -324,7 +383,18 @@ void to_json(json& j, const RegisterStoreValue& m) {
 
 void to_json(json& j, const RegisterStore& m) {
   j["begin"] = m.regAddr_;
-  j["readings"] = m.history_;
+  j["readings"] = json::array();
+  Register reg(m.desc_);
+  m.forEachReading([&](uint32_t timestamp, const std::vector<uint16_t>& words) {
+    reg.timestamp = timestamp;
+    reg.value = words;
+    j["readings"].push_back(reg);
+  });
+  // Legacy format lists unused slots as zero readings.
+  Register unused(m.desc_);
+  for (size_t i = m.numReadings_; i < m.desc_.keep; i++) {
+    j["readings"].push_back(unused);
+  }
 }
 
 void from_json(const json& j, WriteActionInfo& action) {
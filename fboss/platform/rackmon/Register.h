@@ -143,24 +143,53 @@ void to_json(nlohmann::json& j, const RegisterStoreValue& m);
 // Container of values of a single register at multiple points in
 // time. (RegisterDescriptor::keep defines the size of the depth
 // of the historical record).
+//
+// The history is stored by column rather than as a Register per
+// reading: the raw words of all the readings are packed in a single
+// vector, and timestamps are kept as 16bit deltas from the previous
+// reading. Readings are only decoded into a RegisterValue when asked
+// for, see forEachReading().
 struct RegisterStore {
  private:
+  // Time delta stored when the reading is too far (or back) in time
+  // from the previous one, its timestamp is then in farTimestamps_.
+  static constexpr uint16_t kFarTimestamp = 0xffff;
+
   // Reference to the register descriptor
   const RegisterDescriptor& desc_;
   // Address of the register.
   uint16_t regAddr_;
-  // History of the register contents to keep. This is utilized as
-  // a circular buffer with idx pointing to the current slot to
-  // write.
-  std::vector<Register> history_;
-  int32_t idx_ = 0;
+  // Words of the last desc_.keep readings, desc_.length words per
+  // slot. This is utilized as a circular buffer with idx pointing to
+  // the slot to write next.
+  std::vector<uint16_t> words_;
+  // Per slot, the time since the reading in the previous slot.
+  std::vector<uint16_t> timeDeltas_;
+  // Slot and timestamp of readings with a kFarTimestamp delta.
+  std::vector<std::pair<uint16_t, uint32_t>> farTimestamps_{};
+  // Timestamps of the oldest and the latest readings.
+  uint32_t oldestTimestamp_ = 0;
+  uint32_t latestTimestamp_ = 0;
+  uint16_t idx_ = 0;
+  uint16_t numReadings_ = 0;
   bool enabled_ = true;
 
+  // Slot of the n-th oldest reading
+  uint16_t slot(size_t n) const {
+    return (idx_ + desc_.keep - numReadings_ + n) % desc_.keep;
+  }
+  uint32_t farTimestamp(uint16_t slot) const;
+  uint32_t nextTimestamp(uint16_t slot, uint32_t prevTimestamp) const {
+    return timeDeltas_[slot] == kFarTimestamp ? farTimestamp(slot)
+                                              : prevTimestamp + timeDeltas_[slot];
+  }
+
  public:
   explicit RegisterStore(const RegisterDescriptor& desc)
       : desc_(desc),
         regAddr_(desc.begin),
-        history_(desc.keep, Register(desc)) {}
+        words_(size_t(desc.keep) * desc.length),
+        timeDeltas_(desc.keep) {}
 
   bool isEnabled() {
     return enabled_;
@@ -172,17 +201,45 @@ struct RegisterStore {
     enabled_ = true;
   }
 
-  // Returns a reference to the last written value (Back of the list)
-  Register& back() {
-    return idx_ == 0 ? history_.back() : history_[idx_ - 1];
+  // Stores a reading of the register, words holds length() values.
+  // If the register only keeps changes, a reading equal to the
+  // latest one is dropped.
+  void store(const uint16_t* words, uint32_t timestamp);
+
+  // Number of words of the register
+  uint16_t length() const {
+    return desc_.length;
   }
-  // Returns the front (Next to write) reference
-  Register& front() {
-    return history_[idx_];
+
+  // Number of readings stored
+  size_t size() const {
+    return numReadings_;
   }
-  // Advances the front.
-  void operator++() {
-    idx_ = (idx_ + 1) % history_.size();
+
+  // Returns the latest reading, an invalid Register if there is none.
+  Register back() const;
+
+  // Calls fn(timestamp, words) for each stored reading, in slot order
+  // (oldest first until the history wraps around). words is a scratch
+  // buffer reused across the calls.
+  template <typename Fn>
+  void forEachReading(Fn&& fn) const {
+    // Timestamps can only be resolved from the oldest reading on.
+    std::vector<uint32_t> timestamps(numReadings_);
+    uint32_t timestamp = oldestTimestamp_;
+    for (size_t n = 0; n < numReadings_; n++) {
+      if (n > 0) {
+        timestamp = nextTimestamp(slot(n), timestamp);
+      }
+      timestamps[slot(n)] = timestamp;
+    }
+    // Slots fill up from 0, so the first numReadings_ are in use.
+    std::vector<uint16_t> words(desc_.length);
+    for (uint16_t i = 0; i < numReadings_; i++) {
+      auto first = words_.begin() + size_t(i) * desc_.length;
+      std::copy(first, first + desc_.length, words.begin());
+      fn(timestamps[i], words);
+    }
   }
 
   // register address accessor
@@ -194,6 +251,10 @@ struct RegisterStore {
     return desc_.name;
   }
 
+  const RegisterDescriptor& descriptor() const {
+    return desc_;
+  }
+
   // Returns a string formatted representation of the historical record.
   operator std::string() const;
 
@@ -0,0 +1,41 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <array>
+#include "Crc16.h"
+
+using namespace rackmon;
+
+namespace {
+constexpr size_t kFrameSize = 256;
+
+std::array<uint8_t, kFrameSize> makeFrame() {
+  std::array<uint8_t, kFrameSize> frame;
+  for (size_t i = 0; i < frame.size(); i++) {
+    frame[i] = i * 37 + 11;
+  }
+  return frame;
+}
+} // namespace
+
+BENCHMARK(Crc16Bytewise, iters) {
+  auto frame = makeFrame();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(crc16Bytewise(frame.data(), frame.size()));
+    folly::makeUnpredictable(frame);
+  }
+}
+
+BENCHMARK_RELATIVE(Crc16SliceBy8, iters) {
+  auto frame = makeFrame();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(crc16(frame.data(), frame.size()));
+    folly::makeUnpredictable(frame);
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
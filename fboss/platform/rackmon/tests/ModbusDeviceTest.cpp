@@ -504,6 +504,203 @@ TEST_F(ModbusDeviceTest, MonitorRawData) {
   EXPECT_EQ(data3["ranges"][0]["readings"][1]["data"], "62636465");
 }
 
+// Register map with a few registers close enough to be read
+// with a single command, and one far away from the rest.
+class ModbusDeviceCoalesceTest : public ::testing::Test {
+ protected:
+  Mock2Modbus modbus_device;
+  RegisterMap regmap = R"({
+    "name": "orv3_psu",
+    "address_range": [110, 140],
+    "probe_register": 104,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": [
+      {
+        "begin": 0,
+        "length": 2,
+        "format": "string",
+        "name": "MFG_MODEL"
+      },
+      {
+        "begin": 2,
+        "length": 1,
+        "name": "REG_A"
+      },
+      {
+        "begin": 7,
+        "length": 1,
+        "name": "REG_B"
+      },
+      {
+        "begin": 256,
+        "length": 2,
+        "name": "REG_C"
+      }
+    ]
+  })"_json;
+};
+
+TEST_F(ModbusDeviceCoalesceTest, ReadPlan) {
+  ModbusDevice dev(modbus_device, 0x32, regmap);
+  std::vector<RegisterReadRange> plan = dev.getReadPlan();
+  ASSERT_EQ(plan.size(), 2);
+  EXPECT_EQ(plan[0].begin, 0);
+  EXPECT_EQ(plan[0].length, 8);
+  EXPECT_EQ(plan[0].registers, std::vector<size_t>({0, 1, 2}));
+  EXPECT_EQ(plan[1].begin, 256);
+  EXPECT_EQ(plan[1].length, 2);
+  EXPECT_EQ(plan[1].registers, std::vector<size_t>({3}));
+}
+
+TEST_F(ModbusDeviceCoalesceTest, ReadPlanMaxLength) {
+  RegisterDescriptor desc = regmap.registerDescriptors.at(256);
+  regmap.registerDescriptors.erase(256);
+  desc.begin = 8;
+  desc.length = ModbusDevice::kMaxRegistersPerRead;
+  regmap.registerDescriptors.emplace(desc.begin, desc);
+  ModbusDevice dev(modbus_device, 0x32, regmap);
+  std::vector<RegisterReadRange> plan = dev.getReadPlan();
+  ASSERT_EQ(plan.size(), 2);
+  EXPECT_EQ(plan[0].begin, 0);
+  EXPECT_EQ(plan[0].length, 8);
+  EXPECT_EQ(plan[1].begin, 8);
+  EXPECT_EQ(plan[1].length, ModbusDevice::kMaxRegistersPerRead);
+}
+
+TEST_F(ModbusDeviceCoalesceTest, MonitorCoalesced) {
+  // The matcher encodes the request, so only let it see the expected one.
+  Sequence s;
+  EXPECT_CALL(
+      modbus_device,
+      command(
+          // addr(1) = 0x32,
+          // func(1) = 0x03,
+          // reg_off(2) = 0x0000,
+          // reg_cnt(2) = 0x0008
+          encodeMsgContentEqual(0x320300000008_EM),
+          _,
+          19200,
+          ModbusTime::zero(),
+          ModbusTime::zero()))
+      .InSequence(s)
+      // addr(1) = 0x32,
+      // func(1) = 0x03,
+      // bytes(1) = 0x10,
+      // data(16) = 61626364 1122 0000 0000 0000 0000 3344
+      .WillOnce(SetMsgDecode<1>(0x32031061626364112200000000000000003344_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(
+          encodeMsgContentEqual(0x320301000002_EM),
+          _,
+          19200,
+          ModbusTime::zero(),
+          ModbusTime::zero()))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030455667788_EM));
+
+  ModbusDevice dev(modbus_device, 0x32, regmap);
+  dev.monitor();
+  nlohmann::json data = dev.getRawData();
+  ASSERT_TRUE(data["ranges"].is_array() && data["ranges"].size() == 4);
+  EXPECT_EQ(data["ranges"][0]["readings"][0]["data"], "61626364");
+  EXPECT_EQ(data["ranges"][1]["readings"][0]["data"], "1122");
+  EXPECT_EQ(data["ranges"][2]["readings"][0]["data"], "3344");
+  EXPECT_EQ(data["ranges"][3]["readings"][0]["data"], "55667788");
+}
+
+TEST_F(ModbusDeviceCoalesceTest, MonitorSplitsRejectedRange) {
+  Sequence s;
+  // The merged read is rejected, so registers are read one by one,
+  // and REG_A turns out to be the unsupported one.
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300000008_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x328302_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030461626364_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300020001_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x328302_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300070001_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x3203023344_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320301000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030455667788_EM));
+  // Next cycle skips REG_A
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030461626364_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300070001_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x3203023344_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320301000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030455667788_EM));
+
+  ModbusDevice dev(modbus_device, 0x32, regmap, 1);
+  dev.monitor();
+  EXPECT_EQ(dev.getReadPlan().size(), 4);
+  dev.monitor();
+  nlohmann::json data = dev.getRawData();
+  EXPECT_EQ(data["ranges"][0]["readings"][0]["data"], "61626364");
+  EXPECT_EQ(data["ranges"][2]["readings"][0]["data"], "3344");
+  EXPECT_EQ(data["ranges"][3]["readings"][0]["data"], "55667788");
+}
+
+TEST_F(ModbusDeviceCoalesceTest, MonitorKeepsRangeOnTransientError) {
+  Sequence s;
+  // The device is busy, the merged read is kept and retried next cycle.
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300000008_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x328306_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320301000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030455667788_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320300000008_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32031061626364112200000000000000003344_EM));
+  EXPECT_CALL(
+      modbus_device,
+      command(encodeMsgContentEqual(0x320301000002_EM), _, _, _, _))
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x32030455667788_EM));
+
+  ModbusDevice dev(modbus_device, 0x32, regmap, 1);
+  dev.monitor();
+  EXPECT_EQ(dev.getReadPlan().size(), 2);
+  dev.monitor();
+  EXPECT_EQ(dev.getReadPlan().size(), 2);
+  nlohmann::json data = dev.getRawData();
+  EXPECT_EQ(data["ranges"][0]["readings"][0]["data"], "61626364");
+  EXPECT_EQ(data["ranges"][1]["readings"][0]["data"], "1122");
+  EXPECT_EQ(data["ranges"][2]["readings"][0]["data"], "3344");
+}
+
 class MockModbusDevice : public ModbusDevice {
  public:
   MockModbusDevice(Modbus& m, uint8_t addr, const RegisterMap& rmap)
@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "Msg.h"
+#include "Crc16.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -220,3 +221,37 @@ TEST(Msg, AssignmentOperator) {
   msg2 = msg1;
   EXPECT_EQ(msg1, msg2);
 }
+
+TEST(Msg, VectorStream) {
+  Msg msg;
+  std::vector<uint16_t> regs{0x1234, 0x5678, 0x9abc};
+  msg << uint8_t(0xf0) << regs;
+  EXPECT_EQ(msg, 0xf0123456789abc_M);
+  std::vector<uint16_t> out(2);
+  msg >> out;
+  EXPECT_EQ(out, std::vector<uint16_t>({0x5678, 0x9abc}));
+  EXPECT_EQ(msg, 0xf01234_M);
+  out.resize(3);
+  EXPECT_THROW(msg >> out, std::underflow_error);
+  std::vector<uint16_t> big(Msg::kMaxModbusLength / 2);
+  EXPECT_THROW(msg << big, std::overflow_error);
+}
+
+TEST(Crc16, KnownValue) {
+  // Read holding registers request from the Modbus spec,
+  // CRC is transmitted as C5 CD.
+  std::array<uint8_t, 6> req{0x01, 0x03, 0x00, 0x00, 0x00, 0x0a};
+  EXPECT_EQ(crc16(req.data(), req.size()), 0xCDC5);
+  EXPECT_EQ(crc16Bytewise(req.data(), req.size()), 0xCDC5);
+  EXPECT_EQ(crc16(nullptr, 0), 0xFFFF);
+}
+
+TEST(Crc16, SliceMatchesBytewise) {
+  std::array<uint8_t, 256> data;
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i * 37 + 11;
+  }
+  for (size_t len = 0; len <= data.size(); len++) {
+    EXPECT_EQ(crc16(data.data(), len), crc16Bytewise(data.data(), len));
+  }
+}
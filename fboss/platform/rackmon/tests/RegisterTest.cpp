@@ -86,21 +86,72 @@ TEST(RegisterStoreTest, BasicOperation) {
       RegisterValueType::STRING,
       0};
   RegisterStore reg(desc);
-  for (uint16_t i = 0; i < 5; i++) {
-    EXPECT_EQ(reg.front(), false);
-    reg.front().value = {0x0001, i};
-    reg.front().timestamp = i + 1;
-    ++reg;
-  }
-  for (uint16_t i = 0; i < 5; i++) {
-    EXPECT_EQ(reg.front(), true);
-    EXPECT_EQ(reg.front().value, std::vector<uint16_t>({0x0001, i}));
-    EXPECT_EQ(reg.front().timestamp, i + 1);
-    ++reg;
+  EXPECT_EQ(reg.back(), false);
+  for (uint16_t i = 0; i < 10; i++) {
+    std::vector<uint16_t> words{0x0001, i};
+    reg.store(words.data(), i + 1);
+    EXPECT_EQ(reg.size(), std::min<size_t>(i + 1, 5));
     EXPECT_EQ(reg.back(), true);
-    EXPECT_EQ(reg.back().value, std::vector<uint16_t>({0x0001, i}));
+    EXPECT_EQ(reg.back().value, words);
     EXPECT_EQ(reg.back().timestamp, i + 1);
   }
+  // Readings are in slot order, the oldest slot was overwritten first.
+  std::vector<uint32_t> timestamps;
+  reg.forEachReading([&](uint32_t ts, const std::vector<uint16_t>& words) {
+    EXPECT_EQ(words, std::vector<uint16_t>({0x0001, uint16_t(ts - 1)}));
+    timestamps.push_back(ts);
+  });
+  EXPECT_EQ(timestamps, std::vector<uint32_t>({6, 7, 8, 9, 10}));
+}
+
+TEST(RegisterStoreTest, FarTimestamps) {
+  RegisterDescriptor desc{
+      0,
+      1,
+      "HELLO",
+      3,
+      false,
+      RegisterEndian::BIG,
+      RegisterValueType::INTEGER,
+      0};
+  RegisterStore reg(desc);
+  // Deltas that do not fit in 16 bits, and a clock going backwards.
+  std::vector<uint32_t> in{100, 200000, 150000, 150001, 1700000000};
+  for (uint16_t i = 0; i < in.size(); i++) {
+    reg.store(&i, in[i]);
+    EXPECT_EQ(reg.back().timestamp, in[i]);
+  }
+  std::vector<uint32_t> timestamps;
+  reg.forEachReading([&](uint32_t ts, const std::vector<uint16_t>& words) {
+    EXPECT_EQ(in[words[0]], ts);
+    timestamps.push_back(ts);
+  });
+  EXPECT_EQ(timestamps, std::vector<uint32_t>({150001, 1700000000, 150000}));
+}
+
+TEST(RegisterStoreTest, ChangesOnly) {
+  RegisterDescriptor desc{
+      0,
+      1,
+      "HELLO",
+      3,
+      true,
+      RegisterEndian::BIG,
+      RegisterValueType::INTEGER,
+      0};
+  RegisterStore reg(desc);
+  std::vector<uint16_t> values{1, 1, 2, 2, 2, 1};
+  for (uint16_t i = 0; i < values.size(); i++) {
+    reg.store(&values[i], i + 1);
+  }
+  // Only the changes are kept, with the time they were first seen.
+  std::vector<std::pair<uint32_t, uint16_t>> readings;
+  reg.forEachReading([&](uint32_t ts, const std::vector<uint16_t>& words) {
+    readings.emplace_back(ts, words[0]);
+  });
+  EXPECT_EQ(
+      readings,
+      (std::vector<std::pair<uint32_t, uint16_t>>{{1, 1}, {3, 2}, {6, 1}}));
 }
 
 TEST(RegisterStoreTest, DataRetrievalConversions) {
@@ -120,9 +171,8 @@ TEST(RegisterStoreTest, DataRetrievalConversions) {
   EXPECT_EQ(val.name, "HELLO");
   EXPECT_EQ(val.history.size(), 0);
 
-  reg.front().value = std::vector<uint16_t>({0x3031, 0x3233}); // "0123"
-  reg.front().timestamp = 0x1234;
-  ++reg;
+  std::vector<uint16_t> words{0x3031, 0x3233}; // "0123"
+  reg.store(words.data(), 0x1234);
   val = reg;
   EXPECT_EQ(val.regAddr, 0);
   EXPECT_EQ(val.name, "HELLO");
@@ -130,9 +180,8 @@ TEST(RegisterStoreTest, DataRetrievalConversions) {
   EXPECT_EQ(val.history[0].type, RegisterValueType::STRING);
   EXPECT_EQ(val.history[0].value.strValue, "0123");
 
-  reg.front().value = std::vector<uint16_t>({0x3132, 0x3334}); // "1234"
-  reg.front().timestamp = 0x1234;
-  ++reg;
+  words = {0x3132, 0x3334}; // "1234"
+  reg.store(words.data(), 0x1234);
   val = reg;
   EXPECT_EQ(val.regAddr, 0);
   EXPECT_EQ(val.name, "HELLO");
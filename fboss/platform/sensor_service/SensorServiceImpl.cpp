@@ -45,6 +45,7 @@ void SensorServiceImpl::init() {
   // Clear everything before init
   sensorNameMap_.clear();
   sensorTable_.sensorMapList()->clear();
+  sysfsSampler_ = SysfsSensorSampler();
 
   // folly::dynamic sensorConf;
 
@@ -69,14 +70,20 @@ void SensorServiceImpl::init() {
     for (auto& sensorIter : sensor.second) {
       // Check if file exists, if not, check if the path is regex pattern
       std::string path = *sensorIter.second.path();
-      if (std::filesystem::exists(std::filesystem::path(path))) {
-        sensorNameMap_[path] = sensorIter.first;
-      } else {
-        std::string realPath = findFileFromRegex(path);
-        if (!realPath.empty()) {
-          sensorNameMap_[realPath] = sensorIter.first;
+      if (!std::filesystem::exists(std::filesystem::path(path))) {
+        path = findFileFromRegex(path);
+        if (path.empty()) {
+          continue;
         }
       }
+      sensorNameMap_[path] = sensorIter.first;
+      if (sensorSource_ == SensorSource::SYSFS) {
+        sysfsSampler_.addSensor(
+            sensorIter.first,
+            path,
+            std::chrono::seconds(
+                sensorIter.second.sampleIntervalSecs().value_or(0)));
+      }
     }
   }
 
@@ -180,21 +187,22 @@ void SensorServiceImpl::fetchSensorData() {
 }
 
 void SensorServiceImpl::getSensorDataFromPath() {
-  auto dataTable = liveDataTable_.wlock();
-
   auto now = helpers::nowInSecs();
-  for (const auto& [path, name] : sensorNameMap_) {
-    std::string sensorInput;
-
-    if (folly::readFile(path.c_str(), sensorInput)) {
-      (*dataTable)[name].value = folly::to<float>(sensorInput);
-      (*dataTable)[name].timeStamp = now;
-      XLOG(INFO) << name << "(" << path << ")"
-                 << " : " << (*dataTable)[name].value;
-    } else {
-      XLOG(INFO) << "Can not read data for " << name << " from " << path;
-    }
+  // Read the sensors without holding the table lock, so that thrift readers
+  // only wait for the swap below. This is the only writer of liveDataTable_
+  // for a SYSFS source, so updating a copy loses nothing.
+  auto samples = sysfsSampler_.sample(now);
+  if (samples.empty()) {
+    return;
+  }
+  auto dataTable = liveDataTable_.copy();
+  for (const auto& [name, value] : samples) {
+    auto& liveData = dataTable[name];
+    liveData.value = value;
+    liveData.timeStamp = now;
+    XLOG(DBG4) << name << " : " << value;
   }
+  liveDataTable_.swap(dataTable);
 }
 
 void SensorServiceImpl::parseSensorJsonData(const std::string& strJson) {
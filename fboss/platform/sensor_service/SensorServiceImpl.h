@@ -13,6 +13,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "fboss/platform/sensor_service/SysfsSensorSampler.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_config_types.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
 #include "folly/Synchronized.h"
@@ -68,6 +69,9 @@ class SensorServiceImpl {
   // Sensor Name map, sensor path -> sensor name
   std::unordered_map<std::string, std::string> sensorNameMap_;
 
+  // Open sensor files of a SYSFS source, only used by the fetch thread
+  SysfsSensorSampler sysfsSampler_;
+
   // Live sensor data table, sensor name -> sensor live data
   folly::Synchronized<std::unordered_map<std::string, struct SensorLiveData>>
       liveDataTable_;
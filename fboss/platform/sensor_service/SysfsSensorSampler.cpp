@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/platform/sensor_service/SysfsSensorSampler.h"
+
+#include <fcntl.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+#include <array>
+
+namespace facebook::fboss::platform::sensor_service {
+
+void SysfsSensorSampler::addSensor(
+    const std::string& name,
+    const std::string& path,
+    std::chrono::seconds interval) {
+  SensorFile sensor;
+  sensor.name = name;
+  sensor.path = path;
+  sensor.intervalSecs = interval.count();
+  sensors_.push_back(std::move(sensor));
+}
+
+bool SysfsSensorSampler::readSensor(SensorFile& sensor, float& value) {
+  if (!sensor.file) {
+    int fd = folly::openNoInt(sensor.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    sensor.file = folly::File(fd, true /* ownsFd */);
+  }
+  // sysfs attributes are a single value, well within a page
+  std::array<char, 128> buf;
+  auto bytesRead =
+      folly::preadNoInt(sensor.file.fd(), buf.data(), buf.size(), 0);
+  if (bytesRead <= 0) {
+    sensor.file.close();
+    return false;
+  }
+  auto parsed = folly::tryTo<float>(
+      folly::trimWhitespace(folly::StringPiece(buf.data(), bytesRead)));
+  if (!parsed.hasValue()) {
+    return false;
+  }
+  value = *parsed;
+  return true;
+}
+
+std::vector<std::pair<std::string, float>> SysfsSensorSampler::sample(
+    int64_t now) {
+  std::vector<std::pair<std::string, float>> samples;
+  samples.reserve(sensors_.size());
+  for (auto& sensor : sensors_) {
+    if (now < sensor.nextSampleTime) {
+      continue;
+    }
+    sensor.nextSampleTime = now + sensor.intervalSecs;
+    float value;
+    if (readSensor(sensor, value)) {
+      samples.emplace_back(sensor.name, value);
+    } else {
+      XLOG(INFO) << "Can not read data for " << sensor.name << " from "
+                 << sensor.path;
+    }
+  }
+  return samples;
+}
+
+} // namespace facebook::fboss::platform::sensor_service
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/File.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::platform::sensor_service {
+
+/*
+ * Samples sysfs/hwmon sensor files.
+ *
+ * Each sensor file is opened once and then re-read from offset 0 with pread,
+ * which makes sysfs regenerate the attribute, instead of an open/read/close
+ * per sensor on every pass. A file that fails to open or read is closed and
+ * reopened on its next sample, so sensors that come and go (e.g. hot
+ * pluggable FRUs) are picked up again.
+ *
+ * Every sensor has its own sampling interval; a pass only reads the sensors
+ * that are due. An interval of zero samples the sensor on every pass.
+ *
+ * Not thread safe, meant to be driven by a single fetch thread.
+ */
+class SysfsSensorSampler {
+ public:
+  void addSensor(
+      const std::string& name,
+      const std::string& path,
+      std::chrono::seconds interval = std::chrono::seconds(0));
+
+  // Reads the sensors due at the given time (in seconds), returns the
+  // name and value of the ones read successfully.
+  std::vector<std::pair<std::string, float>> sample(int64_t now);
+
+  size_t size() const {
+    return sensors_.size();
+  }
+
+ private:
+  struct SensorFile {
+    std::string name;
+    std::string path;
+    int64_t intervalSecs{0};
+    int64_t nextSampleTime{0};
+    folly::File file;
+  };
+
+  static bool readSensor(SensorFile& sensor, float& value);
+
+  std::vector<SensorFile> sensors_;
+};
+
+} // namespace facebook::fboss::platform::sensor_service
@@ -42,6 +42,9 @@ struct Sensor {
   3: optional string compute;
   /* Sensor type , e.g. V, A, RPM, etc. */
   4: SensorType type;
+  /* For sysfs sources, minimum interval between two samples of this sensor,
+     in seconds. Unset samples the sensor on every fetch. */
+  5: optional i32 sampleIntervalSecs;
 }
 
 /* Sensor Name -> its config mapping, the name is in this format: "SUB_FRU_1:SUB_FRU_2:...:SUB_FRU_N:SENSOR_NAME" */
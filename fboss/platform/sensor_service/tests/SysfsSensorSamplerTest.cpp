@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/platform/sensor_service/SysfsSensorSampler.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss::platform::sensor_service;
+
+namespace {
+
+using Samples = std::vector<std::pair<std::string, float>>;
+
+class SysfsSensorSamplerTest : public ::testing::Test {
+ protected:
+  std::string writeSensor(const std::string& file, const std::string& value) {
+    auto path = tmpDir_.path().string() + "/" + file;
+    folly::writeFile(value, path.c_str());
+    return path;
+  }
+
+  folly::test::TemporaryDirectory tmpDir_;
+  SysfsSensorSampler sampler_;
+};
+
+} // namespace
+
+TEST_F(SysfsSensorSamplerTest, sampleAll) {
+  sampler_.addSensor("TEMP1", writeSensor("temp1_input", "42000\n"));
+  sampler_.addSensor("FAN1", writeSensor("fan1_input", "7200\n"));
+  EXPECT_EQ(
+      sampler_.sample(100), Samples({{"TEMP1", 42000}, {"FAN1", 7200}}));
+
+  // Files stay open, new values are read through the same fd
+  writeSensor("temp1_input", "43500\n");
+  EXPECT_EQ(
+      sampler_.sample(105), Samples({{"TEMP1", 43500}, {"FAN1", 7200}}));
+}
+
+TEST_F(SysfsSensorSamplerTest, sampleInterval) {
+  sampler_.addSensor(
+      "TEMP1", writeSensor("temp1_input", "42000"), std::chrono::seconds(10));
+  sampler_.addSensor("FAN1", writeSensor("fan1_input", "7200"));
+  EXPECT_EQ(
+      sampler_.sample(100), Samples({{"TEMP1", 42000}, {"FAN1", 7200}}));
+  EXPECT_EQ(sampler_.sample(105), Samples({{"FAN1", 7200}}));
+  EXPECT_EQ(
+      sampler_.sample(110), Samples({{"TEMP1", 42000}, {"FAN1", 7200}}));
+}
+
+TEST_F(SysfsSensorSamplerTest, sensorAppears) {
+  auto path = tmpDir_.path().string() + "/in0_input";
+  sampler_.addSensor("VIN", path);
+  EXPECT_TRUE(sampler_.sample(100).empty());
+  writeSensor("in0_input", "12100");
+  EXPECT_EQ(sampler_.sample(105), Samples({{"VIN", 12100}}));
+}
+
+TEST_F(SysfsSensorSamplerTest, badValue) {
+  sampler_.addSensor("TEMP1", writeSensor("temp1_input", "n/a"));
+  sampler_.addSensor("FAN1", writeSensor("fan1_input", "7200"));
+  EXPECT_EQ(sampler_.sample(100), Samples({{"FAN1", 7200}}));
+}
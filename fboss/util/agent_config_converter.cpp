@@ -0,0 +1,39 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+#include "fboss/agent/AgentConfig.h"
+
+#include <folly/FileUtil.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <iostream>
+
+using namespace facebook::fboss;
+
+DECLARE_string(config);
+DEFINE_string(
+    output,
+    "",
+    "Where to write the binary config, <config>.bin if empty. The agent "
+    "loads it in place of --config when run with --prefer_binary_config");
+
+/*
+ * Converts the JSON agent config to the compact serialized form the agent
+ * can mmap at startup instead of parsing JSON.
+ */
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+
+  auto output = FLAGS_output.empty() ? FLAGS_config + ".bin" : FLAGS_output;
+  auto config = AgentConfig::fromFile(FLAGS_config);
+  auto binary = config->binaryConfigRaw();
+
+  // Make sure the agent reads back exactly what was converted
+  auto readBack = AgentConfig::fromBinaryConfig(folly::StringPiece(binary));
+  CHECK(readBack->thrift == config->thrift);
+
+  folly::writeFileAtomic(output, binary);
+  std::cout << "Wrote " << binary.size() << " bytes to " << output
+            << std::endl;
+  return 0;
+}